@@ -0,0 +1,186 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisLazyBrushBenchmark.h"
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_global.h>
+#include <kis_paint_device.h>
+#include <kis_painter.h>
+#include <krita_utils.h>
+#include <lazybrush/KisWatershedWorker.h>
+
+namespace {
+
+const int numPanelColumns = 3;
+const int numPanelRows = 4;
+const int panelMargin = 40;
+const int lineWidth = 6;
+
+QRect panelRect(const QRect &bounds, int column, int row)
+{
+    const int panelWidth = (bounds.width() - panelMargin) / numPanelColumns;
+    const int panelHeight = (bounds.height() - panelMargin) / numPanelRows;
+
+    return QRect(bounds.left() + panelMargin + column * panelWidth,
+                 bounds.top() + panelMargin + row * panelHeight,
+                 panelWidth - panelMargin, panelHeight - panelMargin);
+}
+
+void drawFrame(KisPaintDeviceSP dev, const QRect &rc, const KoColor &color)
+{
+    dev->fill(QRect(rc.left(), rc.top(), rc.width(), lineWidth), color);
+    dev->fill(QRect(rc.left(), rc.bottom() - lineWidth + 1, rc.width(), lineWidth), color);
+    dev->fill(QRect(rc.left(), rc.top(), lineWidth, rc.height()), color);
+    dev->fill(QRect(rc.right() - lineWidth + 1, rc.top(), lineWidth, rc.height()), color);
+}
+
+KisPaintDeviceSP createKeyStroke(const QVector<QRect> &dabs)
+{
+    const KoColorSpace *alphaCS = KoColorSpaceRegistry::instance()->alpha8();
+
+    KisPaintDeviceSP dev = new KisPaintDevice(alphaCS);
+    Q_FOREACH (const QRect &dab, dabs) {
+        dev->fill(dab, KoColor(Qt::black, alphaCS));
+    }
+
+    return dev;
+}
+
+void runWorker(KisPaintDeviceSP heightMap, KisPaintDeviceSP dst,
+               const QVector<KisLazyFillTools::KeyStroke> &keyStrokes,
+               const QRect &rect)
+{
+    KisWatershedWorker worker(heightMap, dst, rect);
+    Q_FOREACH (const KisLazyFillTools::KeyStroke &stroke, keyStrokes) {
+        worker.addKeyStroke(stroke.dev, stroke.color);
+    }
+    worker.run();
+}
+
+}
+
+void KisLazyBrushBenchmark::initTestCase()
+{
+    m_bounds = QRect(0, 0, 2480, 3508);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColor black(Qt::black, cs);
+
+    KisPaintDeviceSP page = new KisPaintDevice(cs);
+    page->fill(m_bounds, KoColor(Qt::white, cs));
+
+    QRandomGenerator random(1);
+
+    QVector<QRect> backgroundDabs;
+    QVector<QRect> characterDabs;
+
+    for (int row = 0; row < numPanelRows; row++) {
+        for (int column = 0; column < numPanelColumns; column++) {
+            const QRect panel = panelRect(m_bounds, column, row);
+            drawFrame(page, panel, black);
+
+            // a closed "character" shape and a few open strokes in every panel
+            const QRect character(panel.left() + panel.width() / 4,
+                                  panel.top() + panel.height() / 4,
+                                  panel.width() / 3, panel.height() / 2);
+            drawFrame(page, character, black);
+
+            for (int i = 0; i < 5; i++) {
+                const QPoint pt(panel.left() + lineWidth + random.bounded(panel.width() - 200),
+                                panel.top() + lineWidth + random.bounded(panel.height() - 200));
+                page->fill(QRect(pt, QSize(100 + random.bounded(100), lineWidth / 2)), black);
+            }
+
+            backgroundDabs << QRect(panel.topLeft() + QPoint(20, 20), QSize(10, 10));
+            characterDabs << QRect(character.center(), QSize(10, 10));
+        }
+    }
+
+    // prepare the height map the same way KisColorizeStrokeStrategy does
+    m_heightMap = KisPainter::convertToAlphaAsAlpha(page);
+    KisLazyFillTools::normalizeAndInvertAlpha8Device(m_heightMap, m_bounds);
+    KritaUtils::filterAlpha8Device(m_heightMap, m_bounds,
+                                   [](quint8 pixel) {
+                                       return quint8(255 - pixel);
+                                   });
+
+    m_keyStrokes << KisLazyFillTools::KeyStroke(createKeyStroke(backgroundDabs), KoColor(Qt::yellow, cs));
+    m_keyStrokes << KisLazyFillTools::KeyStroke(createKeyStroke(characterDabs), KoColor(Qt::red, cs));
+
+    qDebug() << "Page" << m_bounds.size() << "with" << numPanelColumns * numPanelRows << "panels";
+}
+
+void KisLazyBrushBenchmark::benchmarkFullRecalculation()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    QBENCHMARK_ONCE {
+        KisPaintDeviceSP coloring = new KisPaintDevice(cs);
+
+        QElapsedTimer timer;
+        timer.start();
+
+        runWorker(m_heightMap, coloring, m_keyStrokes, m_bounds);
+
+        qDebug() << "Full recalculation, ms:" << timer.elapsed();
+    }
+}
+
+void KisLazyBrushBenchmark::benchmarkIncrementalUpdate()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisPaintDeviceSP coloring = new KisPaintDevice(cs);
+    runWorker(m_heightMap, coloring, m_keyStrokes, m_bounds);
+
+    // the user puts one more dab of the "character" color into the last panel
+    QVector<KisLazyFillTools::KeyStroke> newKeyStrokes;
+    Q_FOREACH (const KisLazyFillTools::KeyStroke &stroke, m_keyStrokes) {
+        newKeyStrokes << KisLazyFillTools::KeyStroke(new KisPaintDevice(*stroke.dev), stroke.color);
+    }
+
+    const QRect lastPanel = panelRect(m_bounds, numPanelColumns - 1, numPanelRows - 1);
+    newKeyStrokes[1].dev->fill(QRect(lastPanel.bottomRight() - QPoint(40, 40), QSize(10, 10)),
+                               KoColor(Qt::black, KoColorSpaceRegistry::instance()->alpha8()));
+
+    QRect affectedRect;
+
+    QBENCHMARK_ONCE {
+        QElapsedTimer timer;
+        timer.start();
+
+        KisPaintDeviceSP changedPixels = new KisPaintDevice(KoColorSpaceRegistry::instance()->alpha8());
+        for (int i = 0; i < newKeyStrokes.size(); i++) {
+            KisLazyFillTools::markChangedKeyStrokePixels(m_keyStrokes[i].dev, newKeyStrokes[i].dev, changedPixels);
+        }
+
+        affectedRect = KisLazyFillTools::calculateAffectedColoringRect(coloring, changedPixels, m_bounds);
+        const QRect workerRect = kisGrowRect(affectedRect, 1) & m_bounds;
+
+        const qint64 preparationTime = timer.nsecsElapsed();
+
+        const QVector<KisLazyFillTools::KeyStroke> preparedKeyStrokes =
+            KisLazyFillTools::prepareKeyStrokesForRect(newKeyStrokes, coloring, affectedRect, workerRect);
+        coloring->clear(affectedRect);
+
+        runWorker(m_heightMap, coloring, preparedKeyStrokes, workerRect);
+
+        qDebug() << "Incremental update, ms: search" << preparationTime * 1e-6
+                 << "total" << timer.nsecsElapsed() * 1e-6;
+    }
+
+    qDebug() << "Affected rect" << affectedRect
+             << "portion of the page:"
+             << qreal(affectedRect.width() * affectedRect.height()) / (m_bounds.width() * m_bounds.height());
+}
+
+SIMPLE_TEST_MAIN(KisLazyBrushBenchmark)
@@ -0,0 +1,38 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISLAZYBRUSHBENCHMARK_H
+#define KISLAZYBRUSHBENCHMARK_H
+
+#include <simpletest.h>
+
+#include <kis_types.h>
+#include <lazybrush/kis_lazy_fill_tools.h>
+
+/**
+ * Measures the watershed flood of the colorize mask on a synthetic
+ * comic page: a grid of panels with some line art inside and a
+ * couple of key strokes in every panel. Compares the full
+ * recalculation of the page with the incremental update that
+ * follows a small edit of a single key stroke.
+ */
+class KisLazyBrushBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void benchmarkFullRecalculation();
+    void benchmarkIncrementalUpdate();
+
+private:
+    QRect m_bounds;
+    KisPaintDeviceSP m_heightMap;
+    QVector<KisLazyFillTools::KeyStroke> m_keyStrokes;
+};
+
+#endif // KISLAZYBRUSHBENCHMARK_H
@@ -0,0 +1,233 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisStrokeReplayBenchmark.h"
+
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QtMath>
+
+#include "kis_benchmark_values.h"
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_image.h>
+#include <kis_paint_layer.h>
+#include <kis_painter.h>
+#include <kis_distance_information.h>
+#include <brushengine/kis_paintop_preset.h>
+
+#include <KisGlobalResourcesInterface.h>
+
+
+namespace {
+
+KisPaintInformationRecording createSyntheticRecording(const QSize &canvasSize)
+{
+    KisPaintInformationRecording recording;
+    recording.setCanvasSize(canvasSize);
+
+    const int numStrokes = 8;
+    const int numSamples = 400;
+
+    // the tablet reports the events at about 200Hz
+    const qreal timeStep = 5.0;
+
+    for (int i = 0; i < numStrokes; i++) {
+        KisPaintInformationRecording::Stroke stroke;
+
+        const qreal baseY = (i + 0.5) * canvasSize.height() / numStrokes;
+        const qreal amplitude = 0.3 * canvasSize.height() / numStrokes;
+
+        for (int j = 0; j < numSamples; j++) {
+            const qreal t = qreal(j) / (numSamples - 1);
+            const qreal x = 0.05 * canvasSize.width() + t * 0.9 * canvasSize.width();
+            const qreal y = baseY + amplitude * qSin(t * 6.0 * M_PI + i);
+
+            const qreal pressure = qBound(0.0, qSin(t * M_PI) * (0.8 + 0.2 * qSin(t * 20.0)), 1.0);
+            const qreal xTilt = 30.0 * qCos(t * 4.0 * M_PI);
+            const qreal yTilt = 20.0 * qSin(t * 2.0 * M_PI);
+
+            stroke.append(KisPaintInformation(QPointF(x, y), pressure, xTilt, yTilt,
+                                              0.0, 0.0, 1.0, j * timeStep, 0.0));
+        }
+
+        recording.addStroke(stroke);
+    }
+
+    /**
+     * Pass the synthetic strokes through the serialization to
+     * get exactly the same precision as the real recordings have
+     */
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    recording.write(&buffer);
+    buffer.seek(0);
+
+    KisPaintInformationRecording result;
+    const bool readOk = result.read(&buffer);
+    KIS_ASSERT(readOk);
+
+    return result;
+}
+
+qreal percentile(const QVector<qreal> &sortedValues, qreal portion)
+{
+    if (sortedValues.isEmpty()) return 0.0;
+
+    const int index = qBound(0, qCeil(portion * sortedValues.size()) - 1, sortedValues.size() - 1);
+    return sortedValues[index];
+}
+
+}
+
+void KisStrokeReplayBenchmark::initTestCase()
+{
+    const QString recordingFileName = qEnvironmentVariable("KRITA_REPLAY_RECORDING");
+
+    if (!recordingFileName.isEmpty()) {
+        QVERIFY(m_recording.load(recordingFileName));
+        QVERIFY(!m_recording.isEmpty());
+    }
+
+    m_canvasSize = m_recording.canvasSize();
+
+    const QStringList sizeParts = qEnvironmentVariable("KRITA_REPLAY_CANVAS_SIZE").split('x');
+    if (sizeParts.size() == 2) {
+        m_canvasSize = QSize(sizeParts[0].toInt(), sizeParts[1].toInt());
+    }
+
+    if (m_canvasSize.isEmpty()) {
+        m_canvasSize = QSize(TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+    }
+
+    if (m_recording.isEmpty()) {
+        m_recording = createSyntheticRecording(m_canvasSize);
+    }
+
+    qDebug() << "Replaying" << m_recording.strokes().size() << "strokes,"
+             << m_recording.numSamples() << "samples on canvas" << m_canvasSize;
+}
+
+void KisStrokeReplayBenchmark::replayPreset(const QString &presetFileName)
+{
+    KisPaintOpPresetSP preset(new KisPaintOpPreset(presetFileName));
+    QVERIFY(preset->load(KisGlobalResourcesInterface::instance()));
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisImageSP image = new KisImage(0, m_canvasSize.width(), m_canvasSize.height(), cs, "stroke replay image");
+    KisPaintLayerSP layer = new KisPaintLayer(image, "replay layer", OPACITY_OPAQUE_U8, cs);
+    image->addNode(layer, image->root());
+    image->initialRefreshGraph();
+
+    qint64 presetSetupTime = 0;
+    qint64 paintingTime = 0;
+    qint64 projectionTime = 0;
+
+    int numDabs = 0;
+    QVector<qreal> dabLatencies;
+
+    QBENCHMARK_ONCE {
+        QElapsedTimer timer;
+
+        Q_FOREACH (const KisPaintInformationRecording::Stroke &stroke, m_recording.strokes()) {
+            timer.start();
+
+            KisPainter painter(layer->paintDevice());
+            painter.setPaintColor(KoColor(Qt::black, cs));
+            painter.setPaintOpPreset(preset, layer, image);
+
+            presetSetupTime += timer.nsecsElapsed();
+
+            KisDistanceInformation currentDistance;
+
+            if (stroke.size() == 1) {
+                timer.start();
+                painter.paintAt(stroke.first(), &currentDistance);
+                paintingTime += timer.nsecsElapsed();
+            }
+
+            for (int i = 1; i < stroke.size(); i++) {
+                const int dabsBefore = currentDistance.currentDabSeqNo();
+
+                timer.start();
+                painter.paintLine(stroke[i - 1], stroke[i], &currentDistance);
+                const qint64 segmentTime = timer.nsecsElapsed();
+
+                paintingTime += segmentTime;
+
+                /**
+                 * The painter doesn't report the time of individual
+                 * dabs, so distribute the time of the segment evenly
+                 * among the dabs painted in it
+                 */
+                const int segmentDabs = currentDistance.currentDabSeqNo() - dabsBefore;
+                for (int j = 0; j < segmentDabs; j++) {
+                    dabLatencies.append(qreal(segmentTime) / segmentDabs);
+                }
+            }
+
+            numDabs += currentDistance.currentDabSeqNo();
+
+            timer.start();
+
+            const QVector<QRect> dirtyRects = painter.takeDirtyRegion();
+            layer->setDirty(dirtyRects);
+            image->waitForDone();
+
+            projectionTime += timer.nsecsElapsed();
+        }
+    }
+
+    std::sort(dabLatencies.begin(), dabLatencies.end());
+
+    const qreal totalTime = presetSetupTime + paintingTime + projectionTime;
+    const qreal nsToMs = 1e-6;
+    const qreal nsToUs = 1e-3;
+
+    qDebug() << "Preset:" << QFileInfo(presetFileName).fileName();
+    qDebug() << "    dabs:" << numDabs
+             << "dabs/s:" << (paintingTime > 0 ? numDabs / (paintingTime * 1e-9) : 0.0);
+    qDebug() << "    per-dab latency, us: p50" << percentile(dabLatencies, 0.50) * nsToUs
+             << "p90" << percentile(dabLatencies, 0.90) * nsToUs
+             << "p99" << percentile(dabLatencies, 0.99) * nsToUs
+             << "max" << percentile(dabLatencies, 1.0) * nsToUs;
+    qDebug() << "    stages, ms: preset setup" << presetSetupTime * nsToMs
+             << "painting" << paintingTime * nsToMs
+             << "projection" << projectionTime * nsToMs
+             << "total" << totalTime * nsToMs;
+}
+
+void KisStrokeReplayBenchmark::replaySoftBrush()
+{
+    replayPreset(QString(FILES_DATA_DIR) + '/' + "softbrush-300px.kpp");
+}
+
+void KisStrokeReplayBenchmark::replayAutoBrush()
+{
+    replayPreset(QString(FILES_DATA_DIR) + '/' + "autobrush_300px.kpp");
+}
+
+void KisStrokeReplayBenchmark::replayColorSmudge()
+{
+    replayPreset(QString(FILES_DATA_DIR) + '/' + "colorsmudge.kpp");
+}
+
+void KisStrokeReplayBenchmark::replayCustomPreset()
+{
+    const QString presetFileName = qEnvironmentVariable("KRITA_REPLAY_PRESET");
+
+    if (presetFileName.isEmpty()) {
+        QSKIP("KRITA_REPLAY_PRESET is not set");
+    }
+
+    replayPreset(presetFileName);
+}
+
+SIMPLE_TEST_MAIN(KisStrokeReplayBenchmark)
@@ -0,0 +1,49 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSTROKEREPLAYBENCHMARK_H
+#define KISSTROKEREPLAYBENCHMARK_H
+
+#include <simpletest.h>
+
+#include <brushengine/KisPaintInformationRecording.h>
+
+/**
+ * Replays the recorded tablet input (see KisPaintInformationRecording)
+ * against a paintop preset and reports the number of dabs per second,
+ * the percentiles of the per-dab latency and the time spent in every
+ * stage of the stroke.
+ *
+ * The input is controlled by the environment variables:
+ *
+ * KRITA_REPLAY_RECORDING   --- a recording saved by the freehand tool
+ *                              with KRITA_RECORD_STROKES_DIR set. When
+ *                              unset, a synthetic stroke is used.
+ * KRITA_REPLAY_PRESET      --- a preset used by replayCustomPreset()
+ * KRITA_REPLAY_CANVAS_SIZE --- the size of the canvas in "WxH" form,
+ *                              overrides the size stored in the recording
+ */
+class KisStrokeReplayBenchmark : public QObject
+{
+    Q_OBJECT
+
+private:
+    void replayPreset(const QString &presetFileName);
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void replaySoftBrush();
+    void replayAutoBrush();
+    void replayColorSmudge();
+    void replayCustomPreset();
+
+private:
+    KisPaintInformationRecording m_recording;
+    QSize m_canvasSize;
+};
+
+#endif // KISSTROKEREPLAYBENCHMARK_H
@@ -25,6 +25,9 @@
 #include "kis_selection.h"
 #include <kis_iterator_ng.h>
 #include <KisGlobalResourcesInterface.h>
+#include <kis_convolution_kernel.h>
+#include <kis_convolution_painter.h>
+#include <kis_gaussian_kernel.h>
 
 void KisBlurBenchmark::initTestCase()
 {
@@ -77,5 +80,106 @@ void KisBlurBenchmark::benchmarkFilter()
 }
 
 
+void KisBlurBenchmark::benchmarkFilterBigRadius_data()
+{
+    QTest::addColumn<int>("radius");
+    QTest::addColumn<bool>("use16Bit");
+
+    QTest::newRow("r25-8bit") << 25 << false;
+    QTest::newRow("r50-8bit") << 50 << false;
+    QTest::newRow("r100-8bit") << 100 << false;
+    QTest::newRow("r200-8bit") << 200 << false;
+    QTest::newRow("r100-16bit") << 100 << true;
+}
+
+void KisBlurBenchmark::benchmarkFilterBigRadius()
+{
+    QFETCH(int, radius);
+    QFETCH(bool, use16Bit);
+
+    /**
+     * The blur filter uses a non-separable kernel, so big radii
+     * are always processed by the FFT convolution worker
+     */
+    KisFilterSP filter = KisFilterRegistry::instance()->value("blur");
+    KisFilterConfigurationSP kfc = filter->defaultConfiguration(KisGlobalResourcesInterface::instance());
+    kfc->setProperty("halfWidth", radius);
+    kfc->setProperty("halfHeight", radius);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(*m_device);
+    if (use16Bit) {
+        dev->convertTo(KoColorSpaceRegistry::instance()->rgb16());
+    }
+
+    QBENCHMARK{
+        filter->process(dev, QRect(0, 0, GMP_IMAGE_WIDTH,GMP_IMAGE_HEIGHT), kfc);
+    }
+}
+
+void KisBlurBenchmark::benchmarkFFTConvolutionBigImage_data()
+{
+    QTest::addColumn<int>("radius");
+
+    QTest::newRow("r50") << 50;
+    QTest::newRow("r300") << 300;
+}
+
+void KisBlurBenchmark::benchmarkFFTConvolutionBigImage()
+{
+    QFETCH(int, radius);
+
+    /**
+     * The image is big enough to be split into several FFT tiles
+     */
+    const QRect rc(0, 0, 3 * GMP_IMAGE_WIDTH, 3 * GMP_IMAGE_HEIGHT);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(m_colorSpace);
+    for (int y = 0; y < 3; y++) {
+        for (int x = 0; x < 3; x++) {
+            const QRect srcRect(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT);
+            KisPainter::copyAreaOptimized(QPoint(x * GMP_IMAGE_WIDTH, y * GMP_IMAGE_HEIGHT),
+                                          m_device, dev, srcRect);
+        }
+    }
+
+    KisConvolutionKernelSP kernel =
+        KisGaussianKernel::createUniform2DKernel(radius, radius);
+
+    QBENCHMARK{
+        KisConvolutionPainter painter(dev, KisConvolutionPainter::FFTW);
+        painter.applyMatrix(kernel, dev, rc.topLeft(), rc.topLeft(), rc.size(), BORDER_REPEAT);
+    }
+}
+
+void KisBlurBenchmark::benchmarkGaussianMethods_data()
+{
+    QTest::addColumn<int>("radius");
+    QTest::addColumn<int>("method");
+
+    const QVector<int> radii({50, 200, 500, 1000});
+
+    Q_FOREACH (int radius, radii) {
+        QTest::newRow(QString("r%1-exact").arg(radius).toLatin1())
+            << radius << int(KisGaussianKernel::Exact);
+        QTest::newRow(QString("r%1-box").arg(radius).toLatin1())
+            << radius << int(KisGaussianKernel::BoxCascade);
+    }
+}
+
+void KisBlurBenchmark::benchmarkGaussianMethods()
+{
+    QFETCH(int, radius);
+    QFETCH(int, method);
+
+    const QRect rc(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(*m_device);
+
+    QBENCHMARK{
+        KisGaussianKernel::applyGaussian(dev, rc, radius, radius,
+                                         QBitArray(), 0, false, BORDER_REPEAT,
+                                         KisGaussianKernel::Method(method));
+    }
+}
 
 SIMPLE_TEST_MAIN(KisBlurBenchmark)
@@ -27,7 +27,16 @@ private Q_SLOTS:
     void cleanupTestCase();
     
     void benchmarkFilter();
-    
+
+    void benchmarkFilterBigRadius_data();
+    void benchmarkFilterBigRadius();
+
+    void benchmarkFFTConvolutionBigImage_data();
+    void benchmarkFFTConvolutionBigImage();
+
+    void benchmarkGaussianMethods_data();
+    void benchmarkGaussianMethods();
+
 };
 
 #endif
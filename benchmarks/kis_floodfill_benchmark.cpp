@@ -21,6 +21,13 @@
 #include "kis_floodfill_benchmark.h"
 
 #include <kis_fill_painter.h>
+#include <kis_pixel_selection.h>
+#include <floodfill/kis_scanline_fill.h>
+
+/**
+ * The size of the canvas for the big area fill cases
+ */
+const QRect bigAreaRect(0, 0, 4096, 4096);
 
 void KisFloodFillBenchmark::initTestCase()
 {
@@ -70,6 +77,25 @@ void KisFloodFillBenchmark::initTestCase()
     m_existingSelection = new KisPaintDevice(alphacs);
     m_existingSelection->fill(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT, defaultSelected.data());
 
+    // a big enclosed area with a few islands and a wavy border
+    m_deviceBigArea = new KisPaintDevice(m_colorSpace);
+    m_color.fromQColor(Qt::white);
+    m_deviceBigArea->fill(bigAreaRect, m_color);
+
+    m_color.fromQColor(Qt::black);
+    KisPainter bigAreaPainter(m_deviceBigArea);
+    bigAreaPainter.setFillStyle(KisPainter::FillStyleForegroundColor);
+    bigAreaPainter.setPaintColor(m_color);
+
+    for (int i = 0; i < 200; i++) {
+        x = rand() % bigAreaRect.width();
+        y = rand() % bigAreaRect.height();
+        bigAreaPainter.paintEllipse(x, y, tilew, tileh);
+    }
+
+    for (int i = 0; i < bigAreaRect.width(); i += 32) {
+        bigAreaPainter.paintEllipse(i, bigAreaRect.height() - 64, 48, 48);
+    }
 }
 
 void KisFloodFillBenchmark::benchmarkFlood()
@@ -171,6 +197,62 @@ void KisFloodFillBenchmark::benchmarkFloodWithSelectionAsBoundary()
 }
 
 
+void KisFloodFillBenchmark::benchmarkScanlineFillSelectionSerial()
+{
+    QBENCHMARK
+    {
+        KisPixelSelectionSP selection = new KisPixelSelection();
+
+        KisScanlineFill fill(m_deviceBigArea, QPoint(1, 1), bigAreaRect);
+        fill.setThreshold(15);
+        fill.setParallelFillEnabled(false);
+        fill.fillSelection(selection);
+    }
+}
+
+void KisFloodFillBenchmark::benchmarkScanlineFillSelectionParallel()
+{
+    QBENCHMARK
+    {
+        KisPixelSelectionSP selection = new KisPixelSelection();
+
+        KisScanlineFill fill(m_deviceBigArea, QPoint(1, 1), bigAreaRect);
+        fill.setThreshold(15);
+        fill.fillSelection(selection);
+    }
+}
+
+void KisFloodFillBenchmark::benchmarkScanlineFillExternalSerial()
+{
+    KoColor fg(m_colorSpace);
+    fg.fromQColor(Qt::blue);
+
+    QBENCHMARK
+    {
+        KisPaintDeviceSP dst = new KisPaintDevice(m_colorSpace);
+
+        KisScanlineFill fill(m_deviceBigArea, QPoint(1, 1), bigAreaRect);
+        fill.setThreshold(15);
+        fill.setParallelFillEnabled(false);
+        fill.fill(fg, dst);
+    }
+}
+
+void KisFloodFillBenchmark::benchmarkScanlineFillExternalParallel()
+{
+    KoColor fg(m_colorSpace);
+    fg.fromQColor(Qt::blue);
+
+    QBENCHMARK
+    {
+        KisPaintDeviceSP dst = new KisPaintDevice(m_colorSpace);
+
+        KisScanlineFill fill(m_deviceBigArea, QPoint(1, 1), bigAreaRect);
+        fill.setThreshold(15);
+        fill.fill(fg, dst);
+    }
+}
+
 void KisFloodFillBenchmark::cleanupTestCase()
 {
 
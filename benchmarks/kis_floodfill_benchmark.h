@@ -25,6 +25,7 @@ private:
     KisPaintDeviceSP m_deviceWithSelectionAsBoundary;
     KisPaintDeviceSP m_deviceWithoutSelectionAsBoundary;
     KisPaintDeviceSP m_existingSelection;
+    KisPaintDeviceSP m_deviceBigArea;
     int m_startX;
     int m_startY;
     
@@ -36,6 +37,11 @@ private Q_SLOTS:
     void benchmarkFloodWithoutSelectionAsBoundary();
     void benchmarkFloodWithSelectionAsBoundary();
 
+    void benchmarkScanlineFillSelectionSerial();
+    void benchmarkScanlineFillSelectionParallel();
+    void benchmarkScanlineFillExternalSerial();
+    void benchmarkScanlineFillExternalParallel();
+
     
     
     
@@ -0,0 +1,112 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_opengl_update_info_benchmark.h"
+
+#include <QElapsedTimer>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorModelStandardIds.h>
+
+#include <kis_paint_device.h>
+#include <canvas/kis_update_info.h>
+#include <opengl/KisOpenGLUpdateInfoBuilder.h>
+#include <opengl/kis_texture_tile_info_pool.h>
+#include <opengl/kis_texture_tile_update_info.h>
+
+static const QRect IMAGE_RECT(0, 0, 8000, 6000);
+static const int TEXTURE_SIZE = 256;
+static const int TEXTURE_BORDER = 4;
+static const int PATCH_SIZE = 512;
+
+void KisOpenGLUpdateInfoBenchmark::benchmarkBuildUpdateInfo(const KoColorSpace *srcColorSpace, bool splitIntoPatches)
+{
+    KisPaintDeviceSP dev = new KisPaintDevice(srcColorSpace);
+
+    // fill the device with some non-uniform data to avoid
+    // the shortcuts for the default pixel
+    const int stripe = 64;
+    for (int y = IMAGE_RECT.top(); y <= IMAGE_RECT.bottom(); y += stripe) {
+        KoColor color(QColor((y / stripe) % 256, 128, 255 - (y / stripe) % 256), srcColorSpace);
+        dev->fill(QRect(IMAGE_RECT.left(), y, IMAGE_RECT.width(), stripe), color);
+    }
+
+    KisTextureTileInfoPoolRegistry poolRegistry;
+
+    KisOpenGLUpdateInfoBuilder builder;
+    builder.setTextureInfoPool(poolRegistry.getPool(TEXTURE_SIZE, TEXTURE_SIZE));
+    builder.setTextureBorder(TEXTURE_BORDER);
+    builder.setEffectiveTextureSize(QSize(TEXTURE_SIZE - 2 * TEXTURE_BORDER,
+                                          TEXTURE_SIZE - 2 * TEXTURE_BORDER));
+
+    ConversionOptions options(KoColorSpaceRegistry::instance()->rgb8(),
+                              KoColorConversionTransformation::internalRenderingIntent(),
+                              KoColorConversionTransformation::internalConversionFlags());
+    builder.setConversionOptions(options);
+
+    QVector<QRect> updateRects;
+
+    if (splitIntoPatches) {
+        for (int y = IMAGE_RECT.top(); y <= IMAGE_RECT.bottom(); y += PATCH_SIZE) {
+            for (int x = IMAGE_RECT.left(); x <= IMAGE_RECT.right(); x += PATCH_SIZE) {
+                updateRects << (QRect(x, y, PATCH_SIZE, PATCH_SIZE) & IMAGE_RECT);
+            }
+        }
+    } else {
+        updateRects << IMAGE_RECT;
+    }
+
+    qint64 numTiles = 0;
+    qint64 elapsed = 0;
+
+    QBENCHMARK {
+        QElapsedTimer timer;
+        timer.start();
+
+        Q_FOREACH (const QRect &rc, updateRects) {
+            KisOpenGLUpdateInfoSP info = builder.buildUpdateInfo(rc, dev, IMAGE_RECT, 0, true);
+            numTiles += info->tileList.size();
+        }
+
+        elapsed += timer.nsecsElapsed();
+    }
+
+    if (elapsed > 0) {
+        qDebug() << "Prepared" << numTiles << "tiles," << qreal(numTiles) * 1e9 / elapsed << "tiles/s";
+    }
+}
+
+void KisOpenGLUpdateInfoBenchmark::benchmarkFullUpdateRgb8()
+{
+    benchmarkBuildUpdateInfo(KoColorSpaceRegistry::instance()->rgb8(), false);
+}
+
+void KisOpenGLUpdateInfoBenchmark::benchmarkFullUpdateRgb16()
+{
+    benchmarkBuildUpdateInfo(KoColorSpaceRegistry::instance()->rgb16(), false);
+}
+
+void KisOpenGLUpdateInfoBenchmark::benchmarkFullUpdateRgbF32()
+{
+    const KoColorSpace *cs =
+        KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(),
+                                                     Float32BitsColorDepthID.id(), 0);
+    benchmarkBuildUpdateInfo(cs, false);
+}
+
+void KisOpenGLUpdateInfoBenchmark::benchmarkPatchUpdatesRgb8()
+{
+    benchmarkBuildUpdateInfo(KoColorSpaceRegistry::instance()->rgb8(), true);
+}
+
+void KisOpenGLUpdateInfoBenchmark::benchmarkPatchUpdatesRgb16()
+{
+    benchmarkBuildUpdateInfo(KoColorSpaceRegistry::instance()->rgb16(), true);
+}
+
+SIMPLE_TEST_MAIN(KisOpenGLUpdateInfoBenchmark)
@@ -0,0 +1,34 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_OPENGL_UPDATE_INFO_BENCHMARK_H
+#define KIS_OPENGL_UPDATE_INFO_BENCHMARK_H
+
+#include <simpletest.h>
+#include <kis_types.h>
+
+class KoColorSpace;
+
+/**
+ * Measures the CPU-side preparation of the openGL texture tiles, that
+ * is, reading the projection and converting it into the display color
+ * space. No GPU or openGL context is needed for that.
+ */
+class KisOpenGLUpdateInfoBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    void benchmarkBuildUpdateInfo(const KoColorSpace *srcColorSpace, bool splitIntoPatches);
+
+private Q_SLOTS:
+    void benchmarkFullUpdateRgb8();
+    void benchmarkFullUpdateRgb16();
+    void benchmarkFullUpdateRgbF32();
+    void benchmarkPatchUpdatesRgb8();
+    void benchmarkPatchUpdatesRgb16();
+};
+
+#endif
@@ -32,6 +32,7 @@ inline double drand48()
 
 #include <brushengine/kis_paint_information.h>
 #include <brushengine/kis_paintop_preset.h>
+#include <brushengine/kis_paintop_settings.h>
 
 #define GMP_IMAGE_WIDTH 3274
 #define GMP_IMAGE_HEIGHT 2067
@@ -178,6 +179,38 @@ void KisStrokeBenchmark::sprayPixelsRL()
 }
 
 
+KisPaintOpPresetSP KisStrokeBenchmark::loadHugeSprayPreset()
+{
+    KisPaintOpPresetSP preset(new KisPaintOpPreset(m_dataPath + "spray_wu_pixels1.kpp"));
+    if (!preset->load(KisGlobalResourcesInterface::instance())) {
+        dbgKrita << "The preset was not loaded correctly. Done.";
+        return KisPaintOpPresetSP();
+    }
+
+    // a 300px dab with thousands of anti-aliased pixel particles
+    preset->settings()->setProperty("Spray/diameter", 300);
+    preset->settings()->setProperty("Spray/useDensity", false);
+    preset->settings()->setProperty("Spray/particleCount", 5000);
+
+    return preset;
+}
+
+void KisStrokeBenchmark::sprayPixelsHuge()
+{
+    KisPaintOpPresetSP preset = loadHugeSprayPreset();
+    if (!preset) return;
+
+    benchmarkStroke(preset, "spray_wu_pixels_huge");
+}
+
+void KisStrokeBenchmark::sprayPixelsHugeRL()
+{
+    KisPaintOpPresetSP preset = loadHugeSprayPreset();
+    if (!preset) return;
+
+    benchmarkRandomLines(preset, "spray_wu_pixels_huge");
+}
+
 void KisStrokeBenchmark::sprayTexture()
 {
     QString presetFileName = "spray_21_textures1.kpp";
@@ -512,6 +545,11 @@ void KisStrokeBenchmark::benchmarkRandomLines(QString presetFileName)
         dbgKrita << "preset : " << presetFileName;
     }
 
+    benchmarkRandomLines(preset, presetFileName);
+}
+
+void KisStrokeBenchmark::benchmarkRandomLines(KisPaintOpPresetSP preset, const QString &outputName)
+{
     m_painter->setPaintOpPreset(preset, m_layer, m_image);
 
     QBENCHMARK{
@@ -524,7 +562,9 @@ void KisStrokeBenchmark::benchmarkRandomLines(QString presetFileName)
     }
 
 #ifdef SAVE_OUTPUT
-    m_layer->paintDevice()->convertToQImage(0).save(m_outputPath + presetFileName + "_randomLines" + OUTPUT_FORMAT);
+    m_layer->paintDevice()->convertToQImage(0).save(m_outputPath + outputName + "_randomLines" + OUTPUT_FORMAT);
+#else
+    Q_UNUSED(outputName);
 #endif
 }
 
@@ -570,6 +610,11 @@ void KisStrokeBenchmark::benchmarkStroke(QString presetFileName)
         dbgKrita << "preset : " << presetFileName;
     }
 
+    benchmarkStroke(preset, presetFileName);
+}
+
+void KisStrokeBenchmark::benchmarkStroke(KisPaintOpPresetSP preset, const QString &outputName)
+{
     m_painter->setPaintOpPreset(preset, m_layer, m_image);
 
     QBENCHMARK{
@@ -579,8 +624,10 @@ void KisStrokeBenchmark::benchmarkStroke(QString presetFileName)
     }
 
 #ifdef SAVE_OUTPUT
-    dbgKrita << "Saving output " << m_outputPath + presetFileName + ".png";
-    m_layer->paintDevice()->convertToQImage(0).save(m_outputPath + presetFileName + OUTPUT_FORMAT);
+    dbgKrita << "Saving output " << m_outputPath + outputName + ".png";
+    m_layer->paintDevice()->convertToQImage(0).save(m_outputPath + outputName + OUTPUT_FORMAT);
+#else
+    Q_UNUSED(outputName);
 #endif
 }
 
@@ -53,6 +53,9 @@ private:
     private:
         inline void benchmarkRandomLines(QString presetFileName);
         inline void benchmarkStroke(QString presetFileName);
+        inline void benchmarkStroke(KisPaintOpPresetSP preset, const QString &outputName);
+        inline void benchmarkRandomLines(KisPaintOpPresetSP preset, const QString &outputName);
+        KisPaintOpPresetSP loadHugeSprayPreset();
         inline void benchmarkLine(QString presetFileName);
         inline void benchmarkCircle(QString presetFileName);
         inline void benchmarkRectangle(QString presetFileName);
@@ -100,6 +103,10 @@ private Q_SLOTS:
     void sprayPixels();
     void sprayPixelsRL();
 
+    // thousands of anti-aliased pixel particles per dab
+    void sprayPixelsHuge();
+    void sprayPixelsHugeRL();
+
     void sprayTexture();
     void sprayTextureRL();
 
@@ -0,0 +1,74 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_transform_worker_benchmark.h"
+
+#include "kis_benchmark_values.h"
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoUpdater.h>
+
+#include <kis_paint_device.h>
+#include <kis_sequential_iterator.h>
+#include <kis_transform_worker.h>
+#include <kis_filter_strategy.h>
+#include <kis_painter.h>
+
+void KisTransformWorkerBenchmark::initTestCase()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    m_device = new KisPaintDevice(cs);
+
+    srand(31524744);
+
+    KoColor color(cs);
+
+    KisSequentialIterator it(m_device, QRect(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT));
+    while (it.nextPixel()) {
+        color.fromQColor(QColor(rand() % 255, rand() % 255, rand() % 255));
+        memcpy(it.rawData(), color.data(), cs->pixelSize());
+    }
+}
+
+void KisTransformWorkerBenchmark::benchmarkTransform_data()
+{
+    QTest::addColumn<qreal>("scale");
+    QTest::addColumn<qreal>("shear");
+    QTest::addColumn<qreal>("rotation");
+    QTest::addColumn<QString>("filterId");
+
+    QTest::newRow("upscale-bicubic") << 1.7 << 0.0 << 0.0 << "Bicubic";
+    QTest::newRow("downscale-bicubic") << 0.6 << 0.0 << 0.0 << "Bicubic";
+    QTest::newRow("downscale-lanczos") << 0.6 << 0.0 << 0.0 << "Lanczos3";
+    QTest::newRow("shear-bilinear") << 1.0 << 0.3 << 0.0 << "Bilinear";
+    QTest::newRow("rotate-bicubic") << 1.0 << 0.0 << 0.3 << "Bicubic";
+}
+
+void KisTransformWorkerBenchmark::benchmarkTransform()
+{
+    QFETCH(qreal, scale);
+    QFETCH(qreal, shear);
+    QFETCH(qreal, rotation);
+    QFETCH(QString, filterId);
+
+    KisFilterStrategy *filter = KisFilterStrategyRegistry::instance()->value(filterId);
+    QVERIFY(filter);
+
+    QBENCHMARK {
+        KisPaintDeviceSP dev = new KisPaintDevice(*m_device);
+
+        KisTransformWorker tw(dev, scale, scale,
+                              shear, 0.0,
+                              0.0, 0.0,
+                              rotation,
+                              0, 0, KoUpdaterPtr(), filter);
+        tw.run();
+    }
+}
+
+SIMPLE_TEST_MAIN(KisTransformWorkerBenchmark)
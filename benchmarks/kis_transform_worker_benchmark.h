@@ -0,0 +1,27 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_TRANSFORM_WORKER_BENCHMARK_H
+#define KIS_TRANSFORM_WORKER_BENCHMARK_H
+
+#include <simpletest.h>
+#include <kis_types.h>
+
+class KisTransformWorkerBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void benchmarkTransform_data();
+    void benchmarkTransform();
+
+private:
+    KisPaintDeviceSP m_device;
+};
+
+#endif
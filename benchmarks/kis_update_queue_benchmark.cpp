@@ -0,0 +1,95 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_update_queue_benchmark.h"
+
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_image.h>
+#include <kis_paint_layer.h>
+#include <kis_group_layer.h>
+#include <kis_simple_update_queue.h>
+
+#include <random>
+#include <cmath>
+
+/**
+ * The number of updates simulates a long stroke of a brush with
+ * small spacing or a script calling setDirty() in a loop
+ */
+static const int NUM_UPDATES = 30000;
+
+void KisUpdateQueueBenchmark::initTestCase()
+{
+    m_imageRect = QRect(0, 0, 16000, 16000);
+
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<int> posDist(0, m_imageRect.width() - 32);
+    std::uniform_int_distribution<int> sizeDist(4, 32);
+
+    for (int i = 0; i < NUM_UPDATES; i++) {
+        m_scatteredRects << QRect(posDist(generator), posDist(generator),
+                                  sizeDist(generator), sizeDist(generator));
+    }
+
+    /**
+     * Dabs of a small brush following a spiral: the neighbouring
+     * updates overlap and can be merged by the queue
+     */
+    const QPointF center = QRectF(m_imageRect).center();
+
+    for (int i = 0; i < NUM_UPDATES; i++) {
+        const qreal angle = 0.002 * i;
+        const qreal radius = 100.0 + 0.2 * i;
+        const QPoint pt = (center + radius * QPointF(std::cos(angle), std::sin(angle))).toPoint();
+
+        m_denseRects << QRect(pt - QPoint(8, 8), QSize(16, 16));
+    }
+}
+
+void KisUpdateQueueBenchmark::benchmarkUpdates(const QVector<QRect> &rects, int numLayers)
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, m_imageRect.width(), m_imageRect.height(), cs, "update queue benchmark");
+
+    QVector<KisNodeSP> layers;
+
+    image->barrierLock();
+    for (int i = 0; i < numLayers; i++) {
+        KisPaintLayerSP layer = new KisPaintLayer(image, QString("layer %1").arg(i), OPACITY_OPAQUE_U8);
+        image->addNode(layer);
+        layers << layer;
+    }
+    image->unlock();
+
+    QBENCHMARK {
+        KisTestableSimpleUpdateQueue queue;
+
+        for (int i = 0; i < rects.size(); i++) {
+            queue.addUpdateJob(layers[i % layers.size()], rects[i], m_imageRect, 0);
+        }
+
+        queue.optimize();
+    }
+}
+
+void KisUpdateQueueBenchmark::benchmarkScatteredSmallUpdates()
+{
+    benchmarkUpdates(m_scatteredRects, 1);
+}
+
+void KisUpdateQueueBenchmark::benchmarkDenseDabUpdates()
+{
+    benchmarkUpdates(m_denseRects, 1);
+}
+
+void KisUpdateQueueBenchmark::benchmarkMultipleLayersUpdates()
+{
+    benchmarkUpdates(m_scatteredRects, 16);
+}
+
+SIMPLE_TEST_MAIN(KisUpdateQueueBenchmark)
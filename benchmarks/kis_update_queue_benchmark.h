@@ -0,0 +1,32 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_UPDATE_QUEUE_BENCHMARK_H
+#define KIS_UPDATE_QUEUE_BENCHMARK_H
+
+#include <simpletest.h>
+#include <kis_types.h>
+
+class KisUpdateQueueBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    void benchmarkUpdates(const QVector<QRect> &rects, int numLayers);
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void benchmarkScatteredSmallUpdates();
+    void benchmarkDenseDabUpdates();
+    void benchmarkMultipleLayersUpdates();
+
+private:
+    QRect m_imageRect;
+    QVector<QRect> m_scatteredRects;
+    QVector<QRect> m_denseRects;
+};
+
+#endif
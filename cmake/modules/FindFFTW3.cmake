@@ -4,6 +4,8 @@
 #  FFTW3_FOUND - system has fftw3
 #  FFTW3_INCLUDE_DIRS - the fftw3 include directories
 #  FFTW3_LIBRARIES - the libraries needed to use fftw3
+#  FFTW3F_FOUND - the single precision version of fftw3 (fftw3f)
+#                 is also found and added to FFTW3_LIBRARIES
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -28,6 +30,17 @@ if (NOT WIN32)
 
     if(FFTW3_FOUND)
         message(STATUS "FFTW Found Version: " ${FFTW_VERSION})
+
+        find_library(FFTW3F_LIBRARY
+            NAMES fftw3f
+            HINTS ${FFTW3_PKGCONF_LIBRARY_DIRS} ${FFTW3_PKGCONF_LIBDIR}
+        )
+
+        if(FFTW3F_LIBRARY)
+            set(FFTW3F_FOUND TRUE)
+            list(APPEND FFTW3_LIBRARIES ${FFTW3F_LIBRARY})
+            message(STATUS "Found single precision FFTW: " ${FFTW3F_LIBRARY})
+        endif()
     endif()
 
 else()
@@ -44,12 +57,22 @@ else()
         NAMES libfftw3 libfftw3-3 libfftw3f-3 libfftw3l-3 fftw3
         DOC "Libraries to link against for FFT Support")
 
+    find_library(
+        FFTW3F_LIBRARY
+        NAMES libfftw3f libfftw3f-3 fftw3f
+        DOC "Single precision FFTW library")
+
     if (FFTW3_LIBRARY)
         set(FFTW3_LIBRARY_DIR ${FFTW3_LIBRARY})
     endif()
 
     set (FFTW3_LIBRARIES ${FFTW3_LIBRARY})
 
+    if (FFTW3F_LIBRARY AND NOT FFTW3F_LIBRARY STREQUAL FFTW3_LIBRARY)
+        set (FFTW3F_FOUND true)
+        list(APPEND FFTW3_LIBRARIES ${FFTW3F_LIBRARY})
+    endif()
+
     if(FFTW3_INCLUDE_DIR AND FFTW3_LIBRARY_DIR)
     set (FFTW3_FOUND true)
         message(STATUS "Correctly found FFTW3")
@@ -2,3 +2,5 @@
 /* Defines if your system has the FFTW3 library */
 #cmakedefine HAVE_FFTW3 1
 
+/* Defines if your system has the single precision version of FFTW3 library */
+#cmakedefine HAVE_FFTW3F 1
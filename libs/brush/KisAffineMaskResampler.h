@@ -0,0 +1,203 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISAFFINEMASKRESAMPLER_H
+#define KISAFFINEMASKRESAMPLER_H
+
+#include <cmath>
+#include <type_traits>
+
+#include <QTransform>
+
+#include <kis_assert.h>
+
+#include "KisAffineMaskResamplerBase.h"
+#include "KoMultiArchBuildSupport.h"
+
+namespace KisAffineMaskResamplerDetail {
+
+struct RowParams
+{
+    RowParams(const QTransform &t, int y)
+        : m11(t.m11()),
+          m12(t.m12()),
+          // the source coordinates of the center of the first pixel
+          // in the row, shifted by a half of the pixel, so that the
+          // integer coordinates would point to the source pixels
+          x(0.5 * t.m11() + (y + 0.5) * t.m21() + t.dx() - 0.5),
+          y(0.5 * t.m12() + (y + 0.5) * t.m22() + t.dy() - 0.5)
+    {
+    }
+
+    float m11;
+    float m12;
+    float x;
+    float y;
+};
+
+inline void resampleRowScalar(const quint8 *src, int srcWidth, int srcHeight, int srcRowStride,
+                              const RowParams &row, int xStart, int xEnd, quint8 *dstRow)
+{
+    const int maxX = srcWidth - 1;
+    const int maxY = srcHeight - 1;
+
+    for (int x = xStart; x < xEnd; x++) {
+        const float sx = qBound(-1.0f, row.x + x * row.m11, float(srcWidth));
+        const float sy = qBound(-1.0f, row.y + x * row.m12, float(srcHeight));
+
+        const float fx = std::floor(sx);
+        const float fy = std::floor(sy);
+        const float wx = sx - fx;
+        const float wy = sy - fy;
+
+        const int x0 = int(fx);
+        const int y0 = int(fy);
+
+        const int cx0 = qBound(0, x0, maxX);
+        const int cx1 = qBound(0, x0 + 1, maxX);
+        const quint8 *row0 = src + qBound(0, y0, maxY) * srcRowStride;
+        const quint8 *row1 = src + qBound(0, y0 + 1, maxY) * srcRowStride;
+
+        const float s00 = row0[cx0];
+        const float s01 = row0[cx1];
+        const float s10 = row1[cx0];
+        const float s11 = row1[cx1];
+
+        const float top = s00 + wx * (s01 - s00);
+        const float bottom = s10 + wx * (s11 - s10);
+
+        dstRow[x] = static_cast<quint8>(std::lrint(top + wy * (bottom - top)));
+    }
+}
+
+}
+
+template<typename _impl, typename EnableDummyType = void>
+class KisAffineMaskResampler : public KisAffineMaskResamplerBase
+{
+public:
+    void resample(const quint8 *src, int srcWidth, int srcHeight, int srcRowStride,
+                  const QTransform &dstToSrc,
+                  quint8 *dst, int dstWidth, int dstHeight, int dstRowStride) const override
+    {
+        using namespace KisAffineMaskResamplerDetail;
+        KIS_SAFE_ASSERT_RECOVER_RETURN(dstToSrc.isAffine());
+
+        for (int y = 0; y < dstHeight; y++) {
+            resampleRowScalar(src, srcWidth, srcHeight, srcRowStride,
+                              RowParams(dstToSrc, y), 0, dstWidth,
+                              dst + y * dstRowStride);
+        }
+    }
+};
+
+#if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+/**
+ * The coordinates and the weights of the samples are calculated for
+ * the whole batch of pixels at once. The source pixels are fetched
+ * one-by-one, since there is no gather for the 8-bit values.
+ */
+template<typename _impl>
+class KisAffineMaskResampler<_impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type> : public KisAffineMaskResamplerBase
+{
+    using float_v = xsimd::batch<float, _impl>;
+    using int_v = xsimd::batch<int, _impl>;
+
+public:
+    void resample(const quint8 *src, int srcWidth, int srcHeight, int srcRowStride,
+                  const QTransform &dstToSrc,
+                  quint8 *dst, int dstWidth, int dstHeight, int dstRowStride) const override
+    {
+        using namespace KisAffineMaskResamplerDetail;
+        KIS_SAFE_ASSERT_RECOVER_RETURN(dstToSrc.isAffine());
+
+        constexpr int vectorSize = static_cast<int>(float_v::size);
+
+        int offsets[4][vectorSize];
+        float samples[4][vectorSize];
+        int values[vectorSize];
+
+        const float_v indexes = xsimd::detail::make_sequence_as_batch<float_v>();
+
+        const float_v minCoord(-1.0f);
+        const float_v maxCoordX(static_cast<float>(srcWidth));
+        const float_v maxCoordY(static_cast<float>(srcHeight));
+
+        const int_v zero(0);
+        const int_v one(1);
+        const int_v maxX(srcWidth - 1);
+        const int_v maxY(srcHeight - 1);
+        const int_v rowStride(srcRowStride);
+
+        for (int y = 0; y < dstHeight; y++) {
+            const RowParams row(dstToSrc, y);
+            quint8 *dstRow = dst + y * dstRowStride;
+
+            const float_v m11(row.m11);
+            const float_v m12(row.m12);
+            const float_v rowX(row.x);
+            const float_v rowY(row.y);
+
+            int x = 0;
+
+            for (; x + vectorSize <= dstWidth; x += vectorSize) {
+                const float_v xs = indexes + float_v(static_cast<float>(x));
+
+                const float_v sx = xsimd::min(xsimd::max(xsimd::fma(xs, m11, rowX), minCoord), maxCoordX);
+                const float_v sy = xsimd::min(xsimd::max(xsimd::fma(xs, m12, rowY), minCoord), maxCoordY);
+
+                const float_v fx = xsimd::floor(sx);
+                const float_v fy = xsimd::floor(sy);
+                const float_v wx = sx - fx;
+                const float_v wy = sy - fy;
+
+                const int_v x0 = xsimd::to_int(fx);
+                const int_v y0 = xsimd::to_int(fy);
+
+                const int_v cx0 = xsimd::min(xsimd::max(x0, zero), maxX);
+                const int_v cx1 = xsimd::min(xsimd::max(x0 + one, zero), maxX);
+                const int_v row0 = xsimd::min(xsimd::max(y0, zero), maxY) * rowStride;
+                const int_v row1 = xsimd::min(xsimd::max(y0 + one, zero), maxY) * rowStride;
+
+                (row0 + cx0).store_unaligned(offsets[0]);
+                (row0 + cx1).store_unaligned(offsets[1]);
+                (row1 + cx0).store_unaligned(offsets[2]);
+                (row1 + cx1).store_unaligned(offsets[3]);
+
+                for (int i = 0; i < vectorSize; i++) {
+                    samples[0][i] = src[offsets[0][i]];
+                    samples[1][i] = src[offsets[1][i]];
+                    samples[2][i] = src[offsets[2][i]];
+                    samples[3][i] = src[offsets[3][i]];
+                }
+
+                const float_v s00 = float_v::load_unaligned(samples[0]);
+                const float_v s01 = float_v::load_unaligned(samples[1]);
+                const float_v s10 = float_v::load_unaligned(samples[2]);
+                const float_v s11 = float_v::load_unaligned(samples[3]);
+
+                const float_v top = xsimd::fma(wx, s01 - s00, s00);
+                const float_v bottom = xsimd::fma(wx, s11 - s10, s10);
+                const float_v value = xsimd::fma(wy, bottom - top, top);
+
+                xsimd::nearbyint_as_int(value).store_unaligned(values);
+
+                for (int i = 0; i < vectorSize; i++) {
+                    dstRow[x + i] = static_cast<quint8>(values[i]);
+                }
+            }
+
+            resampleRowScalar(src, srcWidth, srcHeight, srcRowStride,
+                              row, x, dstWidth, dstRow);
+        }
+    }
+};
+
+#endif /* HAVE_XSIMD */
+
+#endif // KISAFFINEMASKRESAMPLER_H
@@ -0,0 +1,41 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISAFFINEMASKRESAMPLERBASE_H
+#define KISAFFINEMASKRESAMPLERBASE_H
+
+#include <QtGlobal>
+#include <kritabrush_export.h>
+
+class QTransform;
+
+/**
+ * Resamples an 8-bit mask with an affine transform using bilinear
+ * interpolation. The implementations are vectorized for every
+ * architecture supported by xsimd, use createOptimizedClass() with
+ * KisAffineMaskResamplerFactoryImpl to get the best one.
+ */
+class BRUSH_EXPORT KisAffineMaskResamplerBase
+{
+public:
+    virtual ~KisAffineMaskResamplerBase();
+
+    /**
+     * Fills \p dst with the values of \p src sampled at the points
+     * \p dstToSrc maps the centers of the destination pixels to. The
+     * centers of the source pixels are considered to be at half-integer
+     * coordinates, like QPainter does.
+     *
+     * The samples lying outside the source are clamped to its edge,
+     * so the caller should add a transparent border to the source
+     * if it needs the outer area to be transparent.
+     */
+    virtual void resample(const quint8 *src, int srcWidth, int srcHeight, int srcRowStride,
+                          const QTransform &dstToSrc,
+                          quint8 *dst, int dstWidth, int dstHeight, int dstRowStride) const = 0;
+};
+
+#endif // KISAFFINEMASKRESAMPLERBASE_H
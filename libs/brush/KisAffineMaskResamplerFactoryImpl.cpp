@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisAffineMaskResamplerFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KisAffineMaskResampler.h"
+
+template<typename _impl>
+KisAffineMaskResamplerBase *KisAffineMaskResamplerFactoryImpl::create()
+{
+    return new KisAffineMaskResampler<_impl>();
+}
+
+template KisAffineMaskResamplerBase *KisAffineMaskResamplerFactoryImpl::create<xsimd::current_arch>();
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
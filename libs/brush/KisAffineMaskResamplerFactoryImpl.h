@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISAFFINEMASKRESAMPLERFACTORYIMPL_H
+#define KISAFFINEMASKRESAMPLERFACTORYIMPL_H
+
+#include <KisAffineMaskResamplerBase.h>
+#include <KoMultiArchBuildSupport.h>
+
+class BRUSH_EXPORT KisAffineMaskResamplerFactoryImpl
+{
+public:
+    template<typename _impl>
+    static KisAffineMaskResamplerBase *create();
+};
+
+#endif // KISAFFINEMASKRESAMPLERFACTORYIMPL_H
@@ -596,10 +596,20 @@ void KisBrush::generateMaskAndApplyMaskOrCreateDab(KisFixedPaintDeviceSP dst,
     Q_UNUSED(info_);
     Q_UNUSED(softnessFactor);
 
-    QImage outputImage = d->brushPyramid.value(this)->createImage(KisDabShape(
-                                                                         shape.scale() * d->scale, shape.ratio(),
-                                                                         -normalizeAngle(shape.rotation() + d->angle)),
-                                                                     subPixelX, subPixelY);
+    const KisDabShape pyramidShape(shape.scale() * d->scale, shape.ratio(),
+                                   -normalizeAngle(shape.rotation() + d->angle));
+
+    /**
+     * When only the opacity of the brush pixels is needed, we can
+     * resample the 8-bit mask directly, which is much faster than
+     * transforming the full ARGB image with QPainter
+     */
+    if (!preserveLightness() && !applyingGradient()) {
+        generateMaskAndApplyMaskOrCreateDabFromAlphaMask(dst, coloringInformation, pyramidShape, subPixelX, subPixelY);
+        return;
+    }
+
+    QImage outputImage = d->brushPyramid.value(this)->createImage(pyramidShape, subPixelX, subPixelY);
 
     qint32 maskWidth = outputImage.width();
     qint32 maskHeight = outputImage.height();
@@ -688,6 +698,59 @@ void KisBrush::generateMaskAndApplyMaskOrCreateDab(KisFixedPaintDeviceSP dst,
 
 }
 
+void KisBrush::generateMaskAndApplyMaskOrCreateDabFromAlphaMask(KisFixedPaintDeviceSP dst,
+                                                                ColoringInformation* coloringInformation,
+                                                                KisDabShape const& pyramidShape,
+                                                                double subPixelX, double subPixelY) const
+{
+    const QImage alphaMask = d->brushPyramid.value(this)->createAlphaMask(pyramidShape, subPixelX, subPixelY);
+
+    const qint32 maskWidth = alphaMask.width();
+    const qint32 maskHeight = alphaMask.height();
+
+    dst->setRect(QRect(0, 0, maskWidth, maskHeight));
+    dst->lazyGrowBufferWithoutInitialization();
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(coloringInformation);
+
+    const KoColorSpace *cs = dst->colorSpace();
+    const quint32 pixelSize = cs->pixelSize();
+    quint8 *rowPointer = dst->data();
+
+    /**
+     * fillGrayBrushWithColor() replaces the alpha channel of the color
+     * with the mask value, so make the color opaque to get the same
+     * result from applyAlphaU8Mask()
+     */
+    QScopedArrayPointer<quint8> opaqueColor;
+    if (dynamic_cast<PlainColoringInformation*>(coloringInformation)) {
+        opaqueColor.reset(new quint8[pixelSize]);
+        memcpy(opaqueColor.data(), coloringInformation->color(), pixelSize);
+        cs->setOpacity(opaqueColor.data(), OPACITY_OPAQUE_U8, 1);
+    }
+
+    for (int y = 0; y < maskHeight; y++) {
+        quint8 *pixel = rowPointer;
+
+        if (opaqueColor) {
+            for (int x = 0; x < maskWidth; x++) {
+                memcpy(pixel, opaqueColor.data(), pixelSize);
+                pixel += pixelSize;
+            }
+        } else {
+            for (int x = 0; x < maskWidth; x++) {
+                memcpy(pixel, coloringInformation->color(), pixelSize);
+                coloringInformation->nextColumn();
+                pixel += pixelSize;
+            }
+            coloringInformation->nextRow();
+        }
+
+        cs->applyAlphaU8Mask(rowPointer, alphaMask.constScanLine(y), maskWidth);
+        rowPointer += maskWidth * pixelSize;
+    }
+}
+
 KisFixedPaintDeviceSP KisBrush::paintDevice(const KoColorSpace * colorSpace,
                                             KisDabShape const& shape,
                                             const KisPaintInformation& info,
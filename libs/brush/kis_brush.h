@@ -381,6 +381,13 @@ protected:
 
     void predefinedBrushToXML(const QString &type, QDomElement& e) const;
 
+private:
+
+    void generateMaskAndApplyMaskOrCreateDabFromAlphaMask(KisFixedPaintDeviceSP dst,
+                                                          ColoringInformation* coloringInfo,
+                                                          KisDabShape const& pyramidShape,
+                                                          double subPixelX, double subPixelY) const;
+
 private:
 
     struct Private;
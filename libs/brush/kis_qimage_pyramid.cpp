@@ -6,21 +6,219 @@
 
 #include "kis_qimage_pyramid.h"
 
+#include <cmath>
 #include <limits>
+#include <QAtomicInteger>
+#include <QCache>
+#include <QMutex>
 #include <QPainter>
+#include <QScopedPointer>
 #include <kis_debug.h>
+#include <KoColorSpaceMaths.h>
+
+#include "KisAffineMaskResamplerFactoryImpl.h"
 
 #define MIPMAP_SIZE_THRESHOLD 512
 #define MAX_MIPMAP_SCALE 8.0
 
 #define QPAINTER_WORKAROUND_BORDER 1
 
+#define DAB_CACHE_MAX_COST_KB (64 * 1024)
+
+namespace {
+
+/**
+ * The key of the dab cache. The cache is shared by all the pyramids,
+ * so the key starts with the unique id of the pyramid.
+ *
+ * Scale and ratio are quantized relatively, to 11 bits of the mantissa,
+ * so the round values like 0.5 or 2.0 are kept intact. Rotation is
+ * quantized to 1/16384 of the full turn and the subpixel offset to 1/64
+ * of a pixel. The size of the resulting image is also a part of the key,
+ * so that the dab returned from the cache always has the size the paintop
+ * expects.
+ *
+ * The 8-bit masks of the pyramid levels are stored in the same cache,
+ * their keys have only the id and the non-negative maskLevel set.
+ */
+struct DabCacheKey
+{
+    quint64 pyramidId = 0;
+    int maskLevel = -1;
+    qreal scale = 0.0;
+    qreal ratio = 0.0;
+    qint64 rotation = 0;
+    qint64 subPixelX = 0;
+    qint64 subPixelY = 0;
+    QSize size;
+    bool isAlphaMask = false;
+
+    bool operator==(const DabCacheKey &rhs) const {
+        return pyramidId == rhs.pyramidId &&
+            maskLevel == rhs.maskLevel &&
+            isAlphaMask == rhs.isAlphaMask &&
+            scale == rhs.scale &&
+            ratio == rhs.ratio &&
+            rotation == rhs.rotation &&
+            subPixelX == rhs.subPixelX &&
+            subPixelY == rhs.subPixelY &&
+            size == rhs.size;
+    }
+};
+
+inline uint qHash(const DabCacheKey &key, uint seed = 0)
+{
+    return ::qHash(key.pyramidId * 257 + key.maskLevel, seed) ^
+        ::qHash(key.scale, seed) ^
+        ::qHash(key.ratio, seed) ^
+        ::qHash(key.rotation * 31 + key.subPixelX * 17 + key.subPixelY, seed) ^
+        ::qHash(qint64(key.size.width()) << 32 | key.size.height(), seed) ^
+        ::qHash(key.isAlphaMask, seed);
+}
+
+inline qreal quantizeRelative(qreal value)
+{
+    int exponent = 0;
+    const qreal mantissa = std::frexp(value, &exponent);
+    return std::ldexp(std::round(mantissa * 2048.0), exponent - 11);
+}
+
+inline qint64 quantizeAbsolute(qreal value, qreal step)
+{
+    return qRound64(value / step);
+}
+
+KisAffineMaskResamplerBase *maskResampler()
+{
+    static QScopedPointer<KisAffineMaskResamplerBase> resampler(
+        createOptimizedClass<KisAffineMaskResamplerFactoryImpl>());
+    return resampler.data();
+}
+
+/**
+ * A process-wide LRU cache of the rendered dabs and of the 8-bit masks
+ * of the pyramid levels. Its budget is shared by all the brush tips,
+ * so the memory doesn't grow with the number of the tips used.
+ */
+class DabCache
+{
+public:
+    DabCache() {
+        m_images.setMaxCost(DAB_CACHE_MAX_COST_KB);
+    }
+
+    static bool canUseCache(KisDabShape const& shape, qreal subPixelX, qreal subPixelY) {
+        return std::isfinite(shape.scale()) && std::isfinite(shape.ratio()) &&
+            std::isfinite(shape.rotation()) &&
+            std::isfinite(subPixelX) && std::isfinite(subPixelY);
+    }
+
+    static DabCacheKey key(quint64 pyramidId,
+                           KisDabShape const& shape,
+                           qreal subPixelX, qreal subPixelY,
+                           const QSize &size, bool isAlphaMask) {
+        DabCacheKey key;
+        key.pyramidId = pyramidId;
+        key.scale = quantizeRelative(shape.scale());
+        key.ratio = quantizeRelative(shape.ratio());
+        key.rotation = quantizeAbsolute(shape.rotation(), 2 * M_PI / 16384);
+        key.subPixelX = quantizeAbsolute(subPixelX, 1.0 / 64);
+        key.subPixelY = quantizeAbsolute(subPixelY, 1.0 / 64);
+        key.size = size;
+        key.isAlphaMask = isAlphaMask;
+        return key;
+    }
+
+    static DabCacheKey maskLevelKey(quint64 pyramidId, int level) {
+        DabCacheKey key;
+        key.pyramidId = pyramidId;
+        key.maskLevel = level;
+        return key;
+    }
+
+    bool fetch(const DabCacheKey &key, QImage *image) {
+        QMutexLocker l(&m_mutex);
+        if (const QImage *cachedImage = m_images.object(key)) {
+            *image = *cachedImage;
+            return true;
+        }
+        return false;
+    }
+
+    void store(const DabCacheKey &key, const QImage &image) {
+        const int cost = qMax(1, int(image.sizeInBytes() / 1024));
+
+        /**
+         * Huge dabs would just wash out the rest of the cache,
+         * so don't store them. The mask levels are stored unless
+         * they are bigger than the whole cache, since recreating
+         * them is much more expensive than resampling a dab.
+         */
+        const int maxCost = key.maskLevel >= 0 ?
+            DAB_CACHE_MAX_COST_KB : DAB_CACHE_MAX_COST_KB / 4;
+
+        if (cost <= maxCost) {
+            QMutexLocker l(&m_mutex);
+            m_images.insert(key, new QImage(image), cost);
+        }
+    }
+
+    /**
+     * Drops all the images of the pyramid, so they wouldn't
+     * occupy the budget until they are washed out by the LRU
+     */
+    void removePyramid(quint64 pyramidId) {
+        QMutexLocker l(&m_mutex);
+
+        Q_FOREACH (const DabCacheKey &key, m_images.keys()) {
+            if (key.pyramidId == pyramidId) {
+                m_images.remove(key);
+            }
+        }
+    }
+
+    static quint64 generatePyramidId() {
+        static QAtomicInteger<quint64> lastId(0);
+        return ++lastId;
+    }
+
+private:
+    QMutex m_mutex;
+    QCache<DabCacheKey, QImage> m_images;
+};
+
+}
+
+Q_GLOBAL_STATIC(DabCache, s_dabCache)
+
+/**
+ * The identity of the pyramid in the global dab cache. It is shared
+ * between the copies of the pyramid, which share the levels as well,
+ * and drops the images of the pyramid from the cache on destruction.
+ */
+struct KisQImagePyramid::DabCacheHandle
+{
+    DabCacheHandle()
+        : pyramidId(DabCache::generatePyramidId())
+    {
+    }
+
+    ~DabCacheHandle() {
+        if (s_dabCache.exists() && !s_dabCache.isDestroyed()) {
+            s_dabCache->removePyramid(pyramidId);
+        }
+    }
+
+    const quint64 pyramidId;
+};
+
 
 KisQImagePyramid::KisQImagePyramid(const QImage &baseImage, bool useSmoothingForEnlarging)
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN(!baseImage.isNull());
 
     m_originalSize = baseImage.size();
+    m_dabCacheHandle.reset(new DabCacheHandle());
 
 
     qreal scale = MAX_MIPMAP_SCALE;
@@ -265,8 +463,6 @@ QImage KisQImagePyramid::createImage(KisDabShape const& shape,
     qreal baseScale = -1.0;
     int level = findNearestLevel(shape.scale(), &baseScale);
 
-    const QImage &srcImage = m_levels[level].image;
-
     QTransform transform;
     QSize dstSize;
 
@@ -274,6 +470,33 @@ QImage KisQImagePyramid::createImage(KisDabShape const& shape,
                     m_originalSize, baseScale, m_levels[level].size,
                     &transform, &dstSize);
 
+    const bool canUseCache =
+        m_dabCacheHandle && DabCache::canUseCache(shape, subPixelX, subPixelY);
+
+    DabCacheKey key;
+
+    if (canUseCache) {
+        key = DabCache::key(m_dabCacheHandle->pyramidId, shape, subPixelX, subPixelY, dstSize, false);
+
+        QImage cachedImage;
+        if (s_dabCache->fetch(key, &cachedImage)) {
+            return cachedImage;
+        }
+    }
+
+    QImage dstImage = createImageImpl(level, transform, dstSize);
+
+    if (canUseCache) {
+        s_dabCache->store(key, dstImage);
+    }
+
+    return dstImage;
+}
+
+QImage KisQImagePyramid::createImageImpl(int level, QTransform transform, const QSize &dstSize) const
+{
+    const QImage &srcImage = m_levels[level].image;
+
     if (transform.isIdentity() &&
             srcImage.format() == QImage::Format_ARGB32) {
 
@@ -312,6 +535,91 @@ QImage KisQImagePyramid::createImage(KisDabShape const& shape,
     return dstImage;
 }
 
+QImage KisQImagePyramid::createAlphaMask(KisDabShape const& shape,
+                                         qreal subPixelX, qreal subPixelY) const
+{
+    if (m_levels.isEmpty() || !m_dabCacheHandle) return QImage();
+
+    qreal baseScale = -1.0;
+    int level = findNearestLevel(shape.scale(), &baseScale);
+
+    QTransform transform;
+    QSize dstSize;
+
+    calculateParams(shape, subPixelX, subPixelY,
+                    m_originalSize, baseScale, m_levels[level].size,
+                    &transform, &dstSize);
+
+    const bool canUseCache = DabCache::canUseCache(shape, subPixelX, subPixelY);
+
+    DabCacheKey key;
+
+    if (canUseCache) {
+        key = DabCache::key(m_dabCacheHandle->pyramidId, shape, subPixelX, subPixelY, dstSize, true);
+
+        QImage cachedImage;
+        if (s_dabCache->fetch(key, &cachedImage)) {
+            return cachedImage;
+        }
+    }
+
+    const QImage srcMask = maskLevel(level);
+
+    QImage dstImage(dstSize, QImage::Format_Grayscale8);
+
+    const QTransform dstToSrc =
+        (QTransform::fromTranslate(-QPAINTER_WORKAROUND_BORDER,
+                                   -QPAINTER_WORKAROUND_BORDER) * transform).inverted();
+
+    maskResampler()->resample(srcMask.constBits(),
+                              srcMask.width(), srcMask.height(),
+                              srcMask.bytesPerLine(),
+                              dstToSrc,
+                              dstImage.bits(),
+                              dstImage.width(), dstImage.height(),
+                              dstImage.bytesPerLine());
+
+    if (canUseCache) {
+        s_dabCache->store(key, dstImage);
+    }
+
+    return dstImage;
+}
+
+QImage KisQImagePyramid::maskLevel(int level) const
+{
+    const DabCacheKey key = DabCache::maskLevelKey(m_dabCacheHandle->pyramidId, level);
+
+    QImage mask;
+    if (s_dabCache->fetch(key, &mask)) {
+        return mask;
+    }
+
+    /**
+     * Several threads may create the same mask concurrently, which is
+     * harmless: the masks are equal and the cache keeps the last one
+     */
+    const QImage &srcImage = m_levels[level].image;
+    KIS_SAFE_ASSERT_RECOVER_NOOP(srcImage.format() == QImage::Format_ARGB32);
+
+    mask = QImage(srcImage.size(), QImage::Format_Grayscale8);
+
+    for (int y = 0; y < srcImage.height(); y++) {
+        const QRgb *srcPtr = reinterpret_cast<const QRgb*>(srcImage.constScanLine(y));
+        quint8 *dstPtr = mask.scanLine(y);
+
+        for (int x = 0; x < srcImage.width(); x++) {
+            *dstPtr = KoColorSpaceMaths<quint8>::multiply(255 - qRed(*srcPtr), qAlpha(*srcPtr));
+            srcPtr++;
+            dstPtr++;
+        }
+    }
+
+    s_dabCache->store(key, mask);
+
+    return mask;
+}
+
 QImage KisQImagePyramid::getClosest(QTransform transform, qreal *scale) const
 {
     if (m_levels.isEmpty()) return QImage();
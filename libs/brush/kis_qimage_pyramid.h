@@ -9,6 +9,7 @@
 
 #include <QImage>
 #include <QVector>
+#include <QSharedPointer>
 #include <kis_dab_shape.h>
 #include <kritabrush_export.h>
 
@@ -26,9 +27,39 @@ public:
 
     static QSizeF characteristicSize(const QSize &originalSize, KisDabShape const&);
 
+    /**
+     * Creates a transformed dab image for \p shape and the subpixel offset.
+     *
+     * The rendered images are memoized in a memory-bounded LRU cache
+     * shared by all the pyramids. The key of the cache is the shape and
+     * the offset quantized to the steps much finer than the ones
+     * used by KisDabCacheBase, so repeated stroke patterns (hatching,
+     * stippling) reuse the dabs even in different strokes, since the
+     * pyramid is shared between the clones of the brush. A dab returned
+     * from the cache may have been rendered for the parameters differing
+     * from the requested ones within the quantization step, but its size
+     * is always the same as imageSize() reports.
+     */
     QImage createImage(KisDabShape const&,
                        qreal subPixelX, qreal subPixelY) const;
 
+    /**
+     * Creates an 8-bit alpha mask of the dab for \p shape and the subpixel
+     * offset. The value of the mask is the opacity of the brush pixel,
+     * that is, (255 - red) * alpha, the same value KisBrush computes from
+     * the image returned by createImage(). The size of the mask is the
+     * same as the size of the image.
+     *
+     * The mask is resampled directly from the 8-bit copy of the closest
+     * pyramid level with the vectorized bilinear resampler, without
+     * going through QPainter. The masks are memoized in the same cache
+     * as the images.
+     *
+     * The returned image has QImage::Format_Grayscale8 format.
+     */
+    QImage createAlphaMask(KisDabShape const&,
+                           qreal subPixelX, qreal subPixelY) const;
+
     QImage getClosest(QTransform transform, qreal *scale) const;
 
     QImage getClosestWithoutWorkaroundBorder(QTransform transform, qreal *scale) const;
@@ -38,6 +69,9 @@ private:
     int findNearestLevel(qreal scale, qreal *baseScale) const;
     void appendPyramidLevel(const QImage &image);
 
+    QImage createImageImpl(int level, QTransform transform, const QSize &dstSize) const;
+    QImage maskLevel(int level) const;
+
     static void calculateParams(KisDabShape const& shape,
                                 qreal subPixelX, qreal subPixelY,
                                 const QSize &originalSize,
@@ -62,6 +96,9 @@ private:
     };
 
     QVector<PyramidLevel> m_levels;
+
+    struct DabCacheHandle;
+    QSharedPointer<DabCacheHandle> m_dabCacheHandle;
 };
 
 #endif /* __KIS_QIMAGE_PYRAMID_H */
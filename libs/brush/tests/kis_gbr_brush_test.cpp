@@ -12,6 +12,7 @@
 #include <KoColor.h>
 #include <KoColorSpace.h>
 #include <KoColorSpaceRegistry.h>
+#include <KoColorSpaceMaths.h>
 #include <testutil.h>
 #include "../kis_gbr_brush.h"
 #include "kis_types.h"
@@ -188,6 +189,48 @@ void KisGbrBrushTest::benchmarkMaskScaling()
     }
 }
 
+void KisGbrBrushTest::benchmarkMaskRotation()
+{
+    QScopedPointer<KisGbrBrush> brush(new KisGbrBrush(QString(FILES_DATA_DIR) + '/' + "testing_brush_512_bars.gbr"));
+    brush->load(KisGlobalResourcesInterface::instance());
+    QVERIFY(!brush->brushTipImage().isNull());
+    qsrand(1);
+
+    const KoColorSpace* cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintInformation info(QPointF(100.0, 100.0), 0.5);
+    KisFixedPaintDeviceSP dab = new KisFixedPaintDevice(cs);
+    KoColor c(Qt::black, cs);
+
+    QBENCHMARK {
+        const qreal rotation = qreal(qrand()) / RAND_MAX * 2 * M_PI;
+        const qreal subPixelX = qreal(qrand()) / RAND_MAX;
+        const qreal subPixelY = qreal(qrand()) / RAND_MAX;
+        brush->mask(dab, c, KisDabShape(1.0, 1.0, rotation), info, subPixelX, subPixelY, 1.0);
+    }
+}
+
+void KisGbrBrushTest::benchmarkMaskRotationDevColor()
+{
+    QScopedPointer<KisGbrBrush> brush(new KisGbrBrush(QString(FILES_DATA_DIR) + '/' + "testing_brush_512_bars.gbr"));
+    brush->load(KisGlobalResourcesInterface::instance());
+    QVERIFY(!brush->brushTipImage().isNull());
+    qsrand(1);
+
+    const KoColorSpace* cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintInformation info(QPointF(100.0, 100.0), 0.5);
+    KisFixedPaintDeviceSP dab = new KisFixedPaintDevice(cs);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+    dev->fill(0, 0, 1024, 1024, KoColor(Qt::red, cs).data());
+
+    QBENCHMARK {
+        const qreal rotation = qreal(qrand()) / RAND_MAX * 2 * M_PI;
+        const qreal subPixelX = qreal(qrand()) / RAND_MAX;
+        const qreal subPixelY = qreal(qrand()) / RAND_MAX;
+        brush->mask(dab, dev, KisDabShape(1.0, 1.0, rotation), info, subPixelX, subPixelY, 1.0);
+    }
+}
+
 void KisGbrBrushTest::testPyramidLevelRounding()
 {
     QSize imageSize(41, 41);
@@ -240,6 +283,92 @@ void KisGbrBrushTest::testPyramidDabTransform()
     QCOMPARE(dabTransformHelper(KisDabShape(1.0, 0.5, M_PI / 4)), QSize(160, 160));
 }
 
+void KisGbrBrushTest::testPyramidDabCache()
+{
+    QImage image(QSize(41, 41), QImage::Format_ARGB32);
+    image.fill(0);
+    {
+        QPainter gc(&image);
+        gc.fillRect(QRect(5, 5, 20, 30), Qt::black);
+    }
+
+    KisQImagePyramid pyramid(image);
+
+    const KisDabShape shape(0.7, 0.8, 0.3);
+
+    const QImage dab1 = pyramid.createImage(shape, 0.25, 0.5);
+    const QImage dab2 = pyramid.createImage(shape, 0.25, 0.5);
+
+    // the second dab is fetched from the cache
+    QCOMPARE(dab2.cacheKey(), dab1.cacheKey());
+    QCOMPARE(dab2.size(), KisQImagePyramid::imageSize(image.size(), shape, 0.25, 0.5));
+
+    // the offset differing within the quantization step reuses the dab
+    const QImage dab3 = pyramid.createImage(shape, 0.25 + 1e-4, 0.5);
+    QCOMPARE(dab3.cacheKey(), dab1.cacheKey());
+
+    // a different rotation produces a different dab
+    const QImage dab4 = pyramid.createImage(KisDabShape(0.7, 0.8, 0.6), 0.25, 0.5);
+    QVERIFY(dab4.cacheKey() != dab1.cacheKey());
+
+    // the cache is shared by all the pyramids, but their dabs are never mixed
+    KisQImagePyramid freshPyramid(image);
+    const QImage freshDab = freshPyramid.createImage(shape, 0.25, 0.5);
+    QVERIFY(freshDab.cacheKey() != dab1.cacheKey());
+
+    // a copy of the pyramid shares the dabs with the original
+    KisQImagePyramid pyramidCopy(pyramid);
+    QCOMPARE(pyramidCopy.createImage(shape, 0.25, 0.5).cacheKey(), dab1.cacheKey());
+
+    // the cached dab is the same as the one rendered without the cache
+    QPoint errpoint;
+    QVERIFY(TestUtil::compareQImages(errpoint, freshDab, dab2));
+}
+
+void KisGbrBrushTest::testAlphaMaskResampling()
+{
+    QScopedPointer<KisGbrBrush> brush(new KisGbrBrush(QString(FILES_DATA_DIR) + '/' + "testing_brush_512_bars.gbr"));
+    brush->load(KisGlobalResourcesInterface::instance());
+    QVERIFY(!brush->brushTipImage().isNull());
+
+    KisQImagePyramid pyramid(brush->brushTipImage());
+
+    const QVector<KisDabShape> shapes = {
+        KisDabShape(1.0, 1.0, 0.0),
+        KisDabShape(0.37, 1.0, 0.0),
+        KisDabShape(1.0, 1.0, 0.7),
+        KisDabShape(0.6, 0.5, 2.3),
+        KisDabShape(1.7, 0.8, 4.1)
+    };
+
+    Q_FOREACH (const KisDabShape &shape, shapes) {
+        const QImage image = pyramid.createImage(shape, 0.3, 0.6);
+        const QImage mask = pyramid.createAlphaMask(shape, 0.3, 0.6);
+
+        QCOMPARE(mask.format(), QImage::Format_Grayscale8);
+        QCOMPARE(mask.size(), image.size());
+
+        /**
+         * QPainter uses fixed point weights for the bilinear
+         * interpolation, so allow a small difference
+         */
+        int maxDifference = 0;
+
+        for (int y = 0; y < image.height(); y++) {
+            const QRgb *imagePtr = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+            const quint8 *maskPtr = mask.constScanLine(y);
+
+            for (int x = 0; x < image.width(); x++) {
+                const int expected = KoColorSpaceMaths<quint8>::multiply(255 - qRed(imagePtr[x]), qAlpha(imagePtr[x]));
+                maxDifference = qMax(maxDifference, qAbs(expected - int(maskPtr[x])));
+            }
+        }
+
+        QVERIFY2(maxDifference <= 3, QString("shape (%1, %2, %3), max difference %4")
+                 .arg(shape.scale()).arg(shape.ratio()).arg(shape.rotation()).arg(maxDifference).toLatin1());
+    }
+}
+
 // see comment in KisQImagePyramid::appendPyramidLevel
 void KisGbrBrushTest::testQPainterTransformationBorder()
 {
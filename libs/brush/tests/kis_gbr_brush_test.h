@@ -25,9 +25,13 @@ private Q_SLOTS:
     void benchmarkScaling();
     void benchmarkRotation();
     void benchmarkMaskScaling();
+    void benchmarkMaskRotation();
+    void benchmarkMaskRotationDevColor();
 
     void testPyramidLevelRounding();
     void testPyramidDabTransform();
+    void testPyramidDabCache();
+    void testAlphaMaskResampling();
 
     void testQPainterTransformationBorder();
 };
@@ -0,0 +1,602 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisGaussianBoxCascadeWorker.h"
+
+#include <QBitArray>
+#include <QRect>
+#include <QtMath>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <KoChannelInfo.h>
+#include <KoColorSpace.h>
+#include <KoUpdater.h>
+
+#include "kis_global.h"
+#include "kis_assert.h"
+#include "kis_paint_device.h"
+#include "kis_datamanager.h"
+#include "kis_default_bounds.h"
+#include "kis_math_toolbox.h"
+#include "kis_gaussian_kernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+const qreal KisGaussianBoxCascadeWorker::autoMinRadius = 64.0;
+
+namespace {
+
+/**
+ * The size of the bands the area is split into. It should be
+ * a multiple of the tile size, so that the bands would never
+ * write into the same tile concurrently.
+ */
+const int bandSize = 64;
+
+struct ChannelsInfo
+{
+    ChannelsInfo(const KoColorSpace *colorSpace, const QBitArray &channelFlags)
+    {
+        const QList<KoChannelInfo*> channels = colorSpace->channels();
+
+        for (int i = 0; i < channels.size(); i++) {
+            if (channelFlags.isEmpty() || channelFlags.testBit(i)) {
+                convChannelList.append(channels[i]);
+            }
+        }
+
+        KisMathToolbox mathToolbox;
+
+        for (int i = 0; i < convChannelList.size(); i++) {
+            minClamp.append(mathToolbox.minChannelValue(convChannelList[i]));
+            maxClamp.append(mathToolbox.maxChannelValue(convChannelList[i]));
+            channelPos.append(convChannelList[i]->pos());
+
+            if (convChannelList[i]->channelType() == KoChannelInfo::ALPHA) {
+                alphaCachePos = i;
+                alphaRealPos = convChannelList[i]->pos();
+            }
+        }
+
+        toDoubleFuncPtr.resize(convChannelList.size());
+        fromDoubleFuncPtr.resize(convChannelList.size());
+        fromDoubleCheckNullFuncPtr.resize(convChannelList.size());
+
+        bool result = mathToolbox.getToDoubleChannelPtr(convChannelList, toDoubleFuncPtr);
+        result &= mathToolbox.getFromDoubleChannelPtr(convChannelList, fromDoubleFuncPtr);
+        result &= mathToolbox.getFromDoubleCheckNullChannelPtr(convChannelList, fromDoubleCheckNullFuncPtr);
+
+        KIS_ASSERT(result);
+    }
+
+    inline int numChannels() const {
+        return convChannelList.size();
+    }
+
+    QList<KoChannelInfo*> convChannelList;
+    QVector<int> channelPos;
+    QVector<qreal> minClamp;
+    QVector<qreal> maxClamp;
+
+    QVector<PtrToDouble> toDoubleFuncPtr;
+    QVector<PtrFromDouble> fromDoubleFuncPtr;
+    QVector<PtrFromDoubleCheckNull> fromDoubleCheckNullFuncPtr;
+
+    int alphaCachePos {-1};
+    int alphaRealPos {-1};
+};
+
+struct CascadeContext
+{
+    CascadeContext(const KoColorSpace *colorSpace, const QBitArray &channelFlags)
+        : info(colorSpace, channelFlags),
+          pixelSize(colorSpace->pixelSize())
+    {
+    }
+
+    ChannelsInfo info;
+    int pixelSize;
+
+    KisPaintDeviceSP src;
+    KisPaintDeviceSP dst;
+
+    // premultiplied float pixels after the horizontal passes
+    KisDataManagerSP intermediate;
+
+    bool clampToDataRect {false};
+    QRect dataRect;
+
+    QVector<int> xHalfWidths;
+    QVector<int> yHalfWidths;
+    int xSupport {0};
+    int ySupport {0};
+};
+
+void readLine(const CascadeContext &ctx, int x, int y, int width,
+              quint8 *dst, QVector<quint8> &clampedLine)
+{
+    if (!ctx.clampToDataRect) {
+        ctx.src->readBytes(dst, x, y, width, 1);
+        return;
+    }
+
+    const QRect &rc = ctx.dataRect;
+    y = qBound(rc.top(), y, rc.bottom());
+
+    const int left = qBound(rc.left(), x, rc.right());
+    const int right = qBound(rc.left(), x + width - 1, rc.right());
+
+    if (left == x && right == x + width - 1) {
+        ctx.src->readBytes(dst, x, y, width, 1);
+        return;
+    }
+
+    const int pixelSize = ctx.pixelSize;
+    const int readWidth = right - left + 1;
+
+    clampedLine.resize(readWidth * pixelSize);
+    ctx.src->readBytes(clampedLine.data(), left, y, readWidth, 1);
+
+    for (int i = 0; i < width; i++) {
+        const int srcX = qBound(left, x + i, right) - left;
+        memcpy(dst + i * pixelSize, clampedLine.constData() + srcX * pixelSize, pixelSize);
+    }
+}
+
+void convertToFloat(const quint8 *src, float *dst, int numPixels,
+                    int pixelSize, const ChannelsInfo &info)
+{
+    const int numChannels = info.numChannels();
+
+    for (int i = 0; i < numPixels; i++) {
+        // no alpha is a rare case, so just multiply by 1.0 in that case
+        const qreal alphaValue = info.alphaRealPos >= 0 ?
+            info.toDoubleFuncPtr[info.alphaCachePos](src, info.alphaRealPos) : 1.0;
+
+        for (int k = 0; k < numChannels; k++) {
+            dst[k] = k != info.alphaCachePos ?
+                info.toDoubleFuncPtr[k](src, info.channelPos[k]) * alphaValue :
+                alphaValue;
+        }
+
+        src += pixelSize;
+        dst += numChannels;
+    }
+}
+
+void convertFromFloat(const float *src, quint8 *dst, int numPixels,
+                      int pixelSize, const ChannelsInfo &info)
+{
+    const int numChannels = info.numChannels();
+
+    for (int i = 0; i < numPixels; i++) {
+        if (info.alphaCachePos >= 0) {
+            const int a = info.alphaCachePos;
+
+            const qreal alphaValue = qBound(info.minClamp[a], qreal(src[a]), info.maxClamp[a]);
+
+            bool alphaIsNullInDstSpace = false;
+            info.fromDoubleCheckNullFuncPtr[a](dst, info.channelPos[a], alphaValue, &alphaIsNullInDstSpace);
+
+            if (!alphaIsNullInDstSpace &&
+                alphaValue > std::numeric_limits<qreal>::epsilon()) {
+
+                const qreal alphaValueInv = 1.0 / alphaValue;
+
+                for (int k = 0; k < numChannels; k++) {
+                    if (k == a) continue;
+
+                    const qreal value = qBound(info.minClamp[k], src[k] * alphaValueInv, info.maxClamp[k]);
+                    info.fromDoubleFuncPtr[k](dst, info.channelPos[k], value);
+                }
+            } else {
+                for (int k = 0; k < numChannels; k++) {
+                    if (k == a) continue;
+                    info.fromDoubleFuncPtr[k](dst, info.channelPos[k], 0.0);
+                }
+            }
+        } else {
+            for (int k = 0; k < numChannels; k++) {
+                const qreal value = qBound(info.minClamp[k], qreal(src[k]), info.maxClamp[k]);
+                info.fromDoubleFuncPtr[k](dst, info.channelPos[k], value);
+            }
+        }
+
+        src += numChannels;
+        dst += pixelSize;
+    }
+}
+
+/**
+ * Sliding window sum over a row of interleaved pixels. The source
+ * should contain numPixels + 2 * halfWidth valid pixels plus one padding
+ * pixel, which is read, but never used.
+ */
+inline void boxPassHorizontal(const float *src, float *dst,
+                              int numPixels, int numChannels,
+                              int halfWidth, double *acc)
+{
+    const int windowStride = (2 * halfWidth + 1) * numChannels;
+    const double norm = 1.0 / (2 * halfWidth + 1);
+
+    std::fill(acc, acc + numChannels, 0.0);
+
+    for (int i = 0; i < windowStride; i += numChannels) {
+        for (int c = 0; c < numChannels; c++) {
+            acc[c] += src[i + c];
+        }
+    }
+
+    for (int x = 0; x < numPixels; x++) {
+        for (int c = 0; c < numChannels; c++) {
+            dst[c] = acc[c] * norm;
+            acc[c] += src[windowStride + c] - src[c];
+        }
+
+        src += numChannels;
+        dst += numChannels;
+    }
+}
+
+/**
+ * Sliding window sum over the columns of a band, which is fed row by
+ * row. Only the rows of the current window are stored, so the memory
+ * doesn't depend on the height of the processed area. All the inner
+ * loops run over contiguous rows, so the compiler can vectorize them.
+ */
+class VerticalBoxPass
+{
+public:
+    VerticalBoxPass(int halfWidth, int rowStride)
+        : m_windowHeight(2 * halfWidth + 1),
+          m_rowStride(rowStride),
+          m_norm(1.0 / m_windowHeight),
+          m_window(m_windowHeight * rowStride),
+          m_acc(rowStride, 0.0)
+    {
+    }
+
+    /**
+     * Adds \p row to the window. When the window is full, writes
+     * the averaged row into \p dst and returns true.
+     */
+    bool addRow(const float *row, float *dst)
+    {
+        float *slot = m_window.data() + (m_numRows % m_windowHeight) * m_rowStride;
+        double *acc = m_acc.data();
+
+        if (m_numRows >= m_windowHeight) {
+            for (int i = 0; i < m_rowStride; i++) {
+                acc[i] += row[i] - slot[i];
+            }
+        } else {
+            for (int i = 0; i < m_rowStride; i++) {
+                acc[i] += row[i];
+            }
+        }
+
+        memcpy(slot, row, m_rowStride * sizeof(float));
+        m_numRows++;
+
+        if (m_numRows < m_windowHeight) return false;
+
+        for (int i = 0; i < m_rowStride; i++) {
+            dst[i] = acc[i] * m_norm;
+        }
+
+        return true;
+    }
+
+private:
+    int m_windowHeight;
+    int m_rowStride;
+    double m_norm;
+    int m_numRows {0};
+
+    QVector<float> m_window;
+    QVector<double> m_acc;
+};
+
+/**
+ * Runs the horizontal cascade over the rows of \p band and stores the
+ * result into the intermediate buffer. The band covers the whole width
+ * of the processed rect, so every source pixel is filtered only once.
+ */
+void processRowBand(const QRect &band, const CascadeContext &ctx)
+{
+    const int numChannels = ctx.info.numChannels();
+    const int pixelSize = ctx.pixelSize;
+
+    const int inputX = band.x() - ctx.xSupport;
+    const int inputWidth = band.width() + 2 * ctx.xSupport;
+    const int rowStride = band.width() * numChannels;
+
+    QVector<float> bandBuffer(rowStride * band.height());
+
+    QVector<quint8> rawLine(inputWidth * pixelSize);
+    QVector<quint8> clampedLine;
+
+    // the line buffers have one extra pixel of padding, see boxPassHorizontal()
+    QVector<float> line((inputWidth + 1) * numChannels);
+    QVector<float> lineTmp(line.size());
+    QVector<double> acc(numChannels);
+
+    for (int row = 0; row < band.height(); row++) {
+        readLine(ctx, inputX, band.y() + row, inputWidth,
+                 rawLine.data(), clampedLine);
+        convertToFloat(rawLine.constData(), line.data(), inputWidth,
+                       pixelSize, ctx.info);
+
+        float *src = line.data();
+        float *dst = lineTmp.data();
+        int numPixels = inputWidth;
+
+        Q_FOREACH (int halfWidth, ctx.xHalfWidths) {
+            numPixels -= 2 * halfWidth;
+            boxPassHorizontal(src, dst, numPixels, numChannels, halfWidth, acc.data());
+            std::swap(src, dst);
+        }
+
+        KIS_SAFE_ASSERT_RECOVER_NOOP(numPixels == band.width());
+        memcpy(bandBuffer.data() + row * rowStride, src, rowStride * sizeof(float));
+    }
+
+    ctx.intermediate->writeBytes(reinterpret_cast<const quint8*>(bandBuffer.constData()),
+                                 band.x(), band.y(), band.width(), band.height());
+}
+
+/**
+ * Runs the vertical cascade over the columns of \p band, reading the
+ * horizontally filtered rows from the intermediate buffer, and writes
+ * the result into the destination device. The rows stream through the
+ * passes, so the scratch memory depends on the width of the band and
+ * the support of the cascade only.
+ */
+void processColumnBand(const QRect &band, const CascadeContext &ctx)
+{
+    const int numChannels = ctx.info.numChannels();
+    const int pixelSize = ctx.pixelSize;
+
+    const int inputY = band.y() - ctx.ySupport;
+    const int inputHeight = band.height() + 2 * ctx.ySupport;
+    const int rowStride = band.width() * numChannels;
+
+    std::vector<VerticalBoxPass> passes;
+    Q_FOREACH (int halfWidth, ctx.yHalfWidths) {
+        passes.emplace_back(halfWidth, rowStride);
+    }
+
+    QVector<float> inputRows(rowStride * bandSize);
+    QVector<float> passRows[2] = {QVector<float>(rowStride), QVector<float>(rowStride)};
+    QVector<float> resultRows(rowStride * bandSize);
+    QVector<quint8> result(band.width() * bandSize * pixelSize);
+
+    int resultY = band.y();
+    int numResultRows = 0;
+
+    auto writeResultRows = [&] () {
+        const QRect rc(band.x(), resultY, band.width(), numResultRows);
+
+        // the channels disabled by channel flags should be kept unchanged
+        ctx.dst->readBytes(result.data(), rc);
+        convertFromFloat(resultRows.constData(), result.data(), rc.width() * rc.height(),
+                         pixelSize, ctx.info);
+        ctx.dst->writeBytes(result.constData(), rc);
+
+        resultY += numResultRows;
+        numResultRows = 0;
+    };
+
+    for (int y = inputY; y < inputY + inputHeight; y += bandSize) {
+        const int numRows = qMin(bandSize, inputY + inputHeight - y);
+
+        ctx.intermediate->readBytes(reinterpret_cast<quint8*>(inputRows.data()),
+                                    band.x(), y, band.width(), numRows);
+
+        for (int row = 0; row < numRows; row++) {
+            const float *src = inputRows.constData() + row * rowStride;
+            bool rowIsReady = true;
+
+            for (int i = 0; i < int(passes.size()); i++) {
+                float *dst = passRows[i & 0x1].data();
+
+                rowIsReady = passes[i].addRow(src, dst);
+                if (!rowIsReady) break;
+
+                src = dst;
+            }
+
+            if (!rowIsReady) continue;
+
+            memcpy(resultRows.data() + numResultRows * rowStride, src, rowStride * sizeof(float));
+            numResultRows++;
+
+            if (numResultRows == bandSize) {
+                writeResultRows();
+            }
+        }
+    }
+
+    if (numResultRows) {
+        writeResultRows();
+    }
+
+    KIS_SAFE_ASSERT_RECOVER_NOOP(resultY == band.y() + band.height());
+}
+
+/**
+ * Processes the bands in parallel. The bands are processed in waves
+ * to be able to report the progress from the calling thread, every
+ * pass reports a half of the total progress.
+ */
+template <typename Func>
+void processBands(const QVector<QRect> &bands, Func func,
+                  KoUpdater *progressUpdater, int progressBase)
+{
+    const int waveSize = qMax(1, 2 * QThread::idealThreadCount());
+
+    for (int i = 0; i < bands.size(); i += waveSize) {
+        QVector<QRect> wave = bands.mid(i, waveSize);
+        QtConcurrent::blockingMap(wave, func);
+
+        if (progressUpdater) {
+            progressUpdater->setProgress(progressBase + 50 * (i + wave.size()) / bands.size());
+        }
+    }
+}
+
+QVector<int> halfWidthsForRadius(qreal radius)
+{
+    QVector<int> result;
+
+    Q_FOREACH (int width, KisGaussianBoxCascadeWorker::boxWidthsForRadius(radius)) {
+        // a box of width 1 is an identity transform
+        if (width > 1) {
+            result.append(width / 2);
+        }
+    }
+
+    return result;
+}
+
+}
+
+QVector<int> KisGaussianBoxCascadeWorker::boxWidthsForRadius(qreal radius)
+{
+    QVector<int> widths;
+    if (radius <= 0.0) return widths;
+
+    /**
+     * The variance of a box of width w is (w^2 - 1) / 12, and the
+     * variances of the cascaded boxes sum up. We use boxes of two
+     * neighbouring odd widths and select the number of narrower
+     * boxes to match the variance of the Gaussian as close as
+     * possible (see W. Jarosz, "Fast Image Convolutions")
+     */
+    const qreal sigma = KisGaussianKernel::sigmaFromRadius(radius);
+    const qreal twelveVariance = 12.0 * pow2(sigma);
+
+    int lowerWidth = qFloor(std::sqrt(twelveVariance / numBoxes + 1.0));
+    if (!(lowerWidth & 0x1)) {
+        lowerWidth--;
+    }
+    lowerWidth = qMax(1, lowerWidth);
+    const int upperWidth = lowerWidth + 2;
+
+    const qreal idealNumLower =
+        (twelveVariance - numBoxes * pow2(lowerWidth) - 4 * numBoxes * lowerWidth - 3 * numBoxes) /
+        (-4 * lowerWidth - 4);
+
+    int numLower = qBound(0, qRound(idealNumLower), numBoxes);
+
+    /**
+     * The cascade should never reach farther than the exact kernel,
+     * otherwise needRect() of the filters will become invalid
+     */
+    const int maxSupport = KisGaussianKernel::kernelSizeFromRadius(radius) / 2;
+    while (numLower < numBoxes &&
+           numLower * (lowerWidth / 2) + (numBoxes - numLower) * (upperWidth / 2) > maxSupport) {
+
+        numLower++;
+    }
+
+    for (int i = 0; i < numBoxes; i++) {
+        widths.append(i < numLower ? lowerWidth : upperWidth);
+    }
+
+    return widths;
+}
+
+int KisGaussianBoxCascadeWorker::supportFromRadius(qreal radius)
+{
+    int support = 0;
+
+    Q_FOREACH (int width, boxWidthsForRadius(radius)) {
+        support += width / 2;
+    }
+
+    return support;
+}
+
+void KisGaussianBoxCascadeWorker::apply(KisPaintDeviceSP device,
+                                        const QRect &rect,
+                                        qreal xRadius, qreal yRadius,
+                                        const QBitArray &channelFlags,
+                                        KoUpdater *progressUpdater,
+                                        KisConvolutionBorderOp borderOp)
+{
+    if (rect.isEmpty()) return;
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!device->defaultBounds()->wrapAroundMode());
+
+    CascadeContext ctx(device->colorSpace(), channelFlags);
+    if (!ctx.info.numChannels()) return;
+
+    ctx.xHalfWidths = halfWidthsForRadius(xRadius);
+    ctx.yHalfWidths = halfWidthsForRadius(yRadius);
+    ctx.xSupport = std::accumulate(ctx.xHalfWidths.begin(), ctx.xHalfWidths.end(), 0);
+    ctx.ySupport = std::accumulate(ctx.yHalfWidths.begin(), ctx.yHalfWidths.end(), 0);
+
+    if (!ctx.xSupport && !ctx.ySupport) return;
+
+    if (borderOp == BORDER_REPEAT) {
+        // the same data rect as KisConvolutionPainter::applyMatrix() uses
+        const QRect boundsRect = device->defaultBounds()->bounds();
+        ctx.dataRect = rect | boundsRect;
+
+        KIS_SAFE_ASSERT_RECOVER(boundsRect != KisDefaultBounds().bounds()) {
+            ctx.dataRect = rect | device->exactBounds();
+        }
+
+        ctx.clampToDataRect = true;
+    }
+
+    /**
+     * The horizontal passes read the whole source area before the
+     * vertical passes write anything, so the device can be filtered
+     * in place without making a snapshot of it
+     */
+    ctx.src = device;
+    ctx.dst = device;
+
+    const QVector<quint8> defaultPixel(ctx.info.numChannels() * sizeof(float), 0);
+    ctx.intermediate = new KisDataManager(defaultPixel.size(), defaultPixel.constData());
+
+    const QRect rowsRect = rect.adjusted(0, -ctx.ySupport, 0, ctx.ySupport);
+
+    QVector<QRect> rowBands;
+    const int firstBandY = qFloor(qreal(rowsRect.top()) / bandSize) * bandSize;
+    for (int y = firstBandY; y <= rowsRect.bottom(); y += bandSize) {
+        rowBands.append(QRect(rowsRect.left(), y, rowsRect.width(), bandSize) & rowsRect);
+    }
+
+    QVector<QRect> columnBands;
+    const int firstBandX = qFloor(qreal(rect.left()) / bandSize) * bandSize;
+    for (int x = firstBandX; x <= rect.right(); x += bandSize) {
+        columnBands.append(QRect(x, rect.top(), bandSize, rect.height()) & rect);
+    }
+
+    if (progressUpdater) {
+        progressUpdater->setProgress(0);
+    }
+
+    processBands(rowBands,
+                 [&ctx] (const QRect &band) {
+                     processRowBand(band, ctx);
+                 },
+                 progressUpdater, 0);
+
+    processBands(columnBands,
+                 [&ctx] (const QRect &band) {
+                     processColumnBand(band, ctx);
+                 },
+                 progressUpdater, 50);
+}
@@ -0,0 +1,76 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISGAUSSIANBOXCASCADEWORKER_H
+#define KISGAUSSIANBOXCASCADEWORKER_H
+
+#include <QVector>
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+#include "kis_convolution_painter.h"
+
+class QRect;
+class QBitArray;
+class KoUpdater;
+
+/**
+ * Approximates a Gaussian blur by a cascade of three box filters
+ * (a sliding-window sum run three times in each direction). The cost
+ * of the filter per pixel does not depend on the radius, which makes
+ * it suitable for huge radii used by drop shadows and glows, where even
+ * the FFT convolution becomes too slow.
+ *
+ * The widths of the boxes are selected in a way that the variance
+ * of the cascade matches the variance of the Gaussian kernel created
+ * by KisGaussianKernel. The support of the cascade never exceeds the
+ * support of the Gaussian kernel, so needRect/changeRect of the callers
+ * stay valid.
+ *
+ * The filter runs in two parallel passes over the bands aligned to the
+ * tiles grid. The horizontal boxes are run over the horizontal bands
+ * spanning the whole width of the area, the rows are converted into
+ * premultiplied floating point values once and the result is stored
+ * into a tiled float buffer. Then the rows of the vertical bands of
+ * this buffer are streamed through the vertical boxes, so the scratch
+ * memory of every band doesn't depend on the size of the area.
+ *
+ * The worker doesn't support wrap-around mode, the caller should fall
+ * back to the exact kernel in this case.
+ */
+class KRITAIMAGE_EXPORT KisGaussianBoxCascadeWorker
+{
+public:
+    static const int numBoxes = 3;
+
+    /**
+     * The minimal radius, when KisGaussianKernel::Auto switches to
+     * the box cascade. The error of the approximation is not visible
+     * for radii of this size.
+     */
+    static const qreal autoMinRadius;
+
+    /**
+     * Returns the (odd) widths of the boxes approximating a Gaussian
+     * of radius \p radius. Returns an empty vector for a zero radius.
+     */
+    static QVector<int> boxWidthsForRadius(qreal radius);
+
+    /**
+     * Returns the distance the cascade of \p radius reaches from
+     * the central pixel
+     */
+    static int supportFromRadius(qreal radius);
+
+    static void apply(KisPaintDeviceSP device,
+                      const QRect &rect,
+                      qreal xRadius, qreal yRadius,
+                      const QBitArray &channelFlags,
+                      KoUpdater *progressUpdater,
+                      KisConvolutionBorderOp borderOp);
+};
+
+#endif // KISGAUSSIANBOXCASCADEWORKER_H
@@ -0,0 +1,238 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisUpdateWalkersSpatialIndex.h"
+
+#include <algorithm>
+#include "kis_assert.h"
+
+namespace {
+inline int divideFloor(int value, int divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+}
+
+KisUpdateWalkersSpatialIndex::KisUpdateWalkersSpatialIndex(const QSize &cellSize)
+    : m_cellSize(cellSize)
+{
+    KIS_SAFE_ASSERT_RECOVER_NOOP(!m_cellSize.isEmpty());
+}
+
+void KisUpdateWalkersSpatialIndex::setCellSize(const QSize &cellSize)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!cellSize.isEmpty());
+    if (cellSize == m_cellSize) return;
+
+    QVector<Entry> entries;
+    for (auto it = m_cells.constBegin(); it != m_cells.constEnd(); ++it) {
+        entries.append(it.value());
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [] (const Entry &lhs, const Entry &rhs) {
+                  return lhs.seqNo < rhs.seqNo;
+              });
+    entries.erase(std::unique(entries.begin(), entries.end(),
+                              [] (const Entry &lhs, const Entry &rhs) {
+                                  return lhs.seqNo == rhs.seqNo;
+                              }),
+                  entries.end());
+
+    m_cells.clear();
+    m_cellSize = cellSize;
+
+    Q_FOREACH (const Entry &entry, entries) {
+        auto recordIt = m_records.find(entry.walker.data());
+        KIS_SAFE_ASSERT_RECOVER(recordIt != m_records.end()) { continue; }
+
+        if (isIndexable(recordIt->rect)) {
+            insertEntry(entry, recordIt->rect);
+        } else {
+            m_records.erase(recordIt);
+        }
+    }
+}
+
+QSize KisUpdateWalkersSpatialIndex::cellSize() const
+{
+    return m_cellSize;
+}
+
+void KisUpdateWalkersSpatialIndex::addWalker(KisBaseRectsWalkerSP walker)
+{
+    const QRect rect = walker->requestedRect();
+    if (!isIndexable(rect)) return;
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!m_records.contains(walker.data()));
+
+    Entry entry;
+    entry.seqNo = m_nextSeqNo++;
+    entry.walker = walker;
+
+    Record record;
+    record.seqNo = entry.seqNo;
+    record.rect = rect;
+
+    m_records.insert(walker.data(), record);
+    insertEntry(entry, rect);
+}
+
+void KisUpdateWalkersSpatialIndex::removeWalker(KisBaseRectsWalkerSP walker)
+{
+    auto it = m_records.find(walker.data());
+    if (it == m_records.end()) return;
+
+    removeEntry(walker.data(), it->rect);
+    m_records.erase(it);
+}
+
+void KisUpdateWalkersSpatialIndex::updateWalker(KisBaseRectsWalkerSP walker)
+{
+    auto it = m_records.find(walker.data());
+    const QRect newRect = walker->requestedRect();
+
+    if (it == m_records.end()) {
+        /**
+         * The walker can't become smaller in the queue, so it
+         * cannot suddenly become indexable
+         */
+        KIS_SAFE_ASSERT_RECOVER_NOOP(!isIndexable(newRect));
+        return;
+    }
+
+    if (it->rect == newRect) return;
+
+    Entry entry;
+    entry.seqNo = it->seqNo;
+    entry.walker = walker;
+
+    removeEntry(walker.data(), it->rect);
+
+    if (isIndexable(newRect)) {
+        it->rect = newRect;
+        insertEntry(entry, newRect);
+    } else {
+        m_records.erase(it);
+    }
+}
+
+QVector<KisBaseRectsWalkerSP> KisUpdateWalkersSpatialIndex::mergeCandidates(const QRect &rect) const
+{
+    QVector<KisBaseRectsWalkerSP> result;
+    if (!isIndexable(rect)) return result;
+
+    const QRect searchRect =
+        rect.adjusted(-m_cellSize.width(), -m_cellSize.height(),
+                      m_cellSize.width(), m_cellSize.height());
+    const QRect cells = cellsForRect(searchRect);
+
+    QVector<Entry> entries;
+
+    for (int row = cells.top(); row <= cells.bottom(); row++) {
+        for (int col = cells.left(); col <= cells.right(); col++) {
+            auto it = m_cells.constFind(cellKey(col, row));
+            if (it == m_cells.constEnd()) continue;
+
+            Q_FOREACH (const Entry &entry, *it) {
+                const Record &record = m_records[entry.walker.data()];
+
+                // a walker may be present in up to four cells
+                if (record.rect.intersects(searchRect)) {
+                    entries.append(entry);
+                }
+            }
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [] (const Entry &lhs, const Entry &rhs) {
+                  return lhs.seqNo < rhs.seqNo;
+              });
+
+    quint64 lastSeqNo = 0;
+    bool isFirst = true;
+
+    Q_FOREACH (const Entry &entry, entries) {
+        if (!isFirst && entry.seqNo == lastSeqNo) continue;
+
+        result.append(entry.walker);
+        lastSeqNo = entry.seqNo;
+        isFirst = false;
+    }
+
+    return result;
+}
+
+void KisUpdateWalkersSpatialIndex::clear()
+{
+    m_cells.clear();
+    m_records.clear();
+}
+
+bool KisUpdateWalkersSpatialIndex::isEmpty() const
+{
+    return m_records.isEmpty();
+}
+
+bool KisUpdateWalkersSpatialIndex::isIndexable(const QRect &rc) const
+{
+    return !rc.isEmpty() &&
+        rc.width() <= m_cellSize.width() &&
+        rc.height() <= m_cellSize.height();
+}
+
+QRect KisUpdateWalkersSpatialIndex::cellsForRect(const QRect &rc) const
+{
+    const int firstCol = divideFloor(rc.left(), m_cellSize.width());
+    const int lastCol = divideFloor(rc.right(), m_cellSize.width());
+    const int firstRow = divideFloor(rc.top(), m_cellSize.height());
+    const int lastRow = divideFloor(rc.bottom(), m_cellSize.height());
+
+    return QRect(QPoint(firstCol, firstRow), QPoint(lastCol, lastRow));
+}
+
+quint64 KisUpdateWalkersSpatialIndex::cellKey(int col, int row)
+{
+    return (quint64(quint32(row)) << 32) | quint64(quint32(col));
+}
+
+void KisUpdateWalkersSpatialIndex::insertEntry(const Entry &entry, const QRect &rect)
+{
+    const QRect cells = cellsForRect(rect);
+
+    for (int row = cells.top(); row <= cells.bottom(); row++) {
+        for (int col = cells.left(); col <= cells.right(); col++) {
+            m_cells[cellKey(col, row)].append(entry);
+        }
+    }
+}
+
+void KisUpdateWalkersSpatialIndex::removeEntry(KisBaseRectsWalker *walker, const QRect &rect)
+{
+    const QRect cells = cellsForRect(rect);
+
+    for (int row = cells.top(); row <= cells.bottom(); row++) {
+        for (int col = cells.left(); col <= cells.right(); col++) {
+            auto it = m_cells.find(cellKey(col, row));
+            KIS_SAFE_ASSERT_RECOVER(it != m_cells.end()) { continue; }
+
+            QVector<Entry> &bucket = *it;
+
+            auto entryIt = std::find_if(bucket.begin(), bucket.end(),
+                                        [walker] (const Entry &entry) {
+                                            return entry.walker.data() == walker;
+                                        });
+            KIS_SAFE_ASSERT_RECOVER(entryIt != bucket.end()) { continue; }
+
+            bucket.erase(entryIt);
+
+            if (bucket.isEmpty()) {
+                m_cells.erase(it);
+            }
+        }
+    }
+}
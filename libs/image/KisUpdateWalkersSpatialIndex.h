@@ -0,0 +1,103 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISUPDATEWALKERSSPATIALINDEX_H
+#define KISUPDATEWALKERSSPATIALINDEX_H
+
+#include <QHash>
+#include <QRect>
+#include <QSize>
+#include <QVector>
+
+#include "kritaimage_export.h"
+#include "kis_base_rects_walker.h"
+
+/**
+ * A uniform grid index of the walkers pending in KisSimpleUpdateQueue
+ *
+ * The queue can merge two walkers only if the united requested rect
+ * fits into one update patch. It means that a walker can be merged only
+ * with the walkers located not farther than one patch away from it. The
+ * index splits the plane into the cells of the patch size and keeps
+ * a bucket of walkers for every cell, so searching for the merge candidates
+ * costs O(1) instead of scanning the whole list of the pending walkers.
+ *
+ * The walkers whose requested rect is bigger than the patch are never
+ * added to the index, since they cannot be merged with anything.
+ *
+ * Every walker is assigned a sequential number when added, so the
+ * candidates can be returned in the same order as the walkers are stored
+ * in the queue's list.
+ */
+class KRITAIMAGE_EXPORT KisUpdateWalkersSpatialIndex
+{
+public:
+    KisUpdateWalkersSpatialIndex(const QSize &cellSize = QSize(512, 512));
+
+    /**
+     * Resets the size of the grid cells. All the walkers present in the
+     * index are redistributed into the new cells.
+     */
+    void setCellSize(const QSize &cellSize);
+    QSize cellSize() const;
+
+    /**
+     * Adds \p walker to the index. The walker is indexed by its current
+     * requestedRect(). The walkers should be added in the same order as
+     * they are added to the queue.
+     */
+    void addWalker(KisBaseRectsWalkerSP walker);
+
+    /**
+     * Removes \p walker from the index. It is safe to call the function
+     * for the walkers that are not present in the index.
+     */
+    void removeWalker(KisBaseRectsWalkerSP walker);
+
+    /**
+     * Should be called when requestedRect() of \p walker has changed.
+     * The walker keeps its position in the ordering.
+     */
+    void updateWalker(KisBaseRectsWalkerSP walker);
+
+    /**
+     * Returns all the indexed walkers that can potentially be merged
+     * with \p rect, that is, all the walkers lying not farther than
+     * one cell away from it. The walkers are sorted in the order of
+     * their addition to the index.
+     */
+    QVector<KisBaseRectsWalkerSP> mergeCandidates(const QRect &rect) const;
+
+    void clear();
+
+    bool isEmpty() const;
+
+private:
+    struct Record {
+        quint64 seqNo = 0;
+        QRect rect;
+    };
+
+    struct Entry {
+        quint64 seqNo = 0;
+        KisBaseRectsWalkerSP walker;
+    };
+
+    bool isIndexable(const QRect &rc) const;
+    QRect cellsForRect(const QRect &rc) const;
+    static quint64 cellKey(int col, int row);
+
+    void insertEntry(const Entry &entry, const QRect &rect);
+    void removeEntry(KisBaseRectsWalker *walker, const QRect &rect);
+
+private:
+    QSize m_cellSize;
+    quint64 m_nextSeqNo = 0;
+    QHash<quint64, QVector<Entry>> m_cells;
+    QHash<KisBaseRectsWalker*, Record> m_records;
+};
+
+#endif // KISUPDATEWALKERSSPATIALINDEX_H
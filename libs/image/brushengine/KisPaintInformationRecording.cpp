@@ -0,0 +1,198 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisPaintInformationRecording.h"
+
+#include <QDataStream>
+#include <QFile>
+
+#include "kis_debug.h"
+
+namespace {
+const quint32 recordingMagic = 0x4b504952; // "KPIR"
+const quint16 recordingVersion = 1;
+
+enum SampleFlags {
+    CanvasMirroredH = 0x1,
+    CanvasMirroredV = 0x2
+};
+
+void writeSample(QDataStream &stream, const KisPaintInformation &pi)
+{
+    stream << float(pi.pos().x()) << float(pi.pos().y())
+           << float(pi.pressure())
+           << float(pi.xTilt()) << float(pi.yTilt())
+           << float(pi.rotation())
+           << float(pi.tangentialPressure())
+           << float(pi.perspective())
+           << float(pi.currentTime())
+           << float(pi.drawingSpeed())
+           << float(pi.canvasRotation());
+
+    quint8 flags = 0;
+    if (pi.canvasMirroredH()) flags |= CanvasMirroredH;
+    if (pi.canvasMirroredV()) flags |= CanvasMirroredV;
+    stream << flags;
+}
+
+KisPaintInformation readSample(QDataStream &stream)
+{
+    float x, y, pressure, xTilt, yTilt, rotation,
+        tangentialPressure, perspective, time, speed, canvasRotation;
+    quint8 flags;
+
+    stream >> x >> y >> pressure >> xTilt >> yTilt >> rotation
+           >> tangentialPressure >> perspective >> time >> speed
+           >> canvasRotation >> flags;
+
+    KisPaintInformation pi(QPointF(x, y), pressure, xTilt, yTilt, rotation,
+                           tangentialPressure, perspective, time, speed);
+    pi.setCanvasRotation(canvasRotation);
+    pi.setCanvasMirroredH(flags & CanvasMirroredH);
+    pi.setCanvasMirroredV(flags & CanvasMirroredV);
+
+    return pi;
+}
+}
+
+KisPaintInformationRecording::KisPaintInformationRecording()
+{
+}
+
+KisPaintInformationRecording::~KisPaintInformationRecording()
+{
+}
+
+void KisPaintInformationRecording::setCanvasSize(const QSize &size)
+{
+    m_canvasSize = size;
+}
+
+QSize KisPaintInformationRecording::canvasSize() const
+{
+    return m_canvasSize;
+}
+
+void KisPaintInformationRecording::addStroke(const Stroke &stroke)
+{
+    if (stroke.isEmpty()) return;
+    m_strokes.append(stroke);
+}
+
+const QVector<KisPaintInformationRecording::Stroke> &KisPaintInformationRecording::strokes() const
+{
+    return m_strokes;
+}
+
+int KisPaintInformationRecording::numSamples() const
+{
+    int result = 0;
+    Q_FOREACH (const Stroke &stroke, m_strokes) {
+        result += stroke.size();
+    }
+    return result;
+}
+
+bool KisPaintInformationRecording::isEmpty() const
+{
+    return m_strokes.isEmpty();
+}
+
+void KisPaintInformationRecording::clear()
+{
+    m_strokes.clear();
+}
+
+bool KisPaintInformationRecording::write(QIODevice *device) const
+{
+    QDataStream stream(device);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    stream << recordingMagic << recordingVersion;
+    stream << qint32(m_canvasSize.width()) << qint32(m_canvasSize.height());
+    stream << quint32(m_strokes.size());
+
+    Q_FOREACH (const Stroke &stroke, m_strokes) {
+        stream << quint32(stroke.size());
+
+        Q_FOREACH (const KisPaintInformation &pi, stroke) {
+            writeSample(stream, pi);
+        }
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+bool KisPaintInformationRecording::read(QIODevice *device)
+{
+    QDataStream stream(device);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+
+    if (magic != recordingMagic || version != recordingVersion) {
+        warnKrita << "KisPaintInformationRecording: unsupported recording format" << ppVar(magic) << ppVar(version);
+        return false;
+    }
+
+    qint32 width = 0;
+    qint32 height = 0;
+    quint32 numStrokes = 0;
+    stream >> width >> height >> numStrokes;
+
+    QVector<Stroke> strokes;
+
+    for (quint32 i = 0; i < numStrokes && stream.status() == QDataStream::Ok; i++) {
+        quint32 numSamples = 0;
+        stream >> numSamples;
+
+        Stroke stroke;
+
+        for (quint32 j = 0; j < numSamples && stream.status() == QDataStream::Ok; j++) {
+            stroke.append(readSample(stream));
+        }
+
+        strokes.append(stroke);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        warnKrita << "KisPaintInformationRecording: the recording is truncated";
+        return false;
+    }
+
+    m_canvasSize = QSize(width, height);
+    m_strokes = strokes;
+
+    return true;
+}
+
+bool KisPaintInformationRecording::save(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        warnKrita << "KisPaintInformationRecording: couldn't open file for writing" << fileName;
+        return false;
+    }
+
+    return write(&file);
+}
+
+bool KisPaintInformationRecording::load(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        warnKrita << "KisPaintInformationRecording: couldn't open file for reading" << fileName;
+        return false;
+    }
+
+    return read(&file);
+}
@@ -0,0 +1,66 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISPAINTINFORMATIONRECORDING_H
+#define KISPAINTINFORMATIONRECORDING_H
+
+#include <QSize>
+#include <QVector>
+
+#include "kritaimage_export.h"
+#include "kis_paint_information.h"
+
+class QIODevice;
+
+/**
+ * A recording of the paint information of real strokes, used for
+ * replaying production-like input in the stroke benchmarks.
+ *
+ * The recording is stored in a compact binary form: a header with
+ * the magic, the version and the size of the canvas the strokes were
+ * recorded on, followed by the strokes. Every sample is stored as
+ * a set of single precision floats (position, pressure, tilt, rotation,
+ * tangential pressure, perspective, time, speed and canvas rotation)
+ * and a byte of the canvas mirroring flags.
+ *
+ * KisToolFreehandHelper records every stroke into a separate file when
+ * KRITA_RECORD_STROKES_DIR environment variable points to a directory.
+ */
+class KRITAIMAGE_EXPORT KisPaintInformationRecording
+{
+public:
+    using Stroke = QVector<KisPaintInformation>;
+
+public:
+    KisPaintInformationRecording();
+    ~KisPaintInformationRecording();
+
+    void setCanvasSize(const QSize &size);
+    QSize canvasSize() const;
+
+    void addStroke(const Stroke &stroke);
+    const QVector<Stroke>& strokes() const;
+
+    /**
+     * The total number of samples in all the strokes
+     */
+    int numSamples() const;
+
+    bool isEmpty() const;
+    void clear();
+
+    bool write(QIODevice *device) const;
+    bool read(QIODevice *device);
+
+    bool save(const QString &fileName) const;
+    bool load(const QString &fileName);
+
+private:
+    QSize m_canvasSize;
+    QVector<Stroke> m_strokes;
+};
+
+#endif // KISPAINTINFORMATIONRECORDING_H
@@ -95,6 +95,11 @@ std::pair<int, bool> KisPaintOp::doAsyncronousUpdate(QVector<KisRunnableStrokeJo
     return std::make_pair(40, false);
 }
 
+bool KisPaintOp::hasPipelinedAsyncronousUpdates() const
+{
+    return false;
+}
+
 static void paintBezierCurve(KisPaintOp *paintOp,
                              const KisPaintInformation &pi1,
                              const KisVector2D &control1,
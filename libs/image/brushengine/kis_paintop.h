@@ -109,6 +109,18 @@ public:
      */
     virtual std::pair<int, bool> doAsyncronousUpdate(QVector<KisRunnableStrokeJobData*> &jobs);
 
+    /**
+     * Returns true if the jobs returned by doAsyncronousUpdate() are pipelined,
+     * that is, they are all concurrent and finish the update themselves. The dirty
+     * rects of such an update are added to the painter during one of the next calls
+     * to doAsyncronousUpdate(), when all the jobs of the update are completed. It lets
+     * the stroke issue the dirty signals without waiting for the jobs in flight.
+     *
+     * The paintop should report that some update jobs are still left while
+     * the pipelined jobs are in flight.
+     */
+    virtual bool hasPipelinedAsyncronousUpdates() const;
+
 protected:
     friend class KisPaintInformation;
     /**
@@ -9,6 +9,7 @@
 #include <KoAlwaysInline.h>
 
 #include <QStack>
+#include <QtConcurrent>
 #include <KoColor.h>
 #include <KoColorSpace.h>
 #include <KoCompositeOpRegistry.h>
@@ -17,17 +18,30 @@
 #include "kis_pixel_selection.h"
 #include "kis_random_accessor_ng.h"
 #include "kis_fill_sanity_checks.h"
+#include "kis_algebra_2d.h"
 #include <KisColorSelectionPolicies.h>
 
+/**
+ * NOTE: the copies of the pixel access and selection policies create
+ *       their own accessors, so that every thread of the parallel fill
+ *       could work with its own copy of the policy.
+ */
+
 class BasePixelAccessPolicy
 {
 public:
     using SourceAccessorType = KisRandomAccessorSP;
 
+    KisPaintDeviceSP m_sourceDevice;
     SourceAccessorType m_srcIt;
 
     BasePixelAccessPolicy(KisPaintDeviceSP sourceDevice)
-        : m_srcIt(sourceDevice->createRandomAccessorNG())
+        : m_sourceDevice(sourceDevice)
+        , m_srcIt(sourceDevice->createRandomAccessorNG())
+    {}
+
+    BasePixelAccessPolicy(const BasePixelAccessPolicy &rhs)
+        : BasePixelAccessPolicy(rhs.m_sourceDevice)
     {}
 };
 
@@ -36,10 +50,16 @@ class ConstBasePixelAccessPolicy
 public:
     using SourceAccessorType = KisRandomConstAccessorSP;
 
+    KisPaintDeviceSP m_sourceDevice;
     SourceAccessorType m_srcIt;
 
     ConstBasePixelAccessPolicy(KisPaintDeviceSP sourceDevice)
-        : m_srcIt(sourceDevice->createRandomConstAccessorNG())
+        : m_sourceDevice(sourceDevice)
+        , m_srcIt(sourceDevice->createRandomConstAccessorNG())
+    {}
+
+    ConstBasePixelAccessPolicy(const ConstBasePixelAccessPolicy &rhs)
+        : ConstBasePixelAccessPolicy(rhs.m_sourceDevice)
     {}
 };
 
@@ -52,6 +72,10 @@ public:
         , m_selectionIterator(m_pixelSelection->createRandomAccessorNG())
     {}
 
+    CopyToSelectionPixelAccessPolicy(const CopyToSelectionPixelAccessPolicy &rhs)
+        : CopyToSelectionPixelAccessPolicy(rhs.m_sourceDevice, rhs.m_pixelSelection)
+    {}
+
     ALWAYS_INLINE void fillPixel(quint8 *dstPtr, quint8 opacity, int x, int y)
     {
         Q_UNUSED(dstPtr);
@@ -74,6 +98,10 @@ public:
         , m_pixelSize(m_fillColor.colorSpace()->pixelSize())
     {}
 
+    FillWithColorPixelAccessPolicy(const FillWithColorPixelAccessPolicy &rhs)
+        : FillWithColorPixelAccessPolicy(rhs.m_sourceDevice, rhs.m_fillColor)
+    {}
+
     ALWAYS_INLINE void fillPixel(quint8 *dstPtr, quint8 opacity, int x, int y)
     {
         Q_UNUSED(x);
@@ -104,6 +132,10 @@ public:
         , m_pixelSize(m_fillColor.colorSpace()->pixelSize())
     {}
 
+    FillWithColorExternalPixelAccessPolicy(const FillWithColorExternalPixelAccessPolicy &rhs)
+        : FillWithColorExternalPixelAccessPolicy(rhs.m_sourceDevice, rhs.m_fillColor, rhs.m_externalDevice)
+    {}
+
     ALWAYS_INLINE void fillPixel(quint8 *dstPtr, quint8 opacity, int x, int y)
     {
         Q_UNUSED(dstPtr);
@@ -149,9 +181,14 @@ public:
     MaskedSelectionPolicy(BaseSelectionPolicy baseSelectionPolicy,
                           KisPaintDeviceSP maskDevice)
         : m_baseSelectionPolicy(baseSelectionPolicy)
+        , m_maskDevice(maskDevice)
         , m_maskIterator(maskDevice->createRandomConstAccessorNG())
     {}
 
+    MaskedSelectionPolicy(const MaskedSelectionPolicy &rhs)
+        : MaskedSelectionPolicy(rhs.m_baseSelectionPolicy, rhs.m_maskDevice)
+    {}
+
     ALWAYS_INLINE quint8 opacityFromDifference(quint8 difference, int x, int y)
     {
         m_maskIterator->moveTo(x, y);
@@ -166,6 +203,7 @@ public:
 
 private:
     BaseSelectionPolicy m_baseSelectionPolicy;
+    KisPaintDeviceSP m_maskDevice;
     KisRandomConstAccessorSP m_maskIterator;
 };
 
@@ -210,11 +248,16 @@ public:
                                 qint32 groupIndex)
         : BasePixelAccessPolicy(scribbleDevice)
         , m_groupIndex(groupIndex)
+        , m_groupMapDevice(groupMapDevice)
         , m_groupMapIt(groupMapDevice->createRandomAccessorNG())
     {
         KIS_SAFE_ASSERT_RECOVER_NOOP(m_groupIndex > 0);
     }
 
+    GroupSplitPixelAccessPolicy(const GroupSplitPixelAccessPolicy &rhs)
+        : GroupSplitPixelAccessPolicy(rhs.m_sourceDevice, rhs.m_groupMapDevice, rhs.m_groupIndex)
+    {}
+
     ALWAYS_INLINE void fillPixel(quint8 *dstPtr, quint8 opacity, int x, int y)
     {
         Q_UNUSED(opacity);
@@ -237,9 +280,154 @@ public:
 
 private:
     qint32 m_groupIndex;
+    KisPaintDeviceSP m_groupMapDevice;
     KisRandomAccessorSP m_groupMapIt;
 };
 
+namespace {
+
+/**
+ * The size of the blocks the parallel fill splits the bounding rect
+ * into. The value is a multiple of the tile size, so the blocks never
+ * write into the same tile concurrently.
+ */
+const int parallelFillBlockSize = 128;
+
+/**
+ * The parallel fill has some overhead for labeling and merging the
+ * blocks, so it is used for big bounding rects only
+ */
+const qint64 parallelFillMinArea = 512 * 512;
+
+/**
+ * A horizontal run of the pixels that should be filled. The label
+ * is a node of the union-find structure the run belongs to.
+ */
+struct FillRun {
+    int row = 0;
+    int start = 0;
+    int end = 0;
+    int label = -1;
+};
+
+struct FillBlock {
+    QRect rect;
+    bool isLabeled = false;
+    bool isQueued = false;
+    bool hasFilledRuns = false;
+
+    /**
+     * The runs are sorted by row and then by the start position.
+     * rowStarts[i] is the index of the first run of the i-th row
+     * of the block, the last element is the total number of runs.
+     */
+    QVector<FillRun> runs;
+    QVector<int> rowStarts;
+    int numComponents = 0;
+
+    const FillRun* rowBegin(int y) const {
+        return runs.constData() + rowStarts[y - rect.top()];
+    }
+
+    const FillRun* rowEnd(int y) const {
+        return runs.constData() + rowStarts[y - rect.top() + 1];
+    }
+};
+
+/**
+ * A record that some component of a labeled block touches a block
+ * that is not labeled yet. The block should be labeled as soon as
+ * the component gets connected to the seed.
+ */
+struct FillPendingEdge {
+    int label = -1;
+    int neighbourBlock = -1;
+};
+
+class FillUnionFind
+{
+public:
+    int addNodes(int count) {
+        const int base = m_parent.size();
+        m_parent.resize(base + count);
+        for (int i = base; i < base + count; i++) {
+            m_parent[i] = i;
+        }
+        return base;
+    }
+
+    int find(int node) {
+        while (m_parent[node] != node) {
+            m_parent[node] = m_parent[m_parent[node]];
+            node = m_parent[node];
+        }
+        return node;
+    }
+
+    void unite(int lhs, int rhs) {
+        lhs = find(lhs);
+        rhs = find(rhs);
+
+        if (lhs != rhs) {
+            m_parent[qMax(lhs, rhs)] = qMin(lhs, rhs);
+        }
+    }
+
+private:
+    QVector<int> m_parent;
+};
+
+/**
+ * Calls \p func for every pair of the overlapping runs of two
+ * adjacent rows
+ */
+template <typename Func>
+void forEachOverlappingRuns(const FillRun *lhs, const FillRun *lhsEnd,
+                            const FillRun *rhs, const FillRun *rhsEnd,
+                            Func func)
+{
+    while (lhs != lhsEnd && rhs != rhsEnd) {
+        if (lhs->start <= rhs->end && rhs->start <= lhs->end) {
+            func(lhs, rhs);
+        }
+
+        if (lhs->end < rhs->end) {
+            ++lhs;
+        } else {
+            ++rhs;
+        }
+    }
+}
+
+/**
+ * Calls \p func for every pixel of the row in range [start, end]
+ */
+template <typename AccessorType, typename Func>
+ALWAYS_INLINE void forEachPixelInRow(AccessorType &it, int pixelSize,
+                                     int row, int start, int end,
+                                     Func func)
+{
+    int numPixelsLeft = 0;
+    const quint8 *dataPtr = 0;
+
+    for (int x = start; x <= end; x++) {
+        // a bit of optimzation for not calling slow random accessor
+        // methods too often
+        if (numPixelsLeft <= 0) {
+            it->moveTo(x, row);
+            numPixelsLeft = it->numContiguousColumns(x) - 1;
+            dataPtr = it->rawDataConst();
+        } else {
+            numPixelsLeft--;
+            dataPtr += pixelSize;
+        }
+
+        func(x, dataPtr);
+    }
+}
+
+}
+
 struct Q_DECL_HIDDEN KisScanlineFill::Private
 {
     KisPaintDeviceSP device;
@@ -247,6 +435,7 @@ struct Q_DECL_HIDDEN KisScanlineFill::Private
     QRect boundingRect;
     int threshold;
     int opacitySpread;
+    bool parallelFillEnabled;
 
     int rowIncrement;
     KisFillIntervalMap backwardMap;
@@ -276,6 +465,7 @@ KisScanlineFill::KisScanlineFill(KisPaintDeviceSP device, const QPoint &startPoi
 
     m_d->threshold = 0;
     m_d->opacitySpread = 0;
+    m_d->parallelFillEnabled = true;
 }
 
 KisScanlineFill::~KisScanlineFill()
@@ -292,6 +482,11 @@ void KisScanlineFill::setOpacitySpread(int opacitySpread)
     m_d->opacitySpread = opacitySpread;
 }
 
+void KisScanlineFill::setParallelFillEnabled(bool value)
+{
+    m_d->parallelFillEnabled = value;
+}
+
 template <typename DifferencePolicy, typename SelectionPolicy, typename PixelAccessPolicy>
 void KisScanlineFill::extendedPass(KisFillInterval *currentInterval, int srcRow, bool extendRight,
                                    DifferencePolicy &differencePolicy,
@@ -461,6 +656,347 @@ void KisScanlineFill::runImpl(DifferencePolicy &differencePolicy,
     }
 }
 
+template <typename DifferencePolicy, typename SelectionPolicy, typename PixelAccessPolicy>
+bool KisScanlineFill::runParallelImpl(DifferencePolicy &differencePolicy,
+                                      SelectionPolicy &selectionPolicy,
+                                      PixelAccessPolicy &pixelAccessPolicy)
+{
+    const QRect &boundingRect = m_d->boundingRect;
+    const int pixelSize = m_d->device->pixelSize();
+
+    const int firstCol = KisAlgebra2D::divideFloor(boundingRect.left(), parallelFillBlockSize);
+    const int firstRow = KisAlgebra2D::divideFloor(boundingRect.top(), parallelFillBlockSize);
+    const int numCols = KisAlgebra2D::divideFloor(boundingRect.right(), parallelFillBlockSize) - firstCol + 1;
+    const int numRows = KisAlgebra2D::divideFloor(boundingRect.bottom(), parallelFillBlockSize) - firstRow + 1;
+
+    QVector<FillBlock> blocks(numCols * numRows);
+
+    for (int row = 0; row < numRows; row++) {
+        for (int col = 0; col < numCols; col++) {
+            const QRect blockRect((firstCol + col) * parallelFillBlockSize,
+                                  (firstRow + row) * parallelFillBlockSize,
+                                  parallelFillBlockSize, parallelFillBlockSize);
+
+            blocks[row * numCols + col].rect = blockRect & boundingRect;
+        }
+    }
+
+    /**
+     * 1) Finds the runs of the fillable pixels in the block and
+     *    splits them into the connected components. The blocks are
+     *    independent, so the function is called in parallel.
+     */
+    FillBlock *blocksData = blocks.data();
+
+    auto labelBlock = [&] (int index) {
+        FillBlock &block = blocksData[index];
+        const QRect &rc = block.rect;
+
+        DifferencePolicy dp(differencePolicy);
+        SelectionPolicy sp(selectionPolicy);
+        KisRandomConstAccessorSP srcIt = m_d->device->createRandomConstAccessorNG();
+
+        block.rowStarts.resize(rc.height() + 1);
+
+        for (int y = rc.top(); y <= rc.bottom(); y++) {
+            block.rowStarts[y - rc.top()] = block.runs.size();
+
+            FillRun run;
+            run.row = y;
+            bool hasOpenRun = false;
+
+            forEachPixelInRow(srcIt, pixelSize, y, rc.left(), rc.right(),
+                [&] (int x, const quint8 *pixelPtr) {
+                    const quint8 difference = dp.difference(pixelPtr);
+                    const quint8 opacity = sp.opacityFromDifference(difference, x, y);
+
+                    if (opacity) {
+                        if (!hasOpenRun) {
+                            run.start = x;
+                            hasOpenRun = true;
+                        }
+                        run.end = x;
+                    } else if (hasOpenRun) {
+                        block.runs.append(run);
+                        hasOpenRun = false;
+                    }
+                });
+
+            if (hasOpenRun) {
+                block.runs.append(run);
+            }
+        }
+        block.rowStarts[rc.height()] = block.runs.size();
+
+        FillUnionFind localComponents;
+        localComponents.addNodes(block.runs.size());
+
+        for (int y = rc.top(); y < rc.bottom(); y++) {
+            forEachOverlappingRuns(block.rowBegin(y), block.rowEnd(y),
+                                   block.rowBegin(y + 1), block.rowEnd(y + 1),
+                [&] (const FillRun *lhs, const FillRun *rhs) {
+                    localComponents.unite(lhs - block.runs.constData(),
+                                          rhs - block.runs.constData());
+                });
+        }
+
+        // the roots always precede the other nodes of the component
+        block.numComponents = 0;
+        for (int i = 0; i < block.runs.size(); i++) {
+            const int root = localComponents.find(i);
+            block.runs[i].label = root == i ? block.numComponents++ : block.runs[root].label;
+        }
+    };
+
+    FillUnionFind components;
+    QVector<FillPendingEdge> pendingEdges;
+
+    auto blockIndex = [numCols] (int col, int row) {
+        return row * numCols + col;
+    };
+
+    auto mergeHorizontalNeighbours = [&] (const FillBlock &left, const FillBlock &right) {
+        for (int y = left.rect.top(); y <= left.rect.bottom(); y++) {
+            if (left.rowBegin(y) == left.rowEnd(y) || right.rowBegin(y) == right.rowEnd(y)) continue;
+
+            const FillRun *leftRun = left.rowEnd(y) - 1;
+            const FillRun *rightRun = right.rowBegin(y);
+
+            if (leftRun->end == left.rect.right() && rightRun->start == right.rect.left()) {
+                components.unite(leftRun->label, rightRun->label);
+            }
+        }
+    };
+
+    auto mergeVerticalNeighbours = [&] (const FillBlock &top, const FillBlock &bottom) {
+        const int topY = top.rect.bottom();
+        const int bottomY = bottom.rect.top();
+
+        forEachOverlappingRuns(top.rowBegin(topY), top.rowEnd(topY),
+                               bottom.rowBegin(bottomY), bottom.rowEnd(bottomY),
+            [&] (const FillRun *lhs, const FillRun *rhs) {
+                components.unite(lhs->label, rhs->label);
+            });
+    };
+
+    auto addPendingEdges = [&] (const FillBlock &block, const FillRun *begin, const FillRun *end,
+                                int neighbourBlock, bool (*touchesEdge)(const FillRun&, const QRect&)) {
+        int lastLabel = -1;
+        for (const FillRun *run = begin; run != end; ++run) {
+            if (touchesEdge(*run, block.rect) && run->label != lastLabel) {
+                FillPendingEdge edge;
+                edge.label = run->label;
+                edge.neighbourBlock = neighbourBlock;
+                pendingEdges.append(edge);
+                lastLabel = run->label;
+            }
+        }
+    };
+
+    /**
+     * 2) Connects the runs of the freshly labeled block with the runs
+     *    of the neighbouring labeled blocks and records the components
+     *    that touch the blocks not labeled yet
+     */
+    auto connectBlock = [&] (int index) {
+        const FillBlock &block = blocks[index];
+        const int col = index % numCols;
+        const int row = index / numCols;
+
+        if (col > 0) {
+            const int neighbour = blockIndex(col - 1, row);
+            if (blocks[neighbour].isLabeled) {
+                mergeHorizontalNeighbours(blocks[neighbour], block);
+            } else {
+                for (int y = block.rect.top(); y <= block.rect.bottom(); y++) {
+                    addPendingEdges(block, block.rowBegin(y), qMin(block.rowBegin(y) + 1, block.rowEnd(y)), neighbour,
+                                    [] (const FillRun &run, const QRect &rc) { return run.start == rc.left(); });
+                }
+            }
+        }
+
+        if (col < numCols - 1) {
+            const int neighbour = blockIndex(col + 1, row);
+            if (blocks[neighbour].isLabeled) {
+                mergeHorizontalNeighbours(block, blocks[neighbour]);
+            } else {
+                for (int y = block.rect.top(); y <= block.rect.bottom(); y++) {
+                    addPendingEdges(block, qMax(block.rowEnd(y) - 1, block.rowBegin(y)), block.rowEnd(y), neighbour,
+                                    [] (const FillRun &run, const QRect &rc) { return run.end == rc.right(); });
+                }
+            }
+        }
+
+        if (row > 0) {
+            const int neighbour = blockIndex(col, row - 1);
+            if (blocks[neighbour].isLabeled) {
+                mergeVerticalNeighbours(blocks[neighbour], block);
+            } else {
+                addPendingEdges(block, block.rowBegin(block.rect.top()), block.rowEnd(block.rect.top()), neighbour,
+                                [] (const FillRun &, const QRect &) { return true; });
+            }
+        }
+
+        if (row < numRows - 1) {
+            const int neighbour = blockIndex(col, row + 1);
+            if (blocks[neighbour].isLabeled) {
+                mergeVerticalNeighbours(block, blocks[neighbour]);
+            } else {
+                addPendingEdges(block, block.rowBegin(block.rect.bottom()), block.rowEnd(block.rect.bottom()), neighbour,
+                                [] (const FillRun &, const QRect &) { return true; });
+            }
+        }
+    };
+
+    /**
+     * Only the blocks reachable from the seed are ever labeled. The blocks
+     * are processed in waves: every wave labels all the blocks touched
+     * by the seed component found so far.
+     */
+    const int seedBlock = blockIndex(KisAlgebra2D::divideFloor(m_d->startPoint.x(), parallelFillBlockSize) - firstCol,
+                                     KisAlgebra2D::divideFloor(m_d->startPoint.y(), parallelFillBlockSize) - firstRow);
+
+    QVector<int> frontier;
+    frontier << seedBlock;
+    blocks[seedBlock].isQueued = true;
+
+    int seedLabel = -1;
+
+    while (!frontier.isEmpty()) {
+        if (frontier.size() > 1) {
+            QtConcurrent::blockingMap(frontier, labelBlock);
+        } else {
+            labelBlock(frontier.first());
+        }
+
+        Q_FOREACH (int index, frontier) {
+            FillBlock &block = blocks[index];
+            const int base = components.addNodes(block.numComponents);
+
+            for (auto it = block.runs.begin(); it != block.runs.end(); ++it) {
+                it->label += base;
+            }
+
+            block.isLabeled = true;
+        }
+
+        if (seedLabel < 0) {
+            const FillBlock &block = blocks[seedBlock];
+            const int x = m_d->startPoint.x();
+            const int y = m_d->startPoint.y();
+
+            for (const FillRun *run = block.rowBegin(y); run != block.rowEnd(y); ++run) {
+                if (run->start <= x && x <= run->end) {
+                    seedLabel = run->label;
+                    break;
+                }
+            }
+
+            /**
+             * The seed pixel is not fillable, the sequential algorithm
+             * has its own handling for this case
+             */
+            if (seedLabel < 0) return false;
+        }
+
+        Q_FOREACH (int index, frontier) {
+            connectBlock(index);
+        }
+
+        frontier.clear();
+
+        const int seedRoot = components.find(seedLabel);
+
+        QVector<FillPendingEdge> stillPendingEdges;
+
+        Q_FOREACH (const FillPendingEdge &edge, pendingEdges) {
+            FillBlock &neighbour = blocks[edge.neighbourBlock];
+
+            if (neighbour.isLabeled) continue;
+
+            if (components.find(edge.label) == seedRoot) {
+                if (!neighbour.isQueued) {
+                    neighbour.isQueued = true;
+                    frontier << edge.neighbourBlock;
+                }
+            } else {
+                stillPendingEdges << edge;
+            }
+        }
+
+        pendingEdges.swap(stillPendingEdges);
+    }
+
+    /**
+     * 3) Fills the runs belonging to the seed component. The union-find
+     *    structure is not thread-safe, so the roots are resolved beforehand.
+     */
+    const int seedRoot = components.find(seedLabel);
+    QVector<int> filledBlocks;
+
+    for (int i = 0; i < blocks.size(); i++) {
+        FillBlock &block = blocks[i];
+        if (!block.isLabeled) continue;
+
+        for (auto it = block.runs.begin(); it != block.runs.end(); ++it) {
+            it->label = components.find(it->label);
+            block.hasFilledRuns |= it->label == seedRoot;
+        }
+
+        if (block.hasFilledRuns) {
+            filledBlocks << i;
+        }
+    }
+
+    auto fillBlock = [&] (int index) {
+        const FillBlock &block = blocksData[index];
+
+        DifferencePolicy dp(differencePolicy);
+        SelectionPolicy sp(selectionPolicy);
+        PixelAccessPolicy pap(pixelAccessPolicy);
+
+        Q_FOREACH (const FillRun &run, block.runs) {
+            if (run.label != seedRoot) continue;
+
+            forEachPixelInRow(pap.m_srcIt, pixelSize, run.row, run.start, run.end,
+                [&] (int x, const quint8 *dataPtr) {
+                    quint8 *pixelPtr = const_cast<quint8*>(dataPtr); // TODO: avoid doing const_cast
+                    const quint8 difference = dp.difference(pixelPtr);
+                    const quint8 opacity = sp.opacityFromDifference(difference, x, run.row);
+
+                    pap.fillPixel(pixelPtr, opacity, x, run.row);
+                });
+        }
+    };
+
+    if (filledBlocks.size() > 1) {
+        QtConcurrent::blockingMap(filledBlocks, fillBlock);
+    } else if (!filledBlocks.isEmpty()) {
+        fillBlock(filledBlocks.first());
+    }
+
+    return true;
+}
+
+template <typename DifferencePolicy, typename SelectionPolicy, typename PixelAccessPolicy>
+void KisScanlineFill::runFillImpl(DifferencePolicy &differencePolicy,
+                                  SelectionPolicy &selectionPolicy,
+                                  PixelAccessPolicy &pixelAccessPolicy)
+{
+    const QRect &rc = m_d->boundingRect;
+
+    if (m_d->parallelFillEnabled &&
+        rc.contains(m_d->startPoint) &&
+        qint64(rc.width()) * rc.height() >= parallelFillMinArea) {
+
+        if (runParallelImpl(differencePolicy, selectionPolicy, pixelAccessPolicy)) {
+            return;
+        }
+    }
+
+    runImpl(differencePolicy, selectionPolicy, pixelAccessPolicy);
+}
+
 template <template <typename SrcPixelType> typename OptimizedDifferencePolicy,
           typename SlowDifferencePolicy,
           typename SelectionPolicy, typename PixelAccessPolicy>
@@ -472,19 +1008,19 @@ void KisScanlineFill::selectDifferencePolicyAndRun(const KoColor &srcColor,
 
     if (pixelSize == 1) {
         OptimizedDifferencePolicy<quint8> dp(srcColor, m_d->threshold);
-        runImpl(dp, selectionPolicy, pixelAccessPolicy);
+        runFillImpl(dp, selectionPolicy, pixelAccessPolicy);
     } else if (pixelSize == 2) {
         OptimizedDifferencePolicy<quint16> dp(srcColor, m_d->threshold);
-        runImpl(dp, selectionPolicy, pixelAccessPolicy);
+        runFillImpl(dp, selectionPolicy, pixelAccessPolicy);
     } else if (pixelSize == 4) {
         OptimizedDifferencePolicy<quint32> dp(srcColor, m_d->threshold);
-        runImpl(dp, selectionPolicy, pixelAccessPolicy);
+        runFillImpl(dp, selectionPolicy, pixelAccessPolicy);
     } else if (pixelSize == 8) {
         OptimizedDifferencePolicy<quint64> dp(srcColor, m_d->threshold);
-        runImpl(dp, selectionPolicy, pixelAccessPolicy);
+        runFillImpl(dp, selectionPolicy, pixelAccessPolicy);
     } else {
         SlowDifferencePolicy dp(srcColor, m_d->threshold);
-        runImpl(dp, selectionPolicy, pixelAccessPolicy);
+        runFillImpl(dp, selectionPolicy, pixelAccessPolicy);
     }
 }
 
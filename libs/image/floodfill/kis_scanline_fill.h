@@ -122,6 +122,18 @@ public:
      */
     void setOpacitySpread(int opacitySpread);
 
+    /**
+     * Enables the parallel version of the fill algorithm for big bounding
+     * rects (enabled by default). The bounding rect is split into the
+     * tile-aligned blocks, which are labeled in parallel, and the labels
+     * are merged across the borders of the blocks. The result is exactly
+     * the same as the one of the sequential scanline algorithm.
+     *
+     * Used in all functions except clearNonZeroComponent() and
+     * fillContiguousGroup()
+     */
+    void setParallelFillEnabled(bool value);
+
 private:
     friend class KisScanlineFillTest;
     Q_DISABLE_COPY(KisScanlineFill)
@@ -143,6 +155,16 @@ private:
                  SelectionPolicy &selectionPolicy,
                  PixelAccessPolicy &pixelAccessPolicy);
 
+    template <typename DifferencePolicy, typename SelectionPolicy, typename PixelAccessPolicy>
+    bool runParallelImpl(DifferencePolicy &differencePolicy,
+                         SelectionPolicy &selectionPolicy,
+                         PixelAccessPolicy &pixelAccessPolicy);
+
+    template <typename DifferencePolicy, typename SelectionPolicy, typename PixelAccessPolicy>
+    void runFillImpl(DifferencePolicy &differencePolicy,
+                     SelectionPolicy &selectionPolicy,
+                     PixelAccessPolicy &pixelAccessPolicy);
+
     template <template <typename SrcPixelType> typename OptimizedDifferencePolicy,
               typename SlowDifferencePolicy,
               typename SelectionPolicy, typename PixelAccessPolicy>
@@ -18,6 +18,7 @@
 #include "krita_utils.h"
 
 #include <qnumeric.h>
+#include <QSharedPointer>
 
 struct Q_DECL_HIDDEN KisCageTransformWorker::Private
 {
@@ -49,12 +50,17 @@ struct Q_DECL_HIDDEN KisCageTransformWorker::Private
      */
     QVector<QPointF> allSrcPoints;
 
-    KisGreenCoordinatesMath cage;
+    /**
+     * The coordinates depend on the original cage and the grid
+     * only, so they can be shared between the workers (see
+     * reusePreparedTransform())
+     */
+    QSharedPointer<KisGreenCoordinatesMath> cage;
 
     QSize gridSize;
 
     bool isGridEmpty() const {
-        return allSrcPoints.isEmpty();
+        return allSrcPoints.isEmpty() || !cage;
     }
 
 
@@ -181,19 +187,41 @@ void KisCageTransformWorker::prepareTransform()
         KIS_ASSERT_RECOVER_NOOP(validIdx == m_d->validPoints.size());
     }
 
-    m_d->cage.precalculateGreenCoordinates(m_d->origCage, m_d->validPoints);
+    m_d->cage.reset(new KisGreenCoordinatesMath());
+    m_d->cage->precalculateGreenCoordinates(m_d->origCage, m_d->validPoints);
+}
+
+bool KisCageTransformWorker::reusePreparedTransform(const KisCageTransformWorker &rhs)
+{
+    if (!rhs.m_d->cage ||
+        m_d->srcBounds != rhs.m_d->srcBounds ||
+        m_d->pixelPrecision != rhs.m_d->pixelPrecision ||
+        m_d->origCage != rhs.m_d->origCage) {
+
+        return false;
+    }
+
+    /**
+     * All the containers are implicitly shared, so no data
+     * is actually copied here
+     */
+    m_d->gridSize = rhs.m_d->gridSize;
+    m_d->allSrcPoints = rhs.m_d->allSrcPoints;
+    m_d->allToValidPointsMap = rhs.m_d->allToValidPointsMap;
+    m_d->validPoints = rhs.m_d->validPoints;
+    m_d->cage = rhs.m_d->cage;
+
+    return true;
 }
 
 QVector<QPointF> KisCageTransformWorker::Private::calculateTransformedPoints()
 {
-    cage.generateTransformedCageNormals(transfCage);
+    QVector<QPointF> transformedPoints = cage->transformedPoints(transfCage);
 
     const int numValidPoints = validPoints.size();
-    QVector<QPointF> transformedPoints(numValidPoints);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(transformedPoints.size() == numValidPoints, validPoints);
 
     for (int i = 0; i < numValidPoints; i++) {
-        transformedPoints[i] = cage.transformedPoint(i, transfCage);
-
         if (qIsNaN(transformedPoints[i].x()) ||
             qIsNaN(transformedPoints[i].y())) {
             warnKrita << "WARNING: One grid point has been removed from consideration" << validPoints[i];
@@ -298,16 +326,14 @@ QRect KisCageTransformWorker::approxChangeRect(const QRect &rc)
 
     KisGreenCoordinatesMath cage;
     cage.precalculateGreenCoordinates(m_d->origCage, cageSamplePoints);
-    cage.generateTransformedCageNormals(m_d->transfCage);
 
     const int numValidPoints = cageSamplePoints.size();
-    QVector<QPointF> transformedPoints(numValidPoints);
+    QVector<QPointF> transformedPoints = cage.transformedPoints(m_d->transfCage);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(transformedPoints.size() == numValidPoints, rc);
 
     int failedPoints = 0;
 
     for (int i = 0; i < numValidPoints; i++) {
-        transformedPoints[i] = cage.transformedPoint(i, m_d->transfCage);
-
         if (qIsNaN(transformedPoints[i].x()) ||
             qIsNaN(transformedPoints[i].y())) {
 
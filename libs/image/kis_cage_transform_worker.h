@@ -30,6 +30,19 @@ public:
     ~KisCageTransformWorker();
 
     void prepareTransform();
+
+    /**
+     * Shares the grid and the Green coordinates prepared by \p rhs
+     * instead of calculating them in prepareTransform(). It is possible
+     * only when \p rhs has been prepared for the same original cage,
+     * the same source bounds and pixel precision; the function returns
+     * false otherwise.
+     *
+     * The coordinates don't depend on the transformed cage, so the
+     * preview can reuse them while the user drags the handles of the
+     * cage and only calculate the weighted sums.
+     */
+    bool reusePreparedTransform(const KisCageTransformWorker &rhs);
     void setTransformedCage(const QVector<QPointF> &transformedCage);
     void run(KisPaintDeviceSP srcDevice, KisPaintDeviceSP dstDevice);
 
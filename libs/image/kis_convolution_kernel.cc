@@ -70,6 +70,38 @@ const Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic>* KisConvolutionKernel
     return &(d->data);
 }
 
+bool KisConvolutionKernel::isSeparable(Eigen::Matrix<qreal, Eigen::Dynamic, 1> *column,
+                                       Eigen::Matrix<qreal, 1, Eigen::Dynamic> *row) const
+{
+    const Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> &m = d->data;
+    if (!m.size()) return false;
+
+    Eigen::Index pivotRow = 0;
+    Eigen::Index pivotCol = 0;
+    const qreal maxValue = m.cwiseAbs().maxCoeff(&pivotRow, &pivotCol);
+    if (maxValue == 0.0) return false;
+
+    /**
+     * If the kernel has rank 1, then every its row is a multiple of
+     * the row containing the biggest element
+     */
+    const Eigen::Matrix<qreal, Eigen::Dynamic, 1> c = m.col(pivotCol);
+    const Eigen::Matrix<qreal, 1, Eigen::Dynamic> r = m.row(pivotRow) / m(pivotRow, pivotCol);
+
+    const qreal error = (m - c * r).cwiseAbs().maxCoeff();
+    if (error > 1e-6 * maxValue) return false;
+
+    if (column) {
+        *column = c;
+    }
+
+    if (row) {
+        *row = r;
+    }
+
+    return true;
+}
+
 KisConvolutionKernelSP KisConvolutionKernel::fromQImage(const QImage& image)
 {
     KisConvolutionKernelSP kernel = new KisConvolutionKernel(image.width(), image.height(), 0, 0);
@@ -35,6 +35,16 @@ public:
     Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic>& data();
     const Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> * data() const;
 
+    /**
+     * Checks if the kernel has rank 1, that is, it can be represented
+     * as a product of a column and a row vector. Such kernels can be
+     * applied as two one-dimensional passes. If \p column and \p row
+     * are not null, they are filled with the factors, so that
+     * data() == (*column) * (*row).
+     */
+    bool isSeparable(Eigen::Matrix<qreal, Eigen::Dynamic, 1> *column = 0,
+                     Eigen::Matrix<qreal, 1, Eigen::Dynamic> *row = 0) const;
+
     static KisConvolutionKernelSP fromQImage(const QImage& image);
     static KisConvolutionKernelSP fromMaskGenerator(KisMaskGenerator *, qreal angle = 0.0);
     static KisConvolutionKernelSP fromMatrix(Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> matrix, qreal offset, qreal factor);
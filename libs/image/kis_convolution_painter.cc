@@ -39,6 +39,7 @@
 
 #include "kis_convolution_worker.h"
 #include "kis_convolution_worker_spatial.h"
+#include "kis_convolution_worker_separable.h"
 
 #include "config_convolution.h"
 
@@ -76,12 +77,17 @@ KisConvolutionWorker<factory>* KisConvolutionPainter::createWorker(const KisConv
 #ifdef HAVE_FFTW3
     if (useFFTImplementation(kernel)) {
         worker = new KisConvolutionWorkerFFT<factory>(painter, progress);
+    } else if (kernel->isSeparable()) {
+        worker = new KisConvolutionWorkerSeparable<factory>(painter, progress);
     } else {
         worker = new KisConvolutionWorkerSpatial<factory>(painter, progress);
     }
 #else
-    Q_UNUSED(kernel);
-    worker = new KisConvolutionWorkerSpatial<factory>(painter, progress);
+    if (kernel->isSeparable()) {
+        worker = new KisConvolutionWorkerSeparable<factory>(painter, progress);
+    } else {
+        worker = new KisConvolutionWorkerSpatial<factory>(painter, progress);
+    }
 #endif
 
     return worker;
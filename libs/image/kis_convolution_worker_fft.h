@@ -16,23 +16,203 @@
 #include "kis_math_toolbox.h"
 
 #include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
 #include <QVector>
 #include <QTextStream>
 #include <QFile>
 #include <QDir>
 
 #include <fftw3.h>
+#include <QtConcurrent>
+
+#include "config_convolution.h"
 
 template<class _IteratorFactory_> class KisConvolutionWorkerFFT;
+template<typename T> class KisFFTWPlanCache;
+
 class KisConvolutionWorkerFFTLock
 {
 private:
     static QMutex fftwMutex;
     template<class _IteratorFactory_> friend class KisConvolutionWorkerFFT;
+    template<typename T> friend class KisFFTWPlanCache;
 };
 
 QMutex KisConvolutionWorkerFFTLock::fftwMutex;
 
+/**
+ * A thin wrapper over the FFTW API of the specified precision. The
+ * single precision library (fftw3f) is optional, so the float version
+ * is available only when HAVE_FFTW3F is defined.
+ */
+template<typename T>
+struct KisFFTWTraits;
+
+template<>
+struct KisFFTWTraits<double>
+{
+    typedef double real_type;
+    typedef fftw_complex complex_type;
+    typedef fftw_plan plan_type;
+
+    static complex_type* allocate(size_t length) {
+        return (complex_type*)fftw_malloc(sizeof(complex_type) * length);
+    }
+
+    static void free(complex_type *ptr) {
+        fftw_free(ptr);
+    }
+
+    static plan_type createForwardPlan(int height, int width, complex_type *buffer) {
+        return fftw_plan_dft_r2c_2d(height, width, (real_type*)buffer, buffer, FFTW_ESTIMATE);
+    }
+
+    static plan_type createBackwardPlan(int height, int width, complex_type *buffer) {
+        return fftw_plan_dft_c2r_2d(height, width, buffer, (real_type*)buffer, FFTW_ESTIMATE);
+    }
+
+    static void destroyPlan(plan_type plan) {
+        fftw_destroy_plan(plan);
+    }
+
+    static void executeForward(plan_type plan, complex_type *buffer) {
+        fftw_execute_dft_r2c(plan, (real_type*)buffer, buffer);
+    }
+
+    static void executeBackward(plan_type plan, complex_type *buffer) {
+        fftw_execute_dft_c2r(plan, buffer, (real_type*)buffer);
+    }
+};
+
+#ifdef HAVE_FFTW3F
+template<>
+struct KisFFTWTraits<float>
+{
+    typedef float real_type;
+    typedef fftwf_complex complex_type;
+    typedef fftwf_plan plan_type;
+
+    static complex_type* allocate(size_t length) {
+        return (complex_type*)fftwf_malloc(sizeof(complex_type) * length);
+    }
+
+    static void free(complex_type *ptr) {
+        fftwf_free(ptr);
+    }
+
+    static plan_type createForwardPlan(int height, int width, complex_type *buffer) {
+        return fftwf_plan_dft_r2c_2d(height, width, (real_type*)buffer, buffer, FFTW_ESTIMATE);
+    }
+
+    static plan_type createBackwardPlan(int height, int width, complex_type *buffer) {
+        return fftwf_plan_dft_c2r_2d(height, width, buffer, (real_type*)buffer, FFTW_ESTIMATE);
+    }
+
+    static void destroyPlan(plan_type plan) {
+        fftwf_destroy_plan(plan);
+    }
+
+    static void executeForward(plan_type plan, complex_type *buffer) {
+        fftwf_execute_dft_r2c(plan, (real_type*)buffer, buffer);
+    }
+
+    static void executeBackward(plan_type plan, complex_type *buffer) {
+        fftwf_execute_dft_c2r(plan, buffer, (real_type*)buffer);
+    }
+};
+#endif
+
+/**
+ * FFTW planner is not thread-safe and the plan creation is not
+ * free even with FFTW_ESTIMATE. Since the filters are usually applied
+ * in patches of the same size (and the tiles of one convolution always
+ * have the same size), the plans are cached and reused.
+ *
+ * The plans are created for in-place transforms of the buffers
+ * allocated with fftw_malloc(), so they can be executed with the
+ * new-array execute functions on any such buffer of the same size.
+ * Execution of the plans is thread-safe.
+ */
+template<typename T>
+class KisFFTWPlanCache
+{
+    typedef KisFFTWTraits<T> Traits;
+    typedef typename Traits::plan_type plan_type;
+    typedef typename Traits::complex_type complex_type;
+
+public:
+    struct Plans {
+        Plans(int _height, int _width, complex_type *buffer)
+            : height(_height),
+              width(_width),
+              forward(Traits::createForwardPlan(height, width, buffer)),
+              backward(Traits::createBackwardPlan(height, width, buffer))
+        {
+        }
+
+        ~Plans() {
+            QMutexLocker l(&KisConvolutionWorkerFFTLock::fftwMutex);
+            Traits::destroyPlan(forward);
+            Traits::destroyPlan(backward);
+        }
+
+        const int height;
+        const int width;
+        const plan_type forward;
+        const plan_type backward;
+    };
+
+    typedef QSharedPointer<Plans> PlansSP;
+
+    /**
+     * \return the plans for the transforms of the specified size.
+     * \p buffer should be a buffer allocated with Traits::allocate(),
+     * it is not touched by the planner.
+     */
+    static PlansSP plans(int height, int width, complex_type *buffer) {
+        static KisFFTWPlanCache s_instance;
+        return s_instance.fetchPlans(height, width, buffer);
+    }
+
+private:
+    PlansSP fetchPlans(int height, int width, complex_type *buffer) {
+        PlansSP result;
+        QList<PlansSP> evictedPlans;
+
+        {
+            QMutexLocker l(&KisConvolutionWorkerFFTLock::fftwMutex);
+
+            for (auto it = m_plans.begin(); it != m_plans.end(); ++it) {
+                if ((*it)->height == height && (*it)->width == width) {
+                    result = *it;
+                    m_plans.erase(it);
+                    break;
+                }
+            }
+
+            if (!result) {
+                result.reset(new Plans(height, width, buffer));
+            }
+
+            m_plans.prepend(result);
+
+            while (m_plans.size() > maxCachedPlans) {
+                evictedPlans.append(m_plans.takeLast());
+            }
+        }
+
+        // the plans may be destroyed only after the mutex is released
+        evictedPlans.clear();
+
+        return result;
+    }
+
+private:
+    static const int maxCachedPlans = 8;
+    QList<PlansSP> m_plans;
+};
+
 
 template<class _IteratorFactory_>
 class KisConvolutionWorkerFFT : public KisConvolutionWorker<_IteratorFactory_>
@@ -69,92 +249,192 @@ public:
         addToProgress(0);
         if (isInterrupted()) return;
 
+        // find out which channels need convolving
+        QList<KoChannelInfo*> convChannelList = this->convolvableChannelList(src);
+
+#ifdef HAVE_FFTW3F
+        if (canUseSinglePrecision(convChannelList)) {
+            executeImpl<float>(kernel, src, srcPos, dstPos, areaSize, dataRect, convChannelList);
+            return;
+        }
+#endif
+
+        executeImpl<double>(kernel, src, srcPos, dstPos, areaSize, dataRect, convChannelList);
+    }
+
+private:
+    /**
+     * Single precision is enough for the integer channels of 8 and 16
+     * bits, its error stays below the quantization step. Floating point
+     * color spaces still use double precision.
+     */
+    static bool canUseSinglePrecision(const QList<KoChannelInfo*> &channels) {
+        Q_FOREACH (const KoChannelInfo *channel, channels) {
+            switch (channel->channelValueType()) {
+            case KoChannelInfo::UINT8:
+            case KoChannelInfo::UINT16:
+            case KoChannelInfo::INT8:
+            case KoChannelInfo::INT16:
+                break;
+            default:
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Big images are not transformed as a whole, instead they are split
+     * into tiles, which are convolved separately. Every tile reads its
+     * area grown by the kernel size, so the result is exactly the same
+     * as with one big transform (overlap-save), but the memory footprint
+     * of the complex buffers is limited by the tile size.
+     */
+    static int calculateTileSide(int areaSide, int margin) {
+        const int maxFFTSide = 2048;
+
+        if (areaSide + margin <= maxFFTSide) {
+            return areaSide;
+        }
+
+        // for huge kernels the overlap would dominate, so keep
+        // the useful part of the tile at least twice bigger
+        return qMin(areaSide, qMax(maxFFTSide - margin, 2 * margin));
+    }
+
+    template<typename T>
+    struct FFTContext {
+        typedef KisFFTWTraits<T> Traits;
+        typedef typename Traits::complex_type complex_type;
+
+        ~FFTContext() {
+            if (kernelFFT) {
+                Traits::free(kernelFFT);
+            }
+
+            Q_FOREACH (complex_type *channel, channelFFT) {
+                Traits::free(channel);
+            }
+        }
+
+        quint32 fftWidth {0};
+        quint32 fftHeight {0};
+        quint32 fftLength {0};
+        quint32 extraMem {0};
+
+        complex_type *kernelFFT {0};
+        QVector<complex_type*> channelFFT;
+        typename KisFFTWPlanCache<T>::PlansSP plans;
+
+        int cacheRowStride() const {
+            return fftWidth + extraMem;
+        }
+    };
+
+    template<typename T>
+    void executeImpl(const KisConvolutionKernelSP kernel,
+                     const KisPaintDeviceSP src,
+                     QPoint srcPos,
+                     QPoint dstPos,
+                     QSize areaSize,
+                     const QRect &dataRect,
+                     const QList<KoChannelInfo*> &convChannelList)
+    {
+        typedef KisFFTWTraits<T> Traits;
+        typedef typename Traits::complex_type complex_type;
+
         const quint32 halfKernelWidth = (kernel->width() - 1) / 2;
         const quint32 halfKernelHeight = (kernel->height() - 1) / 2;
 
-        m_fftWidth = areaSize.width() + 4 * halfKernelWidth;
-        m_fftHeight = areaSize.height() + 2 * halfKernelHeight;
+        const int tileWidth = calculateTileSide(areaSize.width(), 4 * halfKernelWidth);
+        const int tileHeight = calculateTileSide(areaSize.height(), 2 * halfKernelHeight);
+
+        FFTContext<T> ctx;
+
+        ctx.fftWidth = tileWidth + 4 * halfKernelWidth;
+        ctx.fftHeight = tileHeight + 2 * halfKernelHeight;
 
         /**
          * FIXME: check whether this "optimization" is needed to
          * be uncommented. My tests showed about 30% better performance
          * when the line is commented out (DK).
          */
-        //optimumDimensions(m_fftWidth, m_fftHeight);
+        //optimumDimensions(ctx.fftWidth, ctx.fftHeight);
 
-        m_fftLength = m_fftHeight * (m_fftWidth / 2 + 1);
-        m_extraMem = (m_fftWidth % 2) ? 1 : 2;
+        ctx.fftLength = ctx.fftHeight * (ctx.fftWidth / 2 + 1);
+        ctx.extraMem = (ctx.fftWidth % 2) ? 1 : 2;
 
         // create and fill kernel
-        m_kernelFFT = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * m_fftLength);
-        memset(m_kernelFFT, 0, sizeof(fftw_complex) * m_fftLength);
-        fftFillKernelMatrix(kernel, m_kernelFFT);
+        ctx.kernelFFT = Traits::allocate(ctx.fftLength);
+        memset(ctx.kernelFFT, 0, sizeof(complex_type) * ctx.fftLength);
+        fftFillKernelMatrix(kernel, ctx);
 
-        // find out which channels need convolving
-        QList<KoChannelInfo*> convChannelList = this->convolvableChannelList(src);
-
-        m_channelFFT.resize(convChannelList.count());
-        for (auto i = m_channelFFT.begin(); i != m_channelFFT.end(); ++i) {
-            *i = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * m_fftLength);
+        ctx.channelFFT.resize(convChannelList.count());
+        for (auto i = ctx.channelFFT.begin(); i != ctx.channelFFT.end(); ++i) {
+            *i = Traits::allocate(ctx.fftLength);
         }
 
+        ctx.plans = KisFFTWPlanCache<T>::plans(ctx.fftHeight, ctx.fftWidth, ctx.kernelFFT);
+
         const double kernelFactor = kernel->factor() ? kernel->factor() : 1;
-        const double fftScale = 1.0 / (m_fftHeight * m_fftWidth) / kernelFactor;
+        const double fftScale = 1.0 / (ctx.fftHeight * ctx.fftWidth) / kernelFactor;
 
         FFTInfo info (fftScale, convChannelList, kernel, this->m_painter->device()->colorSpace());
-        int cacheRowStride = m_fftWidth + m_extraMem;
 
-        fillCacheFromDevice(src,
-                            QRect(srcPos.x() - halfKernelWidth,
-                                  srcPos.y() - halfKernelHeight,
-                                  m_fftWidth,
-                                  m_fftHeight),
-                            cacheRowStride,
-                            info, dataRect);
+        Traits::executeForward(ctx.plans->forward, ctx.kernelFFT);
 
         addToProgress(10);
         if (isInterrupted()) return;
 
-        // calculate number off fft operations required for progress reporting
-        const float progressPerFFT = (100 - 30) / (double)(convChannelList.count() * 2 + 1);
+        const int numTilesX = (areaSize.width() + tileWidth - 1) / tileWidth;
+        const int numTilesY = (areaSize.height() + tileHeight - 1) / tileHeight;
+        const float progressPerTile = (100 - 10) / float(numTilesX * numTilesY);
 
-        // perform FFT
-        fftw_plan fftwPlanForward, fftwPlanBackward;
-
-        KisConvolutionWorkerFFTLock::fftwMutex.lock();
-        fftwPlanForward = fftw_plan_dft_r2c_2d(m_fftHeight, m_fftWidth, (double*)m_kernelFFT, m_kernelFFT, FFTW_ESTIMATE);
-        fftwPlanBackward = fftw_plan_dft_c2r_2d(m_fftHeight, m_fftWidth, m_kernelFFT, (double*)m_kernelFFT, FFTW_ESTIMATE);
-        KisConvolutionWorkerFFTLock::fftwMutex.unlock();
+        /**
+         * The channels are independent from each other, so they
+         * are transformed in parallel. The calling thread takes part
+         * in the work too.
+         */
+        auto convolveChannel =
+            [&ctx] (complex_type *channel) {
+                Traits::executeForward(ctx.plans->forward, channel);
+                fftMultiply(channel, ctx);
+                Traits::executeBackward(ctx.plans->backward, channel);
+            };
+
+        for (int tileY = 0; tileY < areaSize.height(); tileY += tileHeight) {
+            for (int tileX = 0; tileX < areaSize.width(); tileX += tileWidth) {
+                const QPoint tileOffset(tileX, tileY);
+                const QSize tileSize(qMin(tileWidth, areaSize.width() - tileX),
+                                     qMin(tileHeight, areaSize.height() - tileY));
+
+                fillCacheFromDevice(src,
+                                    QRect(srcPos.x() + tileX - halfKernelWidth,
+                                          srcPos.y() + tileY - halfKernelHeight,
+                                          ctx.fftWidth,
+                                          ctx.fftHeight),
+                                    ctx, info, dataRect);
+
+                if (isInterrupted()) return;
+
+                if (ctx.channelFFT.size() > 1) {
+                    QtConcurrent::blockingMap(ctx.channelFFT, convolveChannel);
+                } else {
+                    Q_FOREACH (complex_type *channel, ctx.channelFFT) {
+                        convolveChannel(channel);
+                    }
+                }
 
-        fftw_execute(fftwPlanForward);
-        addToProgress(progressPerFFT);
-        if (isInterrupted()) return;
+                if (isInterrupted()) return;
 
-        for (auto k = m_channelFFT.begin(); k != m_channelFFT.end(); ++k)
-        {
-            fftw_execute_dft_r2c(fftwPlanForward, (double*)(*k), *k);
-            addToProgress(progressPerFFT);
-            if (isInterrupted()) return;
+                writeResultToDevice(QRect(dstPos + tileOffset, tileSize),
+                                    halfKernelWidth, halfKernelHeight,
+                                    ctx, info, dataRect);
 
-            fftMultiply(*k, m_kernelFFT);
-
-            fftw_execute_dft_c2r(fftwPlanBackward, *k, (double*)*k);
-            addToProgress(progressPerFFT);
-            if (isInterrupted()) return;
+                addToProgress(progressPerTile);
+            }
         }
-
-        KisConvolutionWorkerFFTLock::fftwMutex.lock();
-        fftw_destroy_plan(fftwPlanForward);
-        fftw_destroy_plan(fftwPlanBackward);
-        KisConvolutionWorkerFFTLock::fftwMutex.unlock();
-
-
-        writeResultToDevice(QRect(dstPos.x(), dstPos.y(), areaSize.width(), areaSize.height()),
-                            cacheRowStride, halfKernelWidth, halfKernelHeight,
-                            info, dataRect);
-
-        addToProgress(20);
-        cleanUp();
     }
 
     struct FFTInfo {
@@ -209,9 +489,10 @@ public:
         int alphaRealPos {-1};
     };
 
+    template<typename T>
     void fillCacheFromDevice(KisPaintDeviceSP src,
                              const QRect &rect,
-                             const int cacheRowStride,
+                             const FFTContext<T> &ctx,
                              const FFTInfo &info,
                              const QRect &dataRect) {
 
@@ -220,23 +501,24 @@ public:
                                                         rect.x(), rect.y(), rect.width(),
                                                         dataRect);
 
+        const int cacheRowStride = ctx.cacheRowStride();
         const int channelCount = info.numChannels();
-        QVector<double*> channelPtr(channelCount);
+        QVector<T*> channelPtr(channelCount);
         const auto channelPtrBegin = channelPtr.begin();
         const auto channelPtrEnd = channelPtr.end();
 
-        auto iFFt = m_channelFFT.constBegin();
+        auto iFFt = ctx.channelFFT.constBegin();
         for (auto i = channelPtrBegin; i != channelPtrEnd; ++i, ++iFFt) {
-            *i = (double*)*iFFt;
+            *i = (T*)*iFFt;
         }
 
         // prepare cache, reused in all loops
-        QVector<double*> cacheRowStart(channelCount);
+        QVector<T*> cacheRowStart(channelCount);
         const auto cacheRowStartBegin = cacheRowStart.begin();
 
         for (int y = 0; y < rect.height(); ++y) {
             // cache current channelPtr in cacheRowStart
-            memcpy(cacheRowStart.data(), channelPtr.data(), channelCount * sizeof(double*));
+            memcpy(cacheRowStart.data(), channelPtr.data(), channelCount * sizeof(T*));
 
             for (int x = 0; x < rect.width(); ++x) {
                 const quint8 *data = hitSrc->oldRawData();
@@ -278,10 +560,11 @@ public:
         }
     }
 
+    template<typename T>
     inline qreal writeAlphaFromCache(quint8* dstPtr,
                                      const quint32 channel,
                                      const FFTInfo &info,
-                                     double* channelValuePtr,
+                                     T* channelValuePtr,
                                      bool *dstValueIsNull) {
         qreal channelPixelValue;
 
@@ -292,11 +575,11 @@ public:
         return channelPixelValue;
     }
 
-    template <bool additionalMultiplierActive>
+    template <bool additionalMultiplierActive, typename T>
     inline qreal writeOneChannelFromCache(quint8* dstPtr,
                                           const quint32 channel,
                                           const FFTInfo &info,
-                                          double* channelValuePtr,
+                                          T* channelValuePtr,
                                           const qreal additionalMultiplier = 0.0) {
         qreal channelPixelValue;
 
@@ -313,10 +596,11 @@ public:
         return channelPixelValue;
     }
 
+    template<typename T>
     void writeResultToDevice(const QRect &rect,
-                             const int cacheRowStride,
                              const int halfKernelWidth,
                              const int halfKernelHeight,
+                             const FFTContext<T> &ctx,
                              const FFTInfo &info,
                              const QRect &dataRect) {
 
@@ -325,25 +609,26 @@ public:
                                                    rect.x(), rect.y(), rect.width(),
                                                    dataRect);
 
+        const int cacheRowStride = ctx.cacheRowStride();
         int initialOffset = cacheRowStride * halfKernelHeight + halfKernelWidth;
 
         const int channelCount = info.numChannels();
-        QVector<double*> channelPtr(channelCount);
+        QVector<T*> channelPtr(channelCount);
         const auto channelPtrBegin = channelPtr.begin();
         const auto channelPtrEnd = channelPtr.end();
 
-        auto iFFt = m_channelFFT.constBegin();
+        auto iFFt = ctx.channelFFT.constBegin();
         for (auto i = channelPtrBegin; i != channelPtrEnd; ++i, ++iFFt) {
-            *i = (double*)*iFFt + initialOffset;
+            *i = (T*)*iFFt + initialOffset;
         }
 
         // prepare cache, reused in all loops
-        QVector<double*> cacheRowStart(channelCount);
+        QVector<T*> cacheRowStart(channelCount);
         const auto cacheRowStartBegin = cacheRowStart.begin();
 
         for (int y = 0; y < rect.height(); ++y) {
             // cache current channelPtr in cacheRowStart
-            memcpy(cacheRowStart.data(), channelPtr.data(), channelCount * sizeof(double*));
+            memcpy(cacheRowStart.data(), channelPtr.data(), channelCount * sizeof(T*));
 
             for (int x = 0; x < rect.width(); ++x) {
                 quint8 *dstPtr = hitDst->rawData();
@@ -410,42 +695,46 @@ public:
     }
 
 private:
-    void fftFillKernelMatrix(const KisConvolutionKernelSP kernel, fftw_complex *m_kernelFFT)
+    template<typename T>
+    void fftFillKernelMatrix(const KisConvolutionKernelSP kernel, FFTContext<T> &ctx)
     {
         // find central item
         QPoint offset((kernel->width() - 1) / 2, (kernel->height() - 1) / 2);
 
-        qint32 xShift = m_fftWidth - offset.x();
-        qint32 yShift = m_fftHeight - offset.y();
+        qint32 xShift = ctx.fftWidth - offset.x();
+        qint32 yShift = ctx.fftHeight - offset.y();
 
         quint32 absXpos, absYpos;
 
         for (quint32 y = 0; y < kernel->height(); y++)
         {
             absYpos = y + yShift;
-            if (absYpos >= m_fftHeight)
-                absYpos -= m_fftHeight;
+            if (absYpos >= ctx.fftHeight)
+                absYpos -= ctx.fftHeight;
 
             for (quint32 x = 0; x < kernel->width(); x++)
             {
                 absXpos = x + xShift;
-                if (absXpos >= m_fftWidth)
-                    absXpos -= m_fftWidth;
+                if (absXpos >= ctx.fftWidth)
+                    absXpos -= ctx.fftWidth;
 
-                ((double*)m_kernelFFT)[(m_fftWidth + m_extraMem) * absYpos + absXpos] = kernel->data()->coeff(y, x);
+                ((T*)ctx.kernelFFT)[ctx.cacheRowStride() * absYpos + absXpos] = kernel->data()->coeff(y, x);
             }
         }
     }
 
-    void fftMultiply(fftw_complex* channel, fftw_complex* kernel)
+    template<typename T>
+    static void fftMultiply(typename KisFFTWTraits<T>::complex_type* channel, const FFTContext<T> &ctx)
     {
+        typedef typename KisFFTWTraits<T>::complex_type complex_type;
+
         // perform complex multiplication
-        fftw_complex *channelPtr = channel;
-        fftw_complex *kernelPtr = kernel;
+        complex_type *channelPtr = channel;
+        const complex_type *kernelPtr = ctx.kernelFFT;
 
-        fftw_complex tmp;
+        T tmp[2];
 
-        for (quint32 pixelPos = 0; pixelPos < m_fftLength; ++pixelPos)
+        for (quint32 pixelPos = 0; pixelPos < ctx.fftLength; ++pixelPos)
         {
             tmp[0] = ((*channelPtr)[0] * (*kernelPtr)[0]) - ((*channelPtr)[1] * (*kernelPtr)[1]);
             tmp[1] = ((*channelPtr)[0] * (*kernelPtr)[1]) + ((*channelPtr)[1] * (*kernelPtr)[0]);
@@ -480,26 +769,27 @@ private:
         }
     }
 
-    void fftLogMatrix(double* channel, const QString &f)
+    template<typename T>
+    void fftLogMatrix(T* channel, const FFTContext<T> &ctx, const QString &f)
     {
-        KisConvolutionWorkerFFTLock::fftwMutex.lock();
+        QMutexLocker l(&KisConvolutionWorkerFFTLock::fftwMutex);
+
         QString filename(QDir::homePath() + "/log_" + f + ".txt");
         dbgKrita << "Log File Name: " << filename;
         QFile file (filename);
         if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
         {
             dbgKrita << "Failed";
-            KisConvolutionWorkerFFTLock::fftwMutex.unlock();
             return;
         }
 
         QTextStream in(&file);
         in.setCodec("UTF-8");
-        for (quint32 y = 0; y < m_fftHeight; y++)
+        for (quint32 y = 0; y < ctx.fftHeight; y++)
         {
-            for (quint32 x = 0; x < m_fftWidth; x++)
+            for (quint32 x = 0; x < ctx.fftWidth; x++)
             {
-                QString num = QString::number(channel[y * m_fftWidth + x]);
+                QString num = QString::number(channel[y * ctx.cacheRowStride() + x]);
                 while (num.length() < 15)
                     num += " ";
 
@@ -507,7 +797,6 @@ private:
             }
             in << "\n";
         }
-        KisConvolutionWorkerFFTLock::fftwMutex.unlock();
     }
 
     void addToProgress(float amount)
@@ -521,35 +810,11 @@ private:
 
     bool isInterrupted()
     {
-        if (this->m_progress && this->m_progress->interrupted()) {
-            cleanUp();
-            return true;
-        }
-
-        return false;
+        return this->m_progress && this->m_progress->interrupted();
     }
 
-    void cleanUp()
-    {
-        // free kernel fft data
-        if (m_kernelFFT) {
-            fftw_free(m_kernelFFT);
-        }
-
-        Q_FOREACH (fftw_complex *channel, m_channelFFT) {
-            fftw_free(channel);
-        }
-        m_channelFFT.clear();
-    }
 private:
-    quint32 m_fftWidth {0};
-    quint32 m_fftHeight {0};
-    quint32 m_fftLength {0};
-    quint32 m_extraMem {0};
     float m_currentProgress {0.0};
-
-    fftw_complex* m_kernelFFT {0};
-    QVector<fftw_complex*> m_channelFFT;
 };
 
 #endif
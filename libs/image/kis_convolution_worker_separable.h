@@ -0,0 +1,307 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_CONVOLUTION_WORKER_SEPARABLE_H
+#define KIS_CONVOLUTION_WORKER_SEPARABLE_H
+
+#include <KoChannelInfo.h>
+
+#include "kis_convolution_worker.h"
+#include "kis_convolution_kernel.h"
+#include "kis_math_toolbox.h"
+#include "kis_selection.h"
+
+#include <QVector>
+
+/**
+ * A spatial convolution worker for the kernels of rank 1 (see
+ * KisConvolutionKernel::isSeparable()). Such kernels are applied
+ * as a horizontal pass followed by a vertical one, which needs
+ * kw + kh multiplications per pixel instead of kw * kh.
+ *
+ * Every source pixel is converted into the floating point
+ * representation only once. The values are stored in per-channel
+ * planes (SoA), so both passes run over contiguous float arrays
+ * and can be vectorized by the compiler. The vertical pass keeps
+ * a ring buffer of the last kh horizontally convolved rows.
+ *
+ * The result is the same as the one of KisConvolutionWorkerSpatial,
+ * including the handling of alpha, the factor and the offset
+ * of the kernel.
+ */
+template <class _IteratorFactory_>
+class KisConvolutionWorkerSeparable : public KisConvolutionWorker<_IteratorFactory_>
+{
+public:
+    KisConvolutionWorkerSeparable(KisPainter *painter, KoUpdater *progress)
+        : KisConvolutionWorker<_IteratorFactory_>(painter, progress)
+    {
+    }
+
+    void execute(const KisConvolutionKernelSP kernel, const KisPaintDeviceSP src, QPoint srcPos, QPoint dstPos, QSize areaSize, const QRect& dataRect) override {
+        Eigen::Matrix<qreal, Eigen::Dynamic, 1> column;
+        Eigen::Matrix<qreal, 1, Eigen::Dynamic> row;
+        KIS_SAFE_ASSERT_RECOVER_RETURN(kernel->isSeparable(&column, &row));
+
+        const int kw = kernel->width();
+        const int kh = kernel->height();
+        const int khalfWidth = (kw - 1) / 2;
+        const int khalfHeight = (kh - 1) / 2;
+
+        // Make the area we cover as small as possible
+        if (this->m_painter->selection()) {
+            QRect r = this->m_painter->selection()->selectedRect().intersected(QRect(srcPos, areaSize));
+            dstPos += r.topLeft() - srcPos;
+            srcPos = r.topLeft();
+            areaSize = r.size();
+        }
+
+        if (areaSize.width() == 0 || areaSize.height() == 0)
+            return;
+
+        initChannels(kernel, src);
+
+        /**
+         * KisConvolutionWorkerSpatial convolves with the flipped kernel,
+         * so flip the factors as well. The factor of the kernel is
+         * merged into the vertical taps.
+         */
+        const qreal kernelFactor = kernel->factor() ? 1.0 / kernel->factor() : 1;
+
+        m_horizontalTaps.resize(kw);
+        for (int i = 0; i < kw; i++) {
+            m_horizontalTaps[i] = row(kw - 1 - i);
+        }
+
+        m_verticalTaps.resize(kh);
+        for (int i = 0; i < kh; i++) {
+            m_verticalTaps[i] = column(kh - 1 - i) * kernelFactor;
+        }
+
+        const int width = areaSize.width();
+        const int inputWidth = width + kw - 1;
+        const int rowPlanesSize = m_convolveChannelsNo * width;
+
+        m_inputRow.resize(m_convolveChannelsNo * inputWidth);
+        m_rowsRing.resize(kh * rowPlanesSize);
+        m_outputRow.resize(rowPlanesSize);
+
+        typename _IteratorFactory_::HLineConstIterator kitSrc =
+            _IteratorFactory_::createHLineConstIterator(src,
+                                                        srcPos.x() - khalfWidth,
+                                                        srcPos.y() - khalfHeight,
+                                                        inputWidth, dataRect);
+
+        typename _IteratorFactory_::HLineIterator hitDst =
+            _IteratorFactory_::createHLineIterator(this->m_painter->device(),
+                                                   dstPos.x(), dstPos.y(),
+                                                   width, dataRect);
+
+        typename _IteratorFactory_::HLineConstIterator hitSrc =
+            _IteratorFactory_::createHLineConstIterator(src,
+                                                        srcPos.x(), srcPos.y(),
+                                                        width, dataRect);
+
+        bool hasProgressUpdater = this->m_progress;
+        if (hasProgressUpdater) {
+            this->m_progress->setRange(0, areaSize.height());
+        }
+
+        // the first kh - 1 rows of the window
+        for (int i = 0; i < kh - 1; i++) {
+            loadRow(kitSrc, inputWidth, width, m_rowsRing.data() + i * rowPlanesSize);
+            kitSrc->nextRow();
+        }
+
+        for (int prow = 0; prow < areaSize.height(); prow++) {
+            const int lastSlot = (prow + kh - 1) % kh;
+            loadRow(kitSrc, inputWidth, width, m_rowsRing.data() + lastSlot * rowPlanesSize);
+            kitSrc->nextRow();
+
+            std::fill(m_outputRow.begin(), m_outputRow.end(), 0.0f);
+            float *out = m_outputRow.data();
+
+            for (int i = 0; i < kh; i++) {
+                const float tap = m_verticalTaps[i];
+                const float *rowPlanes = m_rowsRing.constData() + ((prow + i) % kh) * rowPlanesSize;
+
+                for (int j = 0; j < rowPlanesSize; j++) {
+                    out[j] += tap * rowPlanes[j];
+                }
+            }
+
+            for (int pcol = 0; pcol < width; pcol++) {
+                // write original channel values
+                memcpy(hitDst->rawData(), hitSrc->oldRawData(), m_pixelSize);
+                writePixel(hitDst->rawData(), pcol, width);
+
+                hitDst->nextPixel();
+                hitSrc->nextPixel();
+            }
+
+            hitDst->nextRow();
+            hitSrc->nextRow();
+
+            if (hasProgressUpdater) {
+                this->m_progress->setValue(prow);
+
+                if (this->m_progress->interrupted()) {
+                    return;
+                }
+            }
+        }
+    }
+
+private:
+    void initChannels(const KisConvolutionKernelSP kernel, const KisPaintDeviceSP src) {
+        m_pixelSize = src->colorSpace()->pixelSize();
+
+        m_convChannelList = this->convolvableChannelList(src);
+        m_convolveChannelsNo = m_convChannelList.count();
+
+        m_alphaCachePos = -1;
+        m_alphaRealPos = -1;
+
+        KisMathToolbox mathToolbox;
+
+        m_channelPos.resize(m_convolveChannelsNo);
+        m_minClamp.resize(m_convolveChannelsNo);
+        m_maxClamp.resize(m_convolveChannelsNo);
+        m_absoluteOffset.resize(m_convolveChannelsNo);
+
+        for (int i = 0; i < m_convolveChannelsNo; i++) {
+            m_channelPos[i] = m_convChannelList[i]->pos();
+            m_minClamp[i] = mathToolbox.minChannelValue(m_convChannelList[i]);
+            m_maxClamp[i] = mathToolbox.maxChannelValue(m_convChannelList[i]);
+            m_absoluteOffset[i] = (m_maxClamp[i] - m_minClamp[i]) * kernel->offset();
+
+            if (m_convChannelList[i]->channelType() == KoChannelInfo::ALPHA) {
+                m_alphaCachePos = i;
+                m_alphaRealPos = m_convChannelList[i]->pos();
+            }
+        }
+
+        m_toDoubleFuncPtr = QVector<PtrToDouble>(m_convolveChannelsNo);
+        m_fromDoubleFuncPtr = QVector<PtrFromDouble>(m_convolveChannelsNo);
+
+        bool result = mathToolbox.getToDoubleChannelPtr(m_convChannelList, m_toDoubleFuncPtr);
+        result &= mathToolbox.getFromDoubleChannelPtr(m_convChannelList, m_fromDoubleFuncPtr);
+        KIS_ASSERT(result);
+    }
+
+    /**
+     * Converts one row of the source into the channel planes
+     * and convolves it with the horizontal taps
+     */
+    void loadRow(typename _IteratorFactory_::HLineConstIterator &it,
+                 int inputWidth, int width, float *dstPlanes) {
+
+        float *input = m_inputRow.data();
+
+        int x = 0;
+        do {
+            const quint8 *data = it->oldRawData();
+
+            // no alpha is rare case, so just multiply by 1.0 in that case
+            const qreal alphaValue = m_alphaRealPos >= 0 ?
+                m_toDoubleFuncPtr[m_alphaCachePos](data, m_alphaRealPos) : 1.0;
+
+            for (int k = 0; k < m_convolveChannelsNo; k++) {
+                input[k * inputWidth + x] = k != m_alphaCachePos ?
+                    m_toDoubleFuncPtr[k](data, m_channelPos[k]) * alphaValue :
+                    alphaValue;
+            }
+
+            x++;
+        } while (it->nextPixel());
+
+        const int kw = m_horizontalTaps.size();
+
+        for (int k = 0; k < m_convolveChannelsNo; k++) {
+            const float *srcPlane = input + k * inputWidth;
+            float *dstPlane = dstPlanes + k * width;
+
+            std::fill(dstPlane, dstPlane + width, 0.0f);
+
+            for (int i = 0; i < kw; i++) {
+                const float tap = m_horizontalTaps[i];
+                const float *src = srcPlane + i;
+
+                for (int j = 0; j < width; j++) {
+                    dstPlane[j] += tap * src[j];
+                }
+            }
+        }
+    }
+
+    inline void limitValue(qreal *value, qreal lowBound, qreal highBound) {
+        if (*value > highBound) {
+            *value = highBound;
+        } else if (!(*value >= lowBound)) {  // value < lowBound or value == NaN
+            // IEEE compliant comparisons with NaN are always false
+            *value = lowBound;
+        }
+    }
+
+    inline qreal writeChannel(quint8 *dstPtr, int channel, qreal value) {
+        limitValue(&value, m_minClamp[channel], m_maxClamp[channel]);
+        m_fromDoubleFuncPtr[channel](dstPtr, m_channelPos[channel], value);
+        return value;
+    }
+
+    inline void writePixel(quint8 *dstPtr, int pcol, int width) {
+        const float *out = m_outputRow.constData() + pcol;
+
+        if (m_alphaCachePos >= 0) {
+            const qreal alphaValue =
+                writeChannel(dstPtr, m_alphaCachePos,
+                             out[m_alphaCachePos * width] + m_absoluteOffset[m_alphaCachePos]);
+
+            if (alphaValue != 0.0) {
+                const qreal alphaValueInv = 1.0 / alphaValue;
+
+                for (int k = 0; k < m_convolveChannelsNo; k++) {
+                    if (k == m_alphaCachePos) continue;
+                    writeChannel(dstPtr, k, out[k * width] * alphaValueInv + m_absoluteOffset[k]);
+                }
+            } else {
+                for (int k = 0; k < m_convolveChannelsNo; k++) {
+                    if (k == m_alphaCachePos) continue;
+                    m_fromDoubleFuncPtr[k](dstPtr, m_channelPos[k], 0.0);
+                }
+            }
+        } else {
+            for (int k = 0; k < m_convolveChannelsNo; k++) {
+                writeChannel(dstPtr, k, out[k * width] + m_absoluteOffset[k]);
+            }
+        }
+    }
+
+private:
+    int m_convolveChannelsNo {0};
+    int m_pixelSize {0};
+
+    int m_alphaCachePos {-1};
+    int m_alphaRealPos {-1};
+
+    QVector<float> m_horizontalTaps;
+    QVector<float> m_verticalTaps;
+
+    QVector<float> m_inputRow;
+    QVector<float> m_rowsRing;
+    QVector<float> m_outputRow;
+
+    QList<KoChannelInfo *> m_convChannelList;
+    QVector<int> m_channelPos;
+    QVector<qreal> m_minClamp;
+    QVector<qreal> m_maxClamp;
+    QVector<qreal> m_absoluteOffset;
+
+    QVector<PtrToDouble> m_toDoubleFuncPtr;
+    QVector<PtrFromDouble> m_fromDoubleFuncPtr;
+};
+
+#endif // KIS_CONVOLUTION_WORKER_SEPARABLE_H
@@ -155,6 +155,14 @@ public:
         return ACTUAL_DATAMGR::region();
     }
 
+    /**
+     * Returns the region changed since the previous call to
+     * this function. See KisTiledDataManager::takeLodSyncChangedRegion()
+     */
+    KisRegion takeLodSyncChangedRegion(bool *fullUpdateNeeded) {
+        return ACTUAL_DATAMGR::takeLodSyncChangedRegion(fullUpdateNeeded);
+    }
+
 public:
 
     /**
@@ -10,8 +10,11 @@
 #include "kis_convolution_kernel.h"
 #include <kis_convolution_painter.h>
 #include <kis_transaction.h>
+#include <kis_default_bounds_base.h>
 #include <QRect>
 
+#include "KisGaussianBoxCascadeWorker.h"
+
 
 qreal KisGaussianKernel::sigmaFromRadius(qreal radius)
 {
@@ -105,8 +108,33 @@ void KisGaussianKernel::applyGaussian(KisPaintDeviceSP device,
                                       const QBitArray &channelFlags,
                                       KoUpdater *progressUpdater,
                                       bool createTransaction,
-                                      KisConvolutionBorderOp borderOp)
+                                      KisConvolutionBorderOp borderOp,
+                                      Method method)
 {
+    if (method == Auto) {
+        auto isBigRadius = [] (qreal radius) {
+            return radius <= 0.0 || radius >= KisGaussianBoxCascadeWorker::autoMinRadius;
+        };
+
+        method = (xRadius > 0.0 || yRadius > 0.0) &&
+                isBigRadius(xRadius) && isBigRadius(yRadius) ? BoxCascade : Exact;
+    }
+
+    /**
+     * The box cascade cannot read through the wrapped borders,
+     * so fall back to the exact kernel in wrap-around mode.
+     */
+    if (method == BoxCascade && !device->defaultBounds()->wrapAroundMode()) {
+        QScopedPointer<KisTransaction> transaction;
+        if (createTransaction) {
+            transaction.reset(new KisTransaction(device));
+        }
+
+        KisGaussianBoxCascadeWorker::apply(device, rect, xRadius, yRadius,
+                                           channelFlags, progressUpdater, borderOp);
+        return;
+    }
+
     QPoint srcTopLeft = rect.topLeft();
 
 
@@ -18,6 +18,12 @@ class QRect;
 class KRITAIMAGE_EXPORT KisGaussianKernel
 {
 public:
+    enum Method {
+        Exact = 0,  ///< convolve with the sampled Gaussian kernel
+        BoxCascade, ///< approximate with KisGaussianBoxCascadeWorker, the cost doesn't depend on the radius
+        Auto        ///< use the box cascade for big radii only
+    };
+
     static Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic>
         createHorizontalMatrix(qreal radius);
 
@@ -42,7 +48,8 @@ public:
                               const QBitArray &channelFlags,
                               KoUpdater *updater,
                               bool createTransaction = false,
-                              KisConvolutionBorderOp borderOp = BORDER_REPEAT);
+                              KisConvolutionBorderOp borderOp = BORDER_REPEAT,
+                              Method method = Exact);
 
     static Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> createLoGMatrix(qreal radius, qreal coeff, bool zeroCentered, bool includeWrappedArea);
 
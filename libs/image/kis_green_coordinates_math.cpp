@@ -7,7 +7,9 @@
 #include "kis_green_coordinates_math.h"
 
 #include <cmath>
+#include <QtConcurrent>
 #include <kis_global.h>
+#include <kis_assert.h>
 #include <kis_algebra_2d.h>
 using namespace KisAlgebra2D;
 
@@ -19,12 +21,46 @@ using namespace KisAlgebra2D;
  * http://www.math.tau.ac.il/~lipmanya/GC/gc.htm
  */
 
-struct PrecalculatedCoords
+namespace {
+
+/**
+ * A range of points processed by one thread
+ */
+struct PointsRange
 {
-    QVector<qreal> psi; // for each edge
-    QVector<qreal> phi; // for each vertex
+    int begin;
+    int end;
 };
 
+QVector<PointsRange> splitIntoRanges(int numPoints)
+{
+    /**
+     * The ranges are big enough to amortize the scheduling
+     * cost, but small enough to balance the threads' load
+     */
+    const int rangeSize = 1024;
+
+    QVector<PointsRange> ranges;
+    for (int i = 0; i < numPoints; i += rangeSize) {
+        ranges.append({i, qMin(i + rangeSize, numPoints)});
+    }
+
+    return ranges;
+}
+
+template <class Func>
+void processRanges(int numPoints, Func func)
+{
+    QVector<PointsRange> ranges = splitIntoRanges(numPoints);
+
+    if (ranges.size() > 1) {
+        QtConcurrent::blockingMap(ranges, func);
+    } else if (!ranges.isEmpty()) {
+        func(ranges.first());
+    }
+}
+
+}
 
 struct Q_DECL_HIDDEN KisGreenCoordinatesMath::Private
 {
@@ -34,13 +70,32 @@ struct Q_DECL_HIDDEN KisGreenCoordinatesMath::Private
     QVector<QPointF> transformedCageNormals;
     int transformedCageDirection;
 
-    QVector<PrecalculatedCoords> precalculatedCoords;
+    int numPoints = 0;
+    int numCagePoints = 0;
+
+    /**
+     * The coordinates of all the points are stored in two flat
+     * arrays, numCagePoints values per point: psi for each edge
+     * and phi for each vertex of the cage. The coordinates depend
+     * on the original cage only, so they are calculated once and
+     * are reused for every change of the transformed cage.
+     */
+    QVector<qreal> psi;
+    QVector<qreal> phi;
 
     void precalculateOnePoint(const QVector<QPointF> &originalCage,
-                              PrecalculatedCoords *coords,
+                              qreal *pointPsi,
+                              qreal *pointPhi,
                               const QPointF &pt,
                               int polygonDirection);
 
+    QVector<QPointF> calculateCageNormals(const QVector<QPointF> &transformedCage,
+                                          int transformedCageDirection) const;
+
+    inline QPointF transformedPoint(int pointIndex,
+                                    const QVector<QPointF> &transformedCage,
+                                    const QVector<QPointF> &transformedCageNormals) const;
+
     inline void precalculateOneEdge(const QPointF &pt,
                                     const QPointF &v1,
                                     const QPointF &v2,
@@ -89,7 +144,8 @@ Private::precalculateOneEdge(const QPointF &pt,
 }
 
 void KisGreenCoordinatesMath::Private::precalculateOnePoint(const QVector<QPointF> &originalCage,
-                                                            PrecalculatedCoords *coords,
+                                                            qreal *pointPsi,
+                                                            qreal *pointPhi,
                                                             const QPointF &pt,
                                                             int polygonDirection)
 {
@@ -105,13 +161,53 @@ void KisGreenCoordinatesMath::Private::precalculateOnePoint(const QVector<QPoint
         precalculateOneEdge(pt,
                             originalCage[startIndex],
                             originalCage[endIndex],
-                            &coords->psi[startIndex],
-                            &coords->phi[startIndex],
-                            &coords->phi[endIndex],
+                            &pointPsi[startIndex],
+                            &pointPhi[startIndex],
+                            &pointPhi[endIndex],
                             polygonDirection);
     }
 }
 
+QVector<QPointF> KisGreenCoordinatesMath::Private::calculateCageNormals(const QVector<QPointF> &transformedCage,
+                                                                        int transformedCageDirection) const
+{
+    const int numCagePoints = transformedCage.size();
+    QVector<QPointF> normals(numCagePoints);
+
+    for (int i = 1; i <= numCagePoints; i++) {
+        int endIndex = i != numCagePoints ? i : 0;
+        int startIndex = i - 1;
+
+        QPointF transformedEdge =
+            transformedCage[endIndex] - transformedCage[startIndex];
+
+        qreal scaleCoeff =
+            norm(transformedEdge) / originalCageEdgeSizes[startIndex];
+
+        normals[startIndex] =
+            scaleCoeff * inwardUnitNormal(transformedEdge, transformedCageDirection);
+    }
+
+    return normals;
+}
+
+inline QPointF KisGreenCoordinatesMath::Private::transformedPoint(int pointIndex,
+                                                                  const QVector<QPointF> &transformedCage,
+                                                                  const QVector<QPointF> &transformedCageNormals) const
+{
+    QPointF result;
+
+    const qreal *pointPhi = phi.constData() + pointIndex * numCagePoints;
+    const qreal *pointPsi = psi.constData() + pointIndex * numCagePoints;
+
+    for (int i = 0; i < numCagePoints; i++) {
+        result += pointPhi[i] * transformedCage[i];
+        result += pointPsi[i] * transformedCageNormals[i];
+    }
+
+    return result;
+}
+
 KisGreenCoordinatesMath::KisGreenCoordinatesMath()
     : m_d(new Private())
 {
@@ -137,55 +233,61 @@ void KisGreenCoordinatesMath::precalculateGreenCoordinates(const QVector<QPointF
             norm(originalCage[endIndex] - originalCage[startIndex]);
     }
 
-    m_d->precalculatedCoords.resize(numPoints);
-
-    for (int i = 0; i < numPoints; i++) {
-        m_d->precalculatedCoords[i].psi.resize(numCagePoints);
-        m_d->precalculatedCoords[i].phi.resize(numCagePoints);
-
-        m_d->precalculateOnePoint(originalCage,
-                                  &m_d->precalculatedCoords[i],
-                                  points[i],
-                                  cageDirection);
-    }
+    m_d->numPoints = numPoints;
+    m_d->numCagePoints = numCagePoints;
+
+    m_d->psi.fill(0.0, numPoints * numCagePoints);
+    m_d->phi.fill(0.0, numPoints * numCagePoints);
+
+    qreal *psi = m_d->psi.data();
+    qreal *phi = m_d->phi.data();
+
+    processRanges(numPoints,
+        [&] (const PointsRange &range) {
+            for (int i = range.begin; i < range.end; i++) {
+                m_d->precalculateOnePoint(originalCage,
+                                          psi + i * numCagePoints,
+                                          phi + i * numCagePoints,
+                                          points[i],
+                                          cageDirection);
+            }
+        });
 }
 
 void KisGreenCoordinatesMath::generateTransformedCageNormals(const QVector<QPointF> &transformedCage)
 {
     m_d->transformedCageDirection = polygonDirection(transformedCage);
-
-    const int numCagePoints = transformedCage.size();
-    m_d->transformedCageNormals.resize(numCagePoints);
-
-    for (int i = 1; i <= numCagePoints; i++) {
-        int endIndex = i != numCagePoints ? i : 0;
-        int startIndex = i - 1;
-
-        QPointF transformedEdge =
-            transformedCage[endIndex] - transformedCage[startIndex];
-
-        qreal scaleCoeff =
-            norm(transformedEdge) / m_d->originalCageEdgeSizes[startIndex];
-
-        m_d->transformedCageNormals[startIndex] =
-            scaleCoeff * inwardUnitNormal(transformedEdge, m_d->transformedCageDirection);
-    }
+    m_d->transformedCageNormals =
+        m_d->calculateCageNormals(transformedCage, m_d->transformedCageDirection);
 }
 
 QPointF KisGreenCoordinatesMath::transformedPoint(int pointIndex, const QVector<QPointF> &transformedCage)
 {
-    QPointF result;
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(transformedCage.size() == m_d->numCagePoints, QPointF());
+    return m_d->transformedPoint(pointIndex, transformedCage, m_d->transformedCageNormals);
+}
 
-    const int numCagePoints = transformedCage.size();
+QVector<QPointF> KisGreenCoordinatesMath::transformedPoints(const QVector<QPointF> &transformedCage) const
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(transformedCage.size() == m_d->numCagePoints, QVector<QPointF>());
 
+    const QVector<QPointF> normals =
+        m_d->calculateCageNormals(transformedCage, polygonDirection(transformedCage));
 
-    PrecalculatedCoords *coords = &m_d->precalculatedCoords[pointIndex];
+    QVector<QPointF> result(m_d->numPoints);
+    QPointF *resultPtr = result.data();
 
-    for (int i = 0; i < numCagePoints; i++) {
-        result += coords->phi[i] * transformedCage[i];
-        result += coords->psi[i] * m_d->transformedCageNormals[i];
-    }
+    processRanges(m_d->numPoints,
+        [&] (const PointsRange &range) {
+            for (int i = range.begin; i < range.end; i++) {
+                resultPtr[i] = m_d->transformedPoint(i, transformedCage, normals);
+            }
+        });
 
     return result;
 }
 
+int KisGreenCoordinatesMath::numPoints() const
+{
+    return m_d->numPoints;
+}
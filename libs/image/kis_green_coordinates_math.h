@@ -39,6 +39,19 @@ public:
      */
     QPointF transformedPoint(int pointIndex, const QVector<QPointF> &transformedCage);
 
+    /**
+     * Transform all the points passed to precalculateGreenCoordinates().
+     * The points are processed in parallel. The function doesn't use
+     * the normals generated by generateTransformedCageNormals(), so
+     * it is safe to call it from several threads simultaneously.
+     */
+    QVector<QPointF> transformedPoints(const QVector<QPointF> &transformedCage) const;
+
+    /**
+     * The number of points the coordinates were precalculated for
+     */
+    int numPoints() const;
+
 private:
     struct Private;
     const QScopedPointer<Private> m_d;
@@ -162,10 +162,16 @@ void processGrid(ProcessPolygon &polygonOp, ForwardTransform &transformOp,
     processGrid(cellOp, srcBounds, pixelPrecision);
 }
 
+/**
+ * Both polygon ops accept an optional \p dstClipRect. When it is set, only
+ * the pixels lying inside the rect are written. It lets the callers split
+ * the destination into non-overlapping parts and process them in parallel.
+ */
 struct PaintDevicePolygonOp
 {
-    PaintDevicePolygonOp(KisPaintDeviceSP srcDev, KisPaintDeviceSP dstDev)
-        : m_srcDev(srcDev), m_dstDev(dstDev) {}
+    PaintDevicePolygonOp(KisPaintDeviceSP srcDev, KisPaintDeviceSP dstDev,
+                         const QRect &dstClipRect = QRect())
+        : m_srcDev(srcDev), m_dstDev(dstDev), m_dstClipRect(dstClipRect) {}
 
     void operator() (const QPolygonF &srcPolygon, const QPolygonF &dstPolygon) {
         this->operator() (srcPolygon, dstPolygon, dstPolygon);
@@ -173,6 +179,9 @@ struct PaintDevicePolygonOp
 
     void operator() (const QPolygonF &srcPolygon, const QPolygonF &dstPolygon, const QPolygonF &clipDstPolygon) {
         QRect boundRect = clipDstPolygon.boundingRect().toAlignedRect();
+        if (!m_dstClipRect.isEmpty()) {
+            boundRect &= m_dstClipRect;
+        }
         if (boundRect.isEmpty()) return;
 
         KisSequentialIterator dstIt(m_dstDev, boundRect);
@@ -232,18 +241,21 @@ struct PaintDevicePolygonOp
 
     KisPaintDeviceSP m_srcDev;
     KisPaintDeviceSP m_dstDev;
+    QRect m_dstClipRect;
 };
 
 struct QImagePolygonOp
 {
     QImagePolygonOp(const QImage &srcImage, QImage &dstImage,
                     const QPointF &srcImageOffset,
-                    const QPointF &dstImageOffset)
+                    const QPointF &dstImageOffset,
+                    const QRect &dstClipRect = QRect())
         : m_srcImage(srcImage), m_dstImage(dstImage),
           m_srcImageOffset(srcImageOffset),
           m_dstImageOffset(dstImageOffset),
           m_srcImageRect(m_srcImage.rect()),
-          m_dstImageRect(m_dstImage.rect())
+          m_dstImageRect(m_dstImage.rect()),
+          m_dstClipRect(dstClipRect)
     {
     }
 
@@ -253,6 +265,9 @@ struct QImagePolygonOp
 
     void operator() (const QPolygonF &srcPolygon, const QPolygonF &dstPolygon, const QPolygonF &clipDstPolygon) {
         QRect boundRect = clipDstPolygon.boundingRect().toAlignedRect();
+        if (!m_dstClipRect.isEmpty()) {
+            boundRect &= m_dstClipRect;
+        }
         KisFourPointInterpolatorBackward interp(srcPolygon, dstPolygon);
 
         for (int y = boundRect.top(); y <= boundRect.bottom(); y++) {
@@ -304,6 +319,7 @@ struct QImagePolygonOp
 
     QRect m_srcImageRect;
     QRect m_dstImageRect;
+    QRect m_dstClipRect;
 };
 
 /*************************************************************/
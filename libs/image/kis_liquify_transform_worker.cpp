@@ -6,6 +6,10 @@
 
 #include "kis_liquify_transform_worker.h"
 
+#include <QtConcurrent>
+#include <QtMath>
+#include <QTransform>
+
 #include <KoColorSpace.h>
 #include "kis_grid_interpolation_tools.h"
 #include "kis_dom_utils.h"
@@ -32,8 +36,71 @@ struct Q_DECL_HIDDEN KisLiquifyTransformWorker::Private
     int pixelPrecision;
     QSize gridSize;
 
+    /**
+     * The points changed by the editing functions since the last
+     * render of the preview. \p dirtyGridRect is stored in the grid
+     * coordinates, \p dirtyDstRect keeps the positions the changed
+     * points had before the change.
+     */
+    QRect dirtyGridRect;
+    QRect dirtyDstRect;
+
+    /**
+     * The result of the last runOnQImage() call. If the next call
+     * is done with the same source and transform, only the area
+     * affected by the dirty points is re-rendered.
+     */
+    struct PreviewCache {
+        bool isValid = false;
+        qint64 srcCacheKey = 0;
+        QPointF srcImageOffset;
+        QTransform imageToThumbTransform;
+        QPointF dstImageOffset;
+        QImage dstImage;
+    };
+
+    PreviewCache previewCache;
+
     void preparePoints();
 
+    inline void markPointDirty(int index, const QPointF &oldPos) {
+        const QPoint gridPt(index % gridSize.width(), index / gridSize.width());
+        dirtyGridRect |= QRect(gridPt, QSize(1, 1));
+        dirtyDstRect |= QRect(QPoint(qFloor(oldPos.x()), qFloor(oldPos.y())),
+                              QPoint(qCeil(oldPos.x()), qCeil(oldPos.y())));
+    }
+
+    void resetDirtyPoints();
+    void invalidatePreviewCache();
+    QRectF dirtyAreaBounds() const;
+
+    /**
+     * A horizontal band of the destination and the grid cells
+     * (represented by the index of their top-left point) that
+     * should be painted into it
+     */
+    struct CellsBand {
+        QRect rect;
+        QVector<int> cells;
+    };
+
+    /**
+     * Splits \p dstArea into bands of \p bandHeight rows and calls
+     * \p processBand for every band in parallel. The band may have
+     * no cells at all.
+     */
+    template <class ProcessBand>
+    void processCellsInBands(const QVector<QPointF> &dstPoints,
+                             const QRect &dstArea,
+                             int bandHeight,
+                             ProcessBand processBand);
+
+    template <class PolygonOp>
+    void processCells(PolygonOp &polygonOp,
+                      const QVector<int> &cells,
+                      const QVector<QPointF> &srcPoints,
+                      const QVector<QPointF> &dstPoints);
+
     struct MapIndexesOp;
 
     template <class ProcessOp>
@@ -118,6 +185,9 @@ const QVector<QPointF>& KisLiquifyTransformWorker::originalPoints() const
 
 QVector<QPointF>& KisLiquifyTransformWorker::transformedPoints()
 {
+    // we cannot track the changes done via the reference
+    m_d->invalidatePreviewCache();
+
     return m_d->transformedPoints;
 }
 
@@ -161,6 +231,138 @@ void KisLiquifyTransformWorker::Private::preparePoints()
     transformedPoints = pointsOp.m_points;
 }
 
+void KisLiquifyTransformWorker::Private::resetDirtyPoints()
+{
+    dirtyGridRect = QRect();
+    dirtyDstRect = QRect();
+}
+
+void KisLiquifyTransformWorker::Private::invalidatePreviewCache()
+{
+    previewCache = PreviewCache();
+    resetDirtyPoints();
+}
+
+QRectF KisLiquifyTransformWorker::Private::dirtyAreaBounds() const
+{
+    if (dirtyGridRect.isEmpty()) return QRectF();
+
+    /**
+     * All the cells sharing a changed point are affected. The points
+     * of these cells that have not been changed stay at the same
+     * place, so the old position of the cells is covered by the
+     * current position of the cells plus the old position of the
+     * changed points.
+     */
+    const QRect affectedPoints =
+        dirtyGridRect.adjusted(-1, -1, 1, 1) & QRect(QPoint(), gridSize);
+
+    qreal left = dirtyDstRect.left();
+    qreal top = dirtyDstRect.top();
+    qreal right = dirtyDstRect.right() + 1;
+    qreal bottom = dirtyDstRect.bottom() + 1;
+
+    for (int row = affectedPoints.top(); row <= affectedPoints.bottom(); row++) {
+        const QPointF *pt = transformedPoints.constData() +
+            GridIterationTools::pointToIndex(QPoint(affectedPoints.left(), row), gridSize);
+
+        for (int col = affectedPoints.left(); col <= affectedPoints.right(); col++, pt++) {
+            left = qMin(left, pt->x());
+            top = qMin(top, pt->y());
+            right = qMax(right, pt->x());
+            bottom = qMax(bottom, pt->y());
+        }
+    }
+
+    return QRectF(QPointF(left, top), QPointF(right, bottom));
+}
+
+template <class ProcessBand>
+void KisLiquifyTransformWorker::Private::
+processCellsInBands(const QVector<QPointF> &dstPoints,
+                    const QRect &dstArea,
+                    int bandHeight,
+                    ProcessBand processBand)
+{
+    using namespace GridIterationTools;
+
+    if (dstArea.isEmpty()) return;
+
+    const int firstBand = KisAlgebra2D::divideFloor(dstArea.top(), bandHeight);
+    const int lastBand = KisAlgebra2D::divideFloor(dstArea.bottom(), bandHeight);
+
+    QVector<CellsBand> bands(lastBand - firstBand + 1);
+    for (int i = 0; i < bands.size(); i++) {
+        const int top = (firstBand + i) * bandHeight;
+        bands[i].rect = QRect(dstArea.left(), top, dstArea.width(), bandHeight) & dstArea;
+    }
+
+    /**
+     * Distribute the cells between the bands. The cells are added in the
+     * same order as iterateThroughGrid() visits them, so the overlapping
+     * cells are painted in the same order as in the sequential case.
+     */
+    for (int row = 0; row < gridSize.height() - 1; row++) {
+        for (int col = 0; col < gridSize.width() - 1; col++) {
+            const int tl = pointToIndex(QPoint(col, row), gridSize);
+            const int bl = tl + gridSize.width();
+
+            const QPointF &p0 = dstPoints[tl];
+            const QPointF &p1 = dstPoints[tl + 1];
+            const QPointF &p2 = dstPoints[bl + 1];
+            const QPointF &p3 = dstPoints[bl];
+
+            // one pixel margin accounts for adjustAlignedPolygon()
+            const int top = qFloor(qMin(qMin(p0.y(), p1.y()), qMin(p2.y(), p3.y()))) - 1;
+            const int bottom = qCeil(qMax(qMax(p0.y(), p1.y()), qMax(p2.y(), p3.y()))) + 1;
+            const int left = qFloor(qMin(qMin(p0.x(), p1.x()), qMin(p2.x(), p3.x()))) - 1;
+            const int right = qCeil(qMax(qMax(p0.x(), p1.x()), qMax(p2.x(), p3.x()))) + 1;
+
+            const QRect cellRect = QRect(QPoint(left, top), QPoint(right, bottom)) & dstArea;
+            if (cellRect.isEmpty()) continue;
+
+            const int cellFirstBand = KisAlgebra2D::divideFloor(cellRect.top(), bandHeight) - firstBand;
+            const int cellLastBand = KisAlgebra2D::divideFloor(cellRect.bottom(), bandHeight) - firstBand;
+
+            for (int i = cellFirstBand; i <= cellLastBand; i++) {
+                bands[i].cells.append(tl);
+            }
+        }
+    }
+
+    if (bands.size() > 1) {
+        QtConcurrent::blockingMap(bands, processBand);
+    } else {
+        processBand(bands.first());
+    }
+}
+
+template <class PolygonOp>
+void KisLiquifyTransformWorker::Private::
+processCells(PolygonOp &polygonOp,
+             const QVector<int> &cells,
+             const QVector<QPointF> &srcPoints,
+             const QVector<QPointF> &dstPoints)
+{
+    QPolygonF srcPolygon(4);
+    QPolygonF dstPolygon(4);
+
+    Q_FOREACH (int tl, cells) {
+        const int bl = tl + gridSize.width();
+        const int indexes[4] = {tl, tl + 1, bl + 1, bl};
+
+        for (int i = 0; i < 4; i++) {
+            srcPolygon[i] = srcPoints[indexes[i]];
+            dstPolygon[i] = dstPoints[indexes[i]];
+        }
+
+        GridIterationTools::adjustAlignedPolygon(srcPolygon);
+        GridIterationTools::adjustAlignedPolygon(dstPolygon);
+
+        polygonOp(srcPolygon, dstPolygon);
+    }
+}
+
 void KisLiquifyTransformWorker::translate(const QPointF &offset)
 {
     QVector<QPointF>::iterator it = m_d->transformedPoints.begin();
@@ -174,6 +376,8 @@ void KisLiquifyTransformWorker::translate(const QPointF &offset)
         *it += offset;
         *refIt += offset;
     }
+
+    m_d->invalidatePreviewCache();
 }
 
 void KisLiquifyTransformWorker::translateDstSpace(const QPointF &offset)
@@ -184,6 +388,8 @@ void KisLiquifyTransformWorker::translateDstSpace(const QPointF &offset)
     for (; it != end; ++it) {
         *it += offset;
     }
+
+    m_d->invalidatePreviewCache();
 }
 
 void KisLiquifyTransformWorker::undoPoints(const QPointF &base,
@@ -202,7 +408,7 @@ void KisLiquifyTransformWorker::undoPoints(const QPointF &base,
     KIS_ASSERT_RECOVER_RETURN(m_d->originalPoints.size() ==
                               m_d->transformedPoints.size());
 
-    for (; it != end; ++it, ++refIt) {
+    for (int index = 0; it != end; ++it, ++refIt, ++index) {
         if (!clipRect.contains(*it)) continue;
 
         QPointF diff = *it - base;
@@ -211,6 +417,7 @@ void KisLiquifyTransformWorker::undoPoints(const QPointF &base,
 
         qreal lambda = exp(-0.5 * pow2(dist / sigma));
         lambda *= amount;
+        m_d->markPointDirty(index, *it);
         *it = *refIt * lambda + *it * (1.0 - lambda);
     }
 }
@@ -228,7 +435,7 @@ processTransformedPixelsBuildUp(ProcessOp op,
     QVector<QPointF>::iterator it = transformedPoints.begin();
     QVector<QPointF>::iterator end = transformedPoints.end();
 
-    for (; it != end; ++it) {
+    for (int index = 0; it != end; ++it, ++index) {
         if (!clipRect.contains(*it)) continue;
 
         QPointF diff = *it - base;
@@ -236,6 +443,7 @@ processTransformedPixelsBuildUp(ProcessOp op,
         if (dist > maxDist) continue;
 
         const qreal lambda = exp(-0.5 * pow2(dist / sigma));
+        markPointDirty(index, *it);
         *it = op(*it, base, diff, lambda);
     }
 }
@@ -258,7 +466,7 @@ processTransformedPixelsWash(ProcessOp op,
     KIS_ASSERT_RECOVER_RETURN(originalPoints.size() ==
                               transformedPoints.size());
 
-    for (; it != end; ++it, ++refIt) {
+    for (int index = 0; it != end; ++it, ++refIt, ++index) {
         if (!clipRect.contains(*it)) continue;
 
         QPointF diff = *refIt - base;
@@ -269,6 +477,7 @@ processTransformedPixelsWash(ProcessOp op,
         QPointF dstPt = op(*refIt, base, diff, lambda);
 
         if (kisDistance(dstPt, *refIt) > kisDistance(*it, *refIt)) {
+            markPointDirty(index, *it);
             *it = (1.0 - flow) * (*it) + flow * dstPt;
         }
     }
@@ -397,12 +606,29 @@ void KisLiquifyTransformWorker::run(KisPaintDeviceSP srcDevice, KisPaintDeviceSP
 
     using namespace GridIterationTools;
 
-    PaintDevicePolygonOp polygonOp(srcDevice, dstDevice);
-    RegularGridIndexesOp indexesOp(m_d->gridSize);
-    iterateThroughGrid<AlwaysCompletePolygonPolicy>(polygonOp, indexesOp,
-                                                    m_d->gridSize,
-                                                    m_d->originalPoints,
-                                                    m_d->transformedPoints);
+    QRectF dstBounds;
+    Q_FOREACH (const QPointF &pt, m_d->transformedPoints) {
+        KisAlgebra2D::accumulateBounds(pt, &dstBounds);
+    }
+
+    /**
+     * The bands are aligned to the rows of tiles, so the threads
+     * never write into the same tile
+     */
+    const int bandHeight = 64;
+
+    auto processBand = [this, srcDevice, dstDevice] (const Private::CellsBand &band) {
+        if (band.cells.isEmpty()) return;
+
+        PaintDevicePolygonOp polygonOp(srcDevice, dstDevice, band.rect);
+        m_d->processCells(polygonOp, band.cells,
+                          m_d->originalPoints, m_d->transformedPoints);
+    };
+
+    m_d->processCellsInBands(m_d->transformedPoints,
+                             dstBounds.toAlignedRect().adjusted(-1, -1, 1, 1),
+                             bandHeight,
+                             processBand);
 }
 
 QRect KisLiquifyTransformWorker::approxChangeRect(const QRect &rc)
@@ -445,6 +671,8 @@ void KisLiquifyTransformWorker::transformSrcAndDst(const QTransform &t)
     for (auto it = m_d->transformedPoints.begin(); it != m_d->transformedPoints.end(); ++it) {
         *it = t.map(*it);
     }
+
+    m_d->invalidatePreviewCache();
 }
 
 #include <functional>
@@ -501,16 +729,95 @@ QImage KisLiquifyTransformWorker::runOnQImage(const QImage &srcImage,
 
     QRect dstBoundsI = dstBounds.toAlignedRect();
 
-    QImage dstImage(dstBoundsI.size(), srcImage.format());
-    dstImage.fill(0);
+    Private::PreviewCache &cache = m_d->previewCache;
+
+    const bool canUpdateIncrementally =
+        cache.isValid &&
+        cache.srcCacheKey == srcImage.cacheKey() &&
+        cache.srcImageOffset == srcImageOffset &&
+        cache.imageToThumbTransform == imageToThumbTransform &&
+        cache.dstImageOffset == dstQImageOffset &&
+        cache.dstImage.size() == dstBoundsI.size();
+
+    QRect renderRect;
+
+    if (canUpdateIncrementally) {
+        const QRectF dirtyArea = m_d->dirtyAreaBounds();
+
+        if (dirtyArea.isEmpty()) {
+            return cache.dstImage;
+        }
+
+        renderRect = imageToThumbTransform.mapRect(dirtyArea).toAlignedRect().adjusted(-1, -1, 1, 1);
+    } else {
+        cache.dstImage = QImage(dstBoundsI.size(), srcImage.format());
+        cache.dstImage.fill(0);
+
+        renderRect = dstBounds.toAlignedRect().adjusted(-1, -1, 1, 1);
+    }
+
+    QImage &dstImage = cache.dstImage;
+
+    /**
+     * Every band is rendered into its own image and then copied into
+     * the destination, so the threads never touch the same QImage
+     * object. Detach the destination beforehand, so the bands can
+     * write into its rows directly.
+     */
+    uchar *dstBits = dstImage.bits();
+    const int dstBytesPerLine = dstImage.bytesPerLine();
+    const QRect dstImageRect = dstImage.rect();
+
+    /**
+     * QImagePolygonOp maps the integer points of the thumbnail space
+     * into the pixels of the destination image by a constant shift
+     */
+    const QPoint shift =
+        (QPointF(renderRect.topLeft()) - dstQImageOffset).toPoint() - renderRect.topLeft();
+
+    auto processBand =
+        [&, this] (const Private::CellsBand &band) {
+            const QRect bandImageRect = band.rect.translated(shift);
+
+            QImage bandImage(bandImageRect.size(), dstImage.format());
+            bandImage.fill(0);
+
+            GridIterationTools::QImagePolygonOp polygonOp(srcImage, bandImage, srcImageOffset,
+                                                          dstQImageOffset + bandImageRect.topLeft(),
+                                                          band.rect);
+            m_d->processCells(polygonOp, band.cells,
+                              originalPointsLocal, transformedPointsLocal);
+
+            const QRect copyRect = bandImageRect & dstImageRect;
+            if (copyRect.isEmpty()) return;
+
+            const int pixelSize = 4;
+
+            for (int y = copyRect.top(); y <= copyRect.bottom(); y++) {
+                const uchar *srcLine =
+                    bandImage.constScanLine(y - bandImageRect.top()) +
+                    (copyRect.left() - bandImageRect.left()) * pixelSize;
+
+                memcpy(dstBits + y * dstBytesPerLine + copyRect.left() * pixelSize,
+                       srcLine, copyRect.width() * pixelSize);
+            }
+        };
+
+    const int bandHeight = 32;
+
+    m_d->processCellsInBands(transformedPointsLocal,
+                             renderRect,
+                             bandHeight,
+                             processBand);
+
+    cache.isValid = true;
+    cache.srcCacheKey = srcImage.cacheKey();
+    cache.srcImageOffset = srcImageOffset;
+    cache.imageToThumbTransform = imageToThumbTransform;
+    cache.dstImageOffset = dstQImageOffset;
+
+    m_d->resetDirtyPoints();
 
-    GridIterationTools::QImagePolygonOp polygonOp(srcImage, dstImage, srcImageOffset, dstQImageOffset);
-    GridIterationTools::RegularGridIndexesOp indexesOp(m_d->gridSize);
-    GridIterationTools::iterateThroughGrid
-        <GridIterationTools::AlwaysCompletePolygonPolicy>(polygonOp, indexesOp,
-                                                          m_d->gridSize,
-                                                          originalPointsLocal,
-                                                          transformedPointsLocal);
     return dstImage;
 }
 
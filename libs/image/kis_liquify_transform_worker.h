@@ -63,7 +63,19 @@ public:
     const QVector<QPointF>& originalPoints() const;
     QVector<QPointF>& transformedPoints();
 
+    /**
+     * Renders the transformed grid into \p dstDevice. The destination
+     * is split into the rows of tiles, which are rendered in parallel.
+     */
     void run(KisPaintDeviceSP srcDevice, KisPaintDeviceSP dstDevice);
+
+    /**
+     * Renders the preview of the transformation. The worker keeps the
+     * result of the previous call, so when the function is called
+     * with the same \p srcImage (checked with QImage::cacheKey()) and
+     * the same transform, only the area affected by the points changed
+     * since the last call is re-rendered.
+     */
     QImage runOnQImage(const QImage &srcImage,
                        const QPointF &srcImageOffset,
                        const QTransform &imageToThumbTransform,
@@ -159,6 +159,7 @@ public:
     {
 
         m_lodData.reset();
+        m_lodSyncSourceData = 0;
         m_externalFrameData.reset();
 
         if (!m_frames.isEmpty()) {
@@ -422,6 +423,7 @@ public:
     void updateLodDataStruct(LodDataStruct *dst, const QRect &srcRect);
     void uploadLodDataStruct(LodDataStruct *dst);
     KisRegion regionForLodSyncing() const;
+    KisRegion regionForLodSyncing(LodDataStruct *dst) const;
 
     void updateLodDataManager(KisDataManager *srcDataManager,
                               KisDataManager *dstDataManager, const QPoint &srcOffset, const QPoint &dstOffset,
@@ -597,6 +599,12 @@ private:
     DataSP m_data;
     mutable QScopedPointer<Data> m_lodData;
     mutable QScopedPointer<Data> m_externalFrameData;
+
+    /**
+     * The source data the LoD plane has been synced with last time. The LoD
+     * plane can be synced incrementally only when the source stays the same.
+     */
+    Data *m_lodSyncSourceData = 0;
     mutable QMutex m_dataSwitchLock;
 
     FramesHash m_frames;
@@ -677,8 +685,16 @@ struct KisPaintDevice::Private::StrategyPolicy {
 };
 
 struct KisPaintDevice::Private::LodDataStructImpl : public KisPaintDevice::LodDataStruct {
-    LodDataStructImpl(Data *_lodData) : lodData(_lodData) {}
+    LodDataStructImpl(Data *_lodData, Data *_sourceData, const KisRegion &_syncRegion)
+        : lodData(_lodData),
+          sourceData(_sourceData),
+          syncRegion(_syncRegion)
+    {
+    }
+
     QScopedPointer<Data> lodData;
+    Data *sourceData;
+    KisRegion syncRegion;
 };
 
 KisRegion KisPaintDevice::Private::regionForLodSyncing() const
@@ -687,40 +703,98 @@ KisRegion KisPaintDevice::Private::regionForLodSyncing() const
     return srcData->dataManager()->region().translated(srcData->x(), srcData->y());
 }
 
+KisRegion KisPaintDevice::Private::regionForLodSyncing(LodDataStruct *_dst) const
+{
+    LodDataStructImpl *dst = dynamic_cast<LodDataStructImpl*>(_dst);
+    KIS_SAFE_ASSERT_RECOVER(dst) { return regionForLodSyncing(); }
+
+    return dst->syncRegion;
+}
+
 KisPaintDevice::LodDataStruct* KisPaintDevice::Private::createLodDataStruct(int newLod)
 {
     KIS_SAFE_ASSERT_RECOVER_NOOP(newLod > 0);
 
     Data *srcData = currentNonLodData();
 
-    Data *lodData = new Data(q, srcData, false);
-    LodDataStruct *lodStruct = new LodDataStructImpl(lodData);
-
     int expectedX = KisLodTransform::coordToLodCoord(srcData->x(), newLod);
     int expectedY = KisLodTransform::coordToLodCoord(srcData->y(), newLod);
 
+    /**
+     * Fetch the tiles changed since the previous sync. The tracking
+     * data is reset here, so if the struct is never uploaded, we
+     * should fall back to the full sync next time (see
+     * m_lodSyncSourceData reset below).
+     */
+    bool srcFullUpdateNeeded = false;
+    KisRegion srcChangedRegion =
+        srcData->dataManager()->takeLodSyncChangedRegion(&srcFullUpdateNeeded);
+    srcChangedRegion.translate(srcData->x(), srcData->y());
+
     /**
      * We compare color spaces as pure pointers, because they must be
      * exactly the same, since they come from the common source.
      */
-    if (lodData->levelOfDetail() != newLod ||
-        lodData->colorSpace() != srcData->colorSpace() ||
-        lodData->x() != expectedX ||
-        lodData->y() != expectedY) {
+    const bool canSyncIncrementally =
+        !srcFullUpdateNeeded &&
+        m_lodData &&
+        m_lodSyncSourceData == srcData &&
+        m_lodData->levelOfDetail() == newLod &&
+        m_lodData->colorSpace() == srcData->colorSpace() &&
+        m_lodData->x() == expectedX &&
+        m_lodData->y() == expectedY;
+
+    m_lodSyncSourceData = 0;
+
+    Data *lodData = 0;
+    KisRegion syncRegion;
+
+    if (canSyncIncrementally) {
+        /**
+         * The LoD plane could also be changed by the LoD-strokes,
+         * so the areas changed on it should be regenerated as well.
+         */
+        bool lodFullUpdateNeeded = false;
+        KisRegion lodChangedRegion =
+            m_lodData->dataManager()->takeLodSyncChangedRegion(&lodFullUpdateNeeded);
+
+        if (!lodFullUpdateNeeded) {
+            QVector<QRect> rects = srcChangedRegion.rects();
+
+            Q_FOREACH (const QRect &rc, lodChangedRegion.rects()) {
+                rects << KisLodTransform::upscaledRect(rc.translated(m_lodData->x(), m_lodData->y()), newLod);
+            }
+
+            syncRegion = KisRegion::fromOverlappingRects(rects, KisTileData::WIDTH);
+
+            // the copy is implicitly shared with the current LoD plane
+            lodData = new Data(q, m_lodData.data(), true);
+        }
+    }
 
+    if (!lodData) {
+        lodData = new Data(q, srcData, false);
+        syncRegion = regionForLodSyncing();
 
-        lodData->prepareClone(srcData);
+        if (lodData->levelOfDetail() != newLod ||
+            lodData->colorSpace() != srcData->colorSpace() ||
+            lodData->x() != expectedX ||
+            lodData->y() != expectedY) {
 
-        lodData->setLevelOfDetail(newLod);
-        lodData->setX(expectedX);
-        lodData->setY(expectedY);
 
-        // FIXME: different kind of synchronization
+            lodData->prepareClone(srcData);
+
+            lodData->setLevelOfDetail(newLod);
+            lodData->setX(expectedX);
+            lodData->setY(expectedY);
+
+            // FIXME: different kind of synchronization
+        }
     }
 
     lodData->cache()->invalidate();
 
-    return lodStruct;
+    return new LodDataStructImpl(lodData, srcData, syncRegion);
 }
 
 void KisPaintDevice::Private::updateLodDataManager(KisDataManager *srcDataManager,
@@ -859,6 +933,14 @@ void KisPaintDevice::Private::uploadLodDataStruct(LodDataStruct *_dst)
 
     m_lodData->prepareClone(dst->lodData.data());
     m_lodData->dataManager()->bitBltRough(dst->lodData->dataManager(), dst->lodData->dataManager()->extent());
+
+    /**
+     * Uploading has just touched all the tiles of the LoD plane, so
+     * reset its changes tracking to let the next sync be incremental
+     */
+    bool unused = false;
+    m_lodData->dataManager()->takeLodSyncChangedRegion(&unused);
+    m_lodSyncSourceData = dst->sourceData;
 }
 
 void KisPaintDevice::Private::transferFromData(Data *data, KisPaintDeviceSP targetDevice)
@@ -2166,6 +2248,11 @@ KisRegion KisPaintDevice::regionForLodSyncing() const
     return m_d->regionForLodSyncing();
 }
 
+KisRegion KisPaintDevice::regionForLodSyncing(LodDataStruct *dst) const
+{
+    return m_d->regionForLodSyncing(dst);
+}
+
 KisPaintDevice::LodDataStruct* KisPaintDevice::createLodDataStruct(int lod)
 {
     return m_d->createLodDataStruct(lod);
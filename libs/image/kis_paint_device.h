@@ -918,6 +918,15 @@ public:
     };
 
     KisRegion regionForLodSyncing() const;
+
+    /**
+     * Returns the region that should be passed to updateLodDataStruct()
+     * to make \p dst up-to-date. When the LoD plane has been synced
+     * before and the source device hasn't been replaced since then,
+     * only the tiles changed after the previous sync are returned.
+     */
+    KisRegion regionForLodSyncing(LodDataStruct *dst) const;
+
     LodDataStruct* createLodDataStruct(int lod);
     void updateLodDataStruct(LodDataStruct *dst, const QRect &srcRect);
     void uploadLodDataStruct(LodDataStruct *dst);
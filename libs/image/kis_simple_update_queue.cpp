@@ -65,6 +65,8 @@ void KisSimpleUpdateQueue::updateSettings()
     m_patchWidth = config.updatePatchWidth();
     m_patchHeight = config.updatePatchHeight();
 
+    m_updatesIndex.setCellSize(QSize(m_patchWidth, m_patchHeight));
+
     m_maxCollectAlpha = config.maxCollectAlpha();
     m_maxMergeAlpha = config.maxMergeAlpha();
     m_maxMergeCollectAlpha = config.maxMergeCollectAlpha();
@@ -111,6 +113,7 @@ bool KisSimpleUpdateQueue::processOneJob(KisUpdaterContext &updaterContext)
 
             updaterContext.addMergeJob(item);
             iter.remove();
+            m_updatesIndex.removeWalker(item);
             jobAdded = true;
             break;
         }
@@ -217,6 +220,9 @@ void KisSimpleUpdateQueue::addJob(KisNodeSP node, const QVector<QRect> &rects,
     if (!walkers.isEmpty()) {
         m_lock.lock();
         m_updatesList.append(walkers);
+        Q_FOREACH (KisBaseRectsWalkerSP walker, walkers) {
+            m_updatesIndex.addWalker(walker);
+        }
         m_lock.unlock();
     }
 }
@@ -297,18 +303,19 @@ bool KisSimpleUpdateQueue::tryMergeJob(KisNodeSP node, const QRect& rc,
     QRect baseRect = rc;
 
     KisBaseRectsWalkerSP goodCandidate;
-    KisBaseRectsWalkerSP item;
-    KisWalkersListIterator iter(m_updatesList);
 
     /**
+     * Only the walkers lying in the neighbourhood of the rect
+     * can be merged with it, so we don't scan the entire list,
+     * but fetch the candidates from the spatial index.
+     *
      * We add new jobs to the tail of the list,
-     * so it's more probable to find a good candidate here.
+     * so it's more probable to find a good candidate there.
      */
+    const QVector<KisBaseRectsWalkerSP> candidates = m_updatesIndex.mergeCandidates(rc);
 
-    iter.toBack();
-
-    while(iter.hasPrevious()) {
-        item = iter.previous();
+    for (auto it = candidates.crbegin(); it != candidates.crend(); ++it) {
+        const KisBaseRectsWalkerSP &item = *it;
 
         if(item->startNode() != node) continue;
         if(item->type() != type) continue;
@@ -343,12 +350,14 @@ void KisSimpleUpdateQueue::collectJobs(KisBaseRectsWalkerSP &baseWalker,
                                        QRect baseRect,
                                        const qreal maxAlpha)
 {
-    KisBaseRectsWalkerSP item;
-    KisMutableWalkersListIterator iter(m_updatesList);
-
-    while(iter.hasNext()) {
-        item = iter.next();
+    /**
+     * The final merged rect must fit into one patch, so all the
+     * walkers we can collect must be present in the neighbourhood
+     * of the initial rect.
+     */
+    const QVector<KisBaseRectsWalkerSP> candidates = m_updatesIndex.mergeCandidates(baseRect);
 
+    Q_FOREACH (KisBaseRectsWalkerSP item, candidates) {
         if(item == baseWalker) continue;
         if(item->type() != baseWalker->type()) continue;
         if(item->startNode() != baseWalker->startNode()) continue;
@@ -356,12 +365,21 @@ void KisSimpleUpdateQueue::collectJobs(KisBaseRectsWalkerSP &baseWalker,
         if(item->levelOfDetail() != baseWalker->levelOfDetail()) continue;
 
         if(joinRects(baseRect, item->requestedRect(), maxAlpha)) {
-            iter.remove();
+            m_updatesIndex.removeWalker(item);
+
+            /**
+             * The merged walkers are usually the recent ones,
+             * so search from the tail of the list
+             */
+            const int index = m_updatesList.lastIndexOf(item);
+            KIS_SAFE_ASSERT_RECOVER(index >= 0) { continue; }
+            m_updatesList.removeAt(index);
         }
     }
 
     if(baseWalker->requestedRect() != baseRect) {
         baseWalker->collectRects(baseWalker->startNode(), baseRect);
+        m_updatesIndex.updateWalker(baseWalker);
     }
 }
 
@@ -9,6 +9,7 @@
 
 #include <QMutex>
 #include "kis_updater_context.h"
+#include "KisUpdateWalkersSpatialIndex.h"
 
 typedef QList<KisBaseRectsWalkerSP> KisWalkersList;
 typedef QListIterator<KisBaseRectsWalkerSP> KisWalkersListIterator;
@@ -62,6 +63,13 @@ protected:
 
     mutable QMutex m_lock;
     KisWalkersList m_updatesList;
+
+    /**
+     * Spatial index of the walkers in m_updatesList used for fast
+     * searching for the merge candidates. It must be kept in sync
+     * with the list.
+     */
+    KisUpdateWalkersSpatialIndex m_updatesIndex;
     KisSpontaneousJobsList m_spontaneousJobsList;
 
     /**
@@ -74,16 +74,24 @@ void KisSyncLodCacheStrokeStrategy::createJobsData(QVector<KisStrokeJobData *> &
     KritaUtils::makeContainerUnique(deviceList);
 
 
-    KritaUtils::addJobBarrier(jobs, [sharedData, deviceList, levelOfDetail] () mutable {
-        Q_FOREACH (KisPaintDeviceSP device, deviceList) {
-            sharedData->insert(device, toQShared(device->createLodDataStruct(levelOfDetail)));
-        }
-    });
-
-    KritaUtils::addJobSequential(jobs, [](){});
+    /**
+     * The LoD structs are created right away, because the regions that
+     * should be synced are known only after fetching the changes
+     * tracked by the devices. We are always called from a barrier job,
+     * so no concurrent updates can happen here.
+     */
+    Q_FOREACH (KisPaintDeviceSP device, deviceList) {
+        sharedData->insert(device, toQShared(device->createLodDataStruct(levelOfDetail)));
+    }
 
     Q_FOREACH (KisPaintDeviceSP device, deviceList) {
-        KisRegion region = device->regionForLodSyncing();
+        KisPaintDevice::LodDataStruct *data = sharedData->value(device).data();
+
+        /**
+         * Only the tiles changed since the previous sync are regenerated,
+         * unless the LoD plane should be regenerated from scratch
+         */
+        KisRegion region = device->regionForLodSyncing(data);
         QVector<QRect> rects = splitRegionIntoPatches(region, optimalPatchSize());
 
         Q_FOREACH (const QRect &rc, rects) {
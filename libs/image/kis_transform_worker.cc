@@ -14,6 +14,9 @@
 #include <klocalizedstring.h>
 
 #include <QTransform>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtConcurrent>
 
 #include <KoColorSpace.h>
 #include <KoCompositeOpRegistry.h>
@@ -183,6 +186,15 @@ void updateBounds<KisVLineIteratorSP>(QRect &boundRect, const KisFilterWeightsAp
     boundRect.setHeight(newBounds.size());
 }
 
+namespace {
+/**
+ * The lines of a transformation pass are grouped into bands of this
+ * size. The value is a multiple of the tile size, so the bands never
+ * write into the same tile concurrently.
+ */
+const int transformPassBandSize = 64;
+}
+
 template <class T>
 void KisTransformWorker::transformPass(KisPaintDevice *src, KisPaintDevice *dst,
                                        double floatscale, double shear, double dx,
@@ -195,19 +207,59 @@ void KisTransformWorker::transformPass(KisPaintDevice *src, KisPaintDevice *dst,
     calcDimensions<T>(m_boundRect, srcStart, srcLen, firstLine, numLines);
 
     KisProgressUpdateHelper progressHelper(m_progressUpdater, portion, numLines);
+
+    /**
+     * The weights buffer is read-only after construction, so it is
+     * shared between all the threads
+     */
     KisFilterWeightsBuffer buf(filterStrategy, qAbs(floatscale));
-    KisFilterWeightsApplicator applicator(src, dst, floatscale, shear, dx, clampToEdge);
+    const qreal filterSupport = filterStrategy->support(buf.weightsPositionScale().toFloat());
 
-    KisFilterWeightsApplicator::LinePos dstBounds;
+    /**
+     * Every line is read and written back independently from the other
+     * lines, so the bands of lines are processed in parallel. The
+     * resulting positions are stored per-line and united in the original
+     * order afterwards to get exactly the same bounds as the sequential
+     * pass does.
+     */
+    QVector<KisFilterWeightsApplicator::LinePos> dstLines(numLines);
 
-    for (int i = firstLine; i < firstLine + numLines; i++) {
-        KisFilterWeightsApplicator::LinePos dstPos;
-        KisFilterWeightsApplicator::LinePos srcPos(srcStart, srcLen);
+    QVector<QPair<int, int>> bands;
+    for (int start = firstLine; start < firstLine + numLines;) {
+        const int alignedEnd =
+            (qFloor(qreal(start) / transformPassBandSize) + 1) * transformPassBandSize;
+        const int end = qMin(alignedEnd, firstLine + numLines);
 
-        dstPos = applicator.processLine<T>(srcPos, i, &buf, filterStrategy->support(buf.weightsPositionScale().toFloat()));
-        dstBounds.unite(dstPos);
+        bands.append(qMakePair(start, end));
+        start = end;
+    }
 
-        progressHelper.step();
+    QMutex progressMutex;
+
+    auto processBand =
+        [&] (const QPair<int, int> &band) {
+            KisFilterWeightsApplicator applicator(src, dst, floatscale, shear, dx, clampToEdge);
+
+            for (int i = band.first; i < band.second; i++) {
+                KisFilterWeightsApplicator::LinePos srcPos(srcStart, srcLen);
+                dstLines[i - firstLine] = applicator.processLine<T>(srcPos, i, &buf, filterSupport);
+            }
+
+            QMutexLocker l(&progressMutex);
+            for (int i = band.first; i < band.second; i++) {
+                progressHelper.step();
+            }
+        };
+
+    if (bands.size() > 1) {
+        QtConcurrent::blockingMap(bands, processBand);
+    } else if (!bands.isEmpty()) {
+        processBand(bands.first());
+    }
+
+    KisFilterWeightsApplicator::LinePos dstBounds;
+    Q_FOREACH (const KisFilterWeightsApplicator::LinePos &dstPos, dstLines) {
+        dstBounds.unite(dstPos);
     }
 
     updateBounds<T>(m_boundRect, dstBounds);
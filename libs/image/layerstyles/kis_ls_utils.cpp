@@ -106,7 +106,8 @@ namespace KisLsUtils
         KisGaussianKernel::applyGaussian(selection, applyRect,
                                          radius, radius,
                                          QBitArray(), 0, true,
-                                         BORDER_IGNORE);
+                                         BORDER_IGNORE,
+                                         KisGaussianKernel::Auto);
     }
 
     namespace Private {
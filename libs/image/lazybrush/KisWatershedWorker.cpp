@@ -21,8 +21,11 @@
 #include "kis_scanline_fill.h"
 
 #include "kis_random_accessor_ng.h"
+#include "kis_algebra_2d.h"
 
-#include <boost/heap/fibonacci_heap.hpp>
+#include <QtConcurrent>
+
+#include <array>
 #include <set>
 
 using namespace KisLazyFillTools;
@@ -122,13 +125,136 @@ struct TaskPoint {
     quint8 level = 0;
 };
 
-struct CompareTaskPoints {
-    bool operator()(const TaskPoint &pt1, const TaskPoint &pt2) const {
-        return
-            pt1.level > pt2.level || (pt1.level == pt2.level && pt1.distance > pt2.distance);
+/**
+ * A hierarchical queue of the flooding points. The points are ordered
+ * by their level first and by the distance from the border of their
+ * plateau second. Every (level, distance) pair has its own FIFO
+ * bucket, so the points with equal priority are popped in the same
+ * order they were pushed. That makes the result of the flooding
+ * independent from the implementation of the queue, which is not the
+ * case for a heap.
+ *
+ * All the operations take amortized constant time. The levels are
+ * not popped monotonically (a point of a lower level may be pushed
+ * at any moment), so the queue tracks the minimal non-empty level and
+ * the minimal non-empty distance inside every level.
+ */
+class HierarchicalPointsQueue
+{
+public:
+    HierarchicalPointsQueue()
+    {
+        std::fill(m_levelSizes.begin(), m_levelSizes.end(), 0);
+        std::fill(m_minDistances.begin(), m_minDistances.end(), 0);
+    }
+
+    bool empty() const {
+        return !m_size;
+    }
+
+    void push(const TaskPoint &pt) {
+        std::vector<Bucket> &buckets = m_levels[pt.level];
+
+        if (int(buckets.size()) <= pt.distance) {
+            buckets.resize(pt.distance + 1);
+        }
+
+        buckets[pt.distance].points.push_back(pt);
+
+        int &levelSize = m_levelSizes[pt.level];
+        int &minDistance = m_minDistances[pt.level];
+
+        if (!levelSize || pt.distance < minDistance) {
+            minDistance = pt.distance;
+        }
+
+        if (pt.level < m_minLevel) {
+            m_minLevel = pt.level;
+        }
+
+        levelSize++;
+        m_size++;
+    }
+
+    TaskPoint pop() {
+        KIS_SAFE_ASSERT_RECOVER(m_size > 0) { return TaskPoint(); }
+
+        while (!m_levelSizes[m_minLevel]) {
+            m_minLevel++;
+        }
+
+        std::vector<Bucket> &buckets = m_levels[m_minLevel];
+        int &minDistance = m_minDistances[m_minLevel];
+
+        while (buckets[minDistance].head == buckets[minDistance].points.size()) {
+            minDistance++;
+        }
+
+        Bucket &bucket = buckets[minDistance];
+        const TaskPoint pt = bucket.points[bucket.head++];
+
+        if (bucket.head == bucket.points.size()) {
+            // keep the allocated memory for the next points
+            bucket.points.clear();
+            bucket.head = 0;
+        }
+
+        m_levelSizes[m_minLevel]--;
+        m_size--;
+
+        return pt;
     }
+
+private:
+    struct Bucket {
+        std::vector<TaskPoint> points;
+        size_t head = 0;
+    };
+
+    std::array<std::vector<Bucket>, 256> m_levels;
+    std::array<int, 256> m_levelSizes;
+    std::array<int, 256> m_minDistances;
+    int m_minLevel = 256;
+    int m_size = 0;
 };
 
+/**
+ * The size of the bands the per-pixel passes of the worker are split
+ * into. The value is a multiple of the tile size, so the bands never
+ * write into the same tile concurrently.
+ */
+const int watershedBandSize = 64;
+
+/**
+ * Splits \p rc into horizontal bands aligned to the tiles grid. The
+ * bands are returned in the top-to-bottom order.
+ */
+QVector<QRect> splitIntoBands(const QRect &rc)
+{
+    QVector<QRect> bands;
+
+    for (int y = rc.top(); y <= rc.bottom();) {
+        const int alignedEnd =
+            (KisAlgebra2D::divideFloor(y, watershedBandSize) + 1) * watershedBandSize;
+        const int end = qMin(alignedEnd, rc.bottom() + 1);
+
+        bands << QRect(rc.left(), y, rc.width(), end - y);
+        y = end;
+    }
+
+    return bands;
+}
+
+template <typename T, typename Func>
+void processInParallel(QVector<T> &items, Func func)
+{
+    if (items.size() > 1) {
+        QtConcurrent::blockingMap(items, func);
+    } else if (!items.isEmpty()) {
+        func(items.first());
+    }
+}
+
 /**
  * Adjusts the stroke device in a way that all the stroke's pixels
  * are set to the range 1...255, according to the height of this pixel
@@ -136,20 +262,25 @@ struct CompareTaskPoints {
  */
 void mergeHeightmapOntoStroke(KisPaintDeviceSP stroke, KisPaintDeviceSP heightMap, const QRect &rc)
 {
-    KisSequentialIterator dstIt(stroke, rc);
-    KisSequentialConstIterator mapIt(heightMap, rc);
+    QVector<QRect> bands = splitIntoBands(rc);
 
-    while (dstIt.nextPixel() && mapIt.nextPixel()) {
-        quint8 *dstPtr = dstIt.rawData();
+    processInParallel(bands,
+        [&] (const QRect &band) {
+            KisSequentialIterator dstIt(stroke, band);
+            KisSequentialConstIterator mapIt(heightMap, band);
 
-        if (*dstPtr > 0) {
-            const quint8 *mapPtr = mapIt.rawDataConst();
-            *dstPtr = qMax(quint8(1), *mapPtr);
-        } else {
-            *dstPtr = 0;
-        }
+            while (dstIt.nextPixel() && mapIt.nextPixel()) {
+                quint8 *dstPtr = dstIt.rawData();
 
-    }
+                if (*dstPtr > 0) {
+                    const quint8 *mapPtr = mapIt.rawDataConst();
+                    *dstPtr = qMax(quint8(1), *mapPtr);
+                } else {
+                    *dstPtr = 0;
+                }
+
+            }
+        });
 }
 
 void parseColorIntoGroups(QVector<FillGroup> &groups,
@@ -184,8 +315,6 @@ void parseColorIntoGroups(QVector<FillGroup> &groups,
     }
 }
 
-using PointsPriorityQueue = boost::heap::fibonacci_heap<TaskPoint, boost::heap::compare<CompareTaskPoints>>;
-
 }
 
 /***********************************************************************/
@@ -194,8 +323,6 @@ using PointsPriorityQueue = boost::heap::fibonacci_heap<TaskPoint, boost::heap::
 
 struct KisWatershedWorker::Private
 {
-    Private() : pointsQueue(pointsComparator) {}
-
     KisPaintDeviceSP heightMap;
     KisPaintDeviceSP dstDevice;
 
@@ -205,8 +332,7 @@ struct KisWatershedWorker::Private
     QVector<FillGroup> groups;
     KisPaintDeviceSP groupsMap;
 
-    CompareTaskPoints pointsComparator;
-    PointsPriorityQueue pointsQueue;
+    HierarchicalPointsQueue pointsQueue;
 
     // temporary "global" variables for the processing routines
     KisRandomAccessorSP groupIt;
@@ -277,20 +403,25 @@ void KisWatershedWorker::addKeyStroke(KisPaintDeviceSP dev, const KoColor &color
         const QRect rc = dev->exactBounds() & lastDev->exactBounds();
         if (rc.isEmpty()) continue;
 
-        KisSequentialIterator devIt(dev, rc);
-        KisSequentialConstIterator lastDevIt(lastDev, rc);
+        QVector<QRect> bands = splitIntoBands(rc);
 
-        while (devIt.nextPixel() &&
-               lastDevIt.nextPixel()) {
+        processInParallel(bands,
+            [&] (const QRect &band) {
+                KisSequentialIterator devIt(dev, band);
+                KisSequentialConstIterator lastDevIt(lastDev, band);
 
-            quint8 *devPtr = devIt.rawData();
-            const quint8 *lastDevPtr = lastDevIt.rawDataConst();
+                while (devIt.nextPixel() &&
+                       lastDevIt.nextPixel()) {
 
-            if (*devPtr > 0 && *lastDevPtr > 0) {
-                *devPtr = 0;
-            }
+                    quint8 *devPtr = devIt.rawData();
+                    const quint8 *lastDevPtr = lastDevIt.rawDataConst();
 
-        }
+                    if (*devPtr > 0 && *lastDevPtr > 0) {
+                        *devPtr = 0;
+                    }
+
+                }
+            });
     }
 }
 
@@ -372,28 +503,54 @@ void KisWatershedWorker::testingTryRemoveGroup(qint32 group, quint8 levelIndex)
 
 void KisWatershedWorker::Private::initializeQueueFromGroupMap(const QRect &rc)
 {
-    KisSequentialIterator groupMapIt(groupsMap, rc);
-    KisSequentialConstIterator heightMapIt(heightMap, rc);
+    struct BandPoints {
+        QRect rect;
+        QVector<TaskPoint> points;
+    };
 
-    while (groupMapIt.nextPixel() &&
-           heightMapIt.nextPixel()) {
+    QVector<BandPoints> bands;
+    Q_FOREACH (const QRect &bandRect, splitIntoBands(rc)) {
+        BandPoints band;
+        band.rect = bandRect;
+        bands << band;
+    }
 
-        qint32 *groupPtr = reinterpret_cast<qint32*>(groupMapIt.rawData());
-        const quint8 *heightPtr = heightMapIt.rawDataConst();
+    processInParallel(bands,
+        [this] (BandPoints &band) {
+            KisSequentialIterator groupMapIt(groupsMap, band.rect);
+            KisSequentialConstIterator heightMapIt(heightMap, band.rect);
 
-        if (*groupPtr > 0) {
-            TaskPoint pt;
-            pt.x = groupMapIt.x();
-            pt.y = groupMapIt.y();
-            pt.group = *groupPtr;
-            pt.level = *heightPtr;
+            while (groupMapIt.nextPixel() &&
+                   heightMapIt.nextPixel()) {
 
-            pointsQueue.push(pt);
+                qint32 *groupPtr = reinterpret_cast<qint32*>(groupMapIt.rawData());
+                const quint8 *heightPtr = heightMapIt.rawDataConst();
 
-            // we must clear the pixel to make sure foreign metric is calculated correctly
-            *groupPtr = 0;
-        }
+                if (*groupPtr > 0) {
+                    TaskPoint pt;
+                    pt.x = groupMapIt.x();
+                    pt.y = groupMapIt.y();
+                    pt.group = *groupPtr;
+                    pt.level = *heightPtr;
 
+                    band.points.append(pt);
+
+                    // we must clear the pixel to make sure foreign metric is calculated correctly
+                    *groupPtr = 0;
+                }
+
+            }
+        });
+
+    /**
+     * The order of the points with equal priority defines the result
+     * of the flooding, so they are pushed into the queue in the same
+     * (row-major) order as the sequential scan would do
+     */
+    Q_FOREACH (const BandPoints &band, bands) {
+        Q_FOREACH (const TaskPoint &pt, band.points) {
+            pointsQueue.push(pt);
+        }
     }
 }
 
@@ -643,8 +800,7 @@ void KisWatershedWorker::Private::processQueue(qint32 _backgroundGroupId)
     }
 
     while (!pointsQueue.empty()) {
-        TaskPoint pt = pointsQueue.top();
-        pointsQueue.pop();
+        const TaskPoint pt = pointsQueue.pop();
 
         groupIt->moveTo(pt.x, pt.y);
         qint32 *groupPtr = reinterpret_cast<qint32*>(groupIt->rawData());
@@ -711,9 +867,6 @@ void KisWatershedWorker::Private::processQueue(qint32 _backgroundGroupId)
 
 void KisWatershedWorker::Private::writeColoring()
 {
-    KisSequentialConstIterator srcIt(groupsMap, boundingRect);
-    KisSequentialIterator dstIt(dstDevice, boundingRect);
-
     QVector<KoColor> colors;
     for (auto it = keyStrokes.begin(); it != keyStrokes.end(); ++it) {
         KoColor color = it->color;
@@ -722,16 +875,26 @@ void KisWatershedWorker::Private::writeColoring()
     }
     const int colorPixelSize = dstDevice->pixelSize();
 
+    // the groups are only read by the threads
+    const QVector<FillGroup> &constGroups = groups;
 
-    while (srcIt.nextPixel() && dstIt.nextPixel()) {
-        const qint32 *srcPtr = reinterpret_cast<const qint32*>(srcIt.rawDataConst());
+    QVector<QRect> bands = splitIntoBands(boundingRect);
 
-        const int colorIndex = groups[*srcPtr].colorIndex;
-        if (colorIndex >= 0) {
-            memcpy(dstIt.rawData(), colors[colorIndex].data(), colorPixelSize);
-        }
+    processInParallel(bands,
+        [&] (const QRect &band) {
+            KisSequentialConstIterator srcIt(groupsMap, band);
+            KisSequentialIterator dstIt(dstDevice, band);
 
-    }
+            while (srcIt.nextPixel() && dstIt.nextPixel()) {
+                const qint32 *srcPtr = reinterpret_cast<const qint32*>(srcIt.rawDataConst());
+
+                const int colorIndex = constGroups[*srcPtr].colorIndex;
+                if (colorIndex >= 0) {
+                    memcpy(dstIt.rawData(), colors.at(colorIndex).data(), colorPixelSize);
+                }
+
+            }
+        });
 }
 
 QVector<TaskPoint> KisWatershedWorker::Private::tryRemoveConflictingPlane(qint32 group, quint8 level)
@@ -125,10 +125,26 @@ struct KisColorizeMask::Private
 
     bool limitToDeviceBounds = false;
 
+    /**
+     * The copies of the key strokes the current coloring was generated
+     * from. When only the key strokes have changed since then, the
+     * coloring is recalculated in the affected regions only.
+     */
+    QVector<KeyStroke> coloringKeyStrokes;
+    QVector<KeyStroke> pendingColoringKeyStrokes;
+    QRect coloringBounds;
+    QRect pendingColoringBounds;
+    FilteringOptions coloringFilteringOptions;
+    FilteringOptions pendingColoringFilteringOptions;
+    QPoint coloringOffset;
+    int coloringSequenceNumber = -1;
+
     bool filteredSourceValid(KisPaintDeviceSP parentDevice) {
         return !filteringDirty && originalSequenceNumber == parentDevice->sequenceNumber();
     }
 
+    bool canUpdateColoringIncrementally(const QRect &fillBounds) const;
+
     void setNeedsUpdateImpl(bool value, bool requestedByUser);
 
     bool shouldShowFilteredSource() const;
@@ -311,6 +327,29 @@ void KisColorizeMask::Private::setNeedsUpdateImpl(bool value, bool requestedByUs
     }
 }
 
+bool KisColorizeMask::Private::canUpdateColoringIncrementally(const QRect &fillBounds) const
+{
+    if (coloringKeyStrokes.isEmpty() ||
+        coloringKeyStrokes.size() != keyStrokes.size() ||
+        coloringBounds != fillBounds ||
+        coloringFilteringOptions != filteringOptions ||
+        coloringOffset != QPoint(coloringProjection->x(), coloringProjection->y()) ||
+        coloringSequenceNumber != coloringProjection->sequenceNumber()) {
+
+        return false;
+    }
+
+    for (int i = 0; i < keyStrokes.size(); i++) {
+        if (!(coloringKeyStrokes[i].color == keyStrokes[i].color) ||
+            coloringKeyStrokes[i].isTransparent != keyStrokes[i].isTransparent) {
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void KisColorizeMask::slotUpdateRegenerateFilling(bool prefilterOnly)
 {
     KisPaintDeviceSP src = parent()->original();
@@ -320,19 +359,12 @@ void KisColorizeMask::slotUpdateRegenerateFilling(bool prefilterOnly)
     m_d->originalSequenceNumber = src->sequenceNumber();
     m_d->filteringDirty = false;
 
-    if (!prefilterOnly) {
-        m_d->coloringProjection->clear();
-    }
-
     KisLayerSP parentLayer(qobject_cast<KisLayer*>(parent().data()));
-    if (!parentLayer) return;
+    KisImageSP image = parentLayer ? parentLayer->image() : KisImageSP();
 
-    KisImageSP image = parentLayer->image();
-    if (image) {
-        m_d->updateIsRunning = true;
-
-        QRect fillBounds;
+    QRect fillBounds;
 
+    if (image) {
         if (m_d->limitToDeviceBounds) {
             fillBounds |= src->exactBounds();
             Q_FOREACH (const KeyStroke &stroke, m_d->keyStrokes) {
@@ -342,6 +374,34 @@ void KisColorizeMask::slotUpdateRegenerateFilling(bool prefilterOnly)
         } else {
             fillBounds = image->bounds();
         }
+    }
+
+    const bool updateIncrementally =
+        !prefilterOnly &&
+        filteredSourceValid &&
+        m_d->canUpdateColoringIncrementally(fillBounds);
+
+    const QVector<KeyStroke> previousColoringKeyStrokes = m_d->coloringKeyStrokes;
+
+    if (!prefilterOnly) {
+        if (!updateIncrementally) {
+            m_d->coloringProjection->clear();
+        }
+
+        // the coloring cannot be reused until the update is finished
+        m_d->pendingColoringKeyStrokes.clear();
+        Q_FOREACH (const KeyStroke &stroke, m_d->keyStrokes) {
+            m_d->pendingColoringKeyStrokes << KeyStroke(KisPaintDeviceSP(new KisPaintDevice(*stroke.dev)), stroke.color, stroke.isTransparent);
+        }
+        m_d->pendingColoringBounds = fillBounds;
+        m_d->pendingColoringFilteringOptions = m_d->filteringOptions;
+        m_d->coloringKeyStrokes.clear();
+    }
+
+    if (!parentLayer) return;
+
+    if (image) {
+        m_d->updateIsRunning = true;
 
         m_d->filteredDeviceBounds = fillBounds;
 
@@ -356,6 +416,10 @@ void KisColorizeMask::slotUpdateRegenerateFilling(bool prefilterOnly)
 
         strategy->setFilteringOptions(m_d->filteringOptions);
 
+        if (updateIncrementally) {
+            strategy->setPreviousKeyStrokes(previousColoringKeyStrokes);
+        }
+
         Q_FOREACH (const KeyStroke &stroke, m_d->keyStrokes) {
             const KoColor color =
                 !stroke.isTransparent ?
@@ -409,6 +473,13 @@ void KisColorizeMask::slotRegenerationFinished(bool prefilterOnly)
 
     if (!prefilterOnly) {
         m_d->setNeedsUpdateImpl(false, false);
+
+        m_d->coloringKeyStrokes = m_d->pendingColoringKeyStrokes;
+        m_d->coloringBounds = m_d->pendingColoringBounds;
+        m_d->coloringFilteringOptions = m_d->pendingColoringFilteringOptions;
+        m_d->coloringOffset = QPoint(m_d->coloringProjection->x(), m_d->coloringProjection->y());
+        m_d->coloringSequenceNumber = m_d->coloringProjection->sequenceNumber();
+        m_d->pendingColoringKeyStrokes.clear();
     }
 
     QRect oldExtent;
@@ -8,7 +8,10 @@
 
 #include <QBitArray>
 
+#include <KoColorSpaceRegistry.h>
+
 #include "krita_utils.h"
+#include "kis_global.h"
 #include "kis_paint_device.h"
 #include "kis_lazy_fill_tools.h"
 #include "kis_gaussian_kernel.h"
@@ -38,6 +41,7 @@ struct KisColorizeStrokeStrategy::Private
         , filteredSource(rhs.filteredSource)
         , internalFilteredSource(rhs.internalFilteredSource)
         , filteredSourceValid(rhs.filteredSourceValid)
+        , dstIsCleared(rhs.dstIsCleared)
         , boundingRect(rhs.boundingRect)
         , prefilterOnly(rhs.prefilterOnly)
         , levelOfDetail(_levelOfDetail)
@@ -53,6 +57,7 @@ struct KisColorizeStrokeStrategy::Private
     KisPaintDeviceSP heightMap;
     KisPaintDeviceSP internalFilteredSource;
     bool filteredSourceValid;
+    bool dstIsCleared = true;
     QRect boundingRect;
 
     bool prefilterOnly = false;
@@ -60,6 +65,13 @@ struct KisColorizeStrokeStrategy::Private
 
     QVector<KeyStroke> keyStrokes;
 
+    /**
+     * The previous key strokes are not passed to the LoD clone, their
+     * devices don't have the LoD planes. The clone recalculates
+     * everything instead.
+     */
+    QVector<KeyStroke> previousKeyStrokes;
+
     // default values: disabled
     FilteringOptions filteringOptions;
 };
@@ -121,6 +133,12 @@ void KisColorizeStrokeStrategy::addKeyStroke(KisPaintDeviceSP dev, const KoColor
     m_d->keyStrokes << KeyStroke(dev, convertedColor);
 }
 
+void KisColorizeStrokeStrategy::setPreviousKeyStrokes(const QVector<KeyStroke> &strokes)
+{
+    m_d->previousKeyStrokes = strokes;
+    m_d->dstIsCleared = false;
+}
+
 void KisColorizeStrokeStrategy::initStrokeCallback()
 {
     using namespace KritaUtils;
@@ -238,15 +256,48 @@ void KisColorizeStrokeStrategy::initStrokeCallback()
         }
 
         addJobSequential(jobs, [this] () {
-            m_d->progressHelper.reset(new KisProcessingVisitor::ProgressHelper(m_d->progressNode));
-
-            KisWatershedWorker worker(m_d->heightMap, m_d->dst, m_d->boundingRect, m_d->progressHelper->updater());
+            QVector<KeyStroke> keyStrokes;
             Q_FOREACH (const KeyStroke &stroke, m_d->keyStrokes) {
                 KoColor color =
                     !stroke.isTransparent ?
                         stroke.color : KoColor(Qt::transparent, m_d->dst->colorSpace());
 
-                worker.addKeyStroke(stroke.dev, color);
+                keyStrokes << KeyStroke(stroke.dev, color);
+            }
+
+            QRect workerRect = m_d->boundingRect;
+
+            if (!m_d->previousKeyStrokes.isEmpty() &&
+                m_d->previousKeyStrokes.size() == keyStrokes.size()) {
+
+                KisPaintDeviceSP changedPixels =
+                    new KisPaintDevice(KoColorSpaceRegistry::instance()->alpha8());
+
+                for (int i = 0; i < keyStrokes.size(); i++) {
+                    markChangedKeyStrokePixels(m_d->previousKeyStrokes[i].dev,
+                                               keyStrokes[i].dev,
+                                               changedPixels);
+                }
+
+                const QRect affectedRect =
+                    calculateAffectedColoringRect(m_d->dst, changedPixels, m_d->boundingRect);
+
+                // the key strokes have not changed, the coloring is up to date
+                if (affectedRect.isEmpty()) return;
+
+                workerRect = kisGrowRect(affectedRect, 1) & m_d->boundingRect;
+                keyStrokes = prepareKeyStrokesForRect(keyStrokes, m_d->dst, affectedRect, workerRect);
+                m_d->dst->clear(affectedRect);
+
+            } else if (!m_d->dstIsCleared) {
+                m_d->dst->clear(m_d->boundingRect);
+            }
+
+            m_d->progressHelper.reset(new KisProcessingVisitor::ProgressHelper(m_d->progressNode));
+
+            KisWatershedWorker worker(m_d->heightMap, m_d->dst, workerRect, m_d->progressHelper->updater());
+            Q_FOREACH (const KeyStroke &stroke, keyStrokes) {
+                worker.addKeyStroke(stroke.dev, stroke.color);
             }
             worker.run(m_d->filteringOptions.cleanUpAmount);
             m_d->progressHelper.reset();
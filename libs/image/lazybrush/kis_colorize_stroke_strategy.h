@@ -17,6 +17,7 @@ class KoColor;
 
 namespace KisLazyFillTools {
 struct FilteringOptions;
+struct KeyStroke;
 }
 
 
@@ -40,6 +41,16 @@ public:
 
     void addKeyStroke(KisPaintDeviceSP dev, const KoColor &color);
 
+    /**
+     * Enables incremental recalculation of the coloring. \p strokes
+     * are the key strokes the current content of \p dst was generated
+     * from, in the same order and with the same colors as the ones
+     * added with addKeyStroke(). Only the regions of \p dst touched by
+     * the changed pixels of the key strokes are recalculated, the rest
+     * of \p dst is kept untouched.
+     */
+    void setPreviousKeyStrokes(const QVector<KisLazyFillTools::KeyStroke> &strokes);
+
     void initStrokeCallback() override;
     void cancelStrokeCallback() override;
     void tryCancelCurrentStrokeJobAsync() override;
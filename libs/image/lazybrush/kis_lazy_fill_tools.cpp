@@ -26,6 +26,9 @@
 #include "lazybrush/kis_lazy_fill_capacity_map.h"
 
 #include "kis_sequential_iterator.h"
+#include "kis_random_accessor_ng.h"
+#include "kis_painter.h"
+#include "kis_pixel_selection.h"
 #include <floodfill/kis_scanline_fill.h>
 
 #include "krita_utils.h"
@@ -167,6 +170,118 @@ QVector<QPoint> splitIntoConnectedComponents(KisPaintDeviceSP dev,
 }
 
 
+void markChangedKeyStrokePixels(KisPaintDeviceSP oldStroke,
+                                KisPaintDeviceSP newStroke,
+                                KisPaintDeviceSP changedPixels)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(oldStroke->pixelSize() == 1);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(newStroke->pixelSize() == 1);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(changedPixels->pixelSize() == 1);
+
+    const QRect rect = oldStroke->exactBounds() | newStroke->exactBounds();
+    if (rect.isEmpty()) return;
+
+    KisSequentialConstIterator oldIt(oldStroke, rect);
+    KisSequentialConstIterator newIt(newStroke, rect);
+    KisSequentialIterator dstIt(changedPixels, rect);
+
+    while (oldIt.nextPixel() && newIt.nextPixel() && dstIt.nextPixel()) {
+        const bool oldCovered = *oldIt.rawDataConst() > 0;
+        const bool newCovered = *newIt.rawDataConst() > 0;
+
+        if (oldCovered != newCovered) {
+            *dstIt.rawData() = 255;
+        }
+    }
+}
+
+QRect calculateAffectedColoringRect(KisPaintDeviceSP coloring,
+                                    KisPaintDeviceSP changedPixels,
+                                    const QRect &boundingRect)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(changedPixels->pixelSize() == 1, boundingRect);
+
+    const QRect changedRect = changedPixels->exactBounds() & boundingRect;
+    if (changedRect.isEmpty()) return QRect();
+
+    KisPixelSelectionSP affectedArea = new KisPixelSelection();
+
+    /**
+     * The filler writes into the selection while we are checking it,
+     * so we must use a *writable* accessor to avoid reading a lazy
+     * copied old version of its tiles
+     */
+    KisRandomAccessorSP affectedIt = affectedArea->createRandomAccessorNG();
+    KisSequentialConstIterator changedIt(changedPixels, changedRect);
+
+    while (changedIt.nextPixel()) {
+        if (!*changedIt.rawDataConst()) continue;
+
+        const QPoint pt(changedIt.x(), changedIt.y());
+
+        affectedIt->moveTo(pt.x(), pt.y());
+        if (*affectedIt->rawDataConst()) continue;
+
+        KisScanlineFill fill(coloring, pt, boundingRect);
+        fill.setThreshold(0);
+        fill.setOpacitySpread(100);
+        fill.fillSelection(affectedArea);
+    }
+
+    return affectedArea->selectedExactRect() | changedRect;
+}
+
+QVector<KeyStroke> prepareKeyStrokesForRect(const QVector<KeyStroke> &strokes,
+                                            KisPaintDeviceSP coloring,
+                                            const QRect &rect,
+                                            const QRect &outerRect)
+{
+    KIS_SAFE_ASSERT_RECOVER_NOOP(outerRect.contains(rect));
+
+    QVector<KeyStroke> result;
+
+    Q_FOREACH (const KeyStroke &stroke, strokes) {
+        KisPaintDeviceSP dev = new KisPaintDevice(stroke.dev->colorSpace());
+        dev->setDefaultBounds(stroke.dev->defaultBounds());
+        KisPainter::copyAreaOptimized(outerRect.topLeft(), stroke.dev, dev, outerRect);
+
+        result << KeyStroke(dev, stroke.color, stroke.isTransparent);
+    }
+
+    const int pixelSize = coloring->pixelSize();
+    const quint8 coveredPixel = 255;
+
+    const QVector<QRect> border = {
+        QRect(outerRect.left(), outerRect.top(), outerRect.width(), rect.top() - outerRect.top()),
+        QRect(outerRect.left(), rect.bottom() + 1, outerRect.width(), outerRect.bottom() - rect.bottom()),
+        QRect(outerRect.left(), rect.top(), rect.left() - outerRect.left(), rect.height()),
+        QRect(rect.right() + 1, rect.top(), outerRect.right() - rect.right(), rect.height())
+    };
+
+    Q_FOREACH (const QRect &borderRect, border) {
+        if (borderRect.isEmpty()) continue;
+
+        KisSequentialConstIterator srcIt(coloring, borderRect);
+
+        while (srcIt.nextPixel()) {
+            const quint8 *srcPtr = srcIt.rawDataConst();
+
+            /**
+             * If no stroke has the color of the pixel (e.g. it has
+             * never been colored), it is just left for the flooding
+             */
+            for (int i = 0; i < strokes.size(); i++) {
+                if (!memcmp(srcPtr, strokes[i].color.data(), pixelSize)) {
+                    result[i].dev->writeBytes(&coveredPixel, srcIt.x(), srcIt.y(), 1, 1);
+                    break;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
 KeyStroke::KeyStroke()
     : isTransparent(false)
 {
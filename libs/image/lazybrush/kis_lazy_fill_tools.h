@@ -68,6 +68,53 @@ namespace KisLazyFillTools
         bool isTransparent;
     };
 
+    /**
+     * Marks with a non-null value in \p changedPixels all the pixels
+     * that are covered by exactly one of the key strokes \p oldStroke
+     * and \p newStroke. Only the coverage of the pixels is compared,
+     * i.e. zero or non-zero value, because this is all the watershed
+     * worker uses.
+     */
+    KRITAIMAGE_EXPORT
+    void markChangedKeyStrokePixels(KisPaintDeviceSP oldStroke,
+                                    KisPaintDeviceSP newStroke,
+                                    KisPaintDeviceSP changedPixels);
+
+    /**
+     * Returns the bounding rect of the area of \p coloring that should
+     * be recalculated after the key strokes have changed in the pixels
+     * marked in \p changedPixels. The area consists of all the contiguous
+     * regions of the same color in \p coloring containing at least one
+     * changed pixel.
+     *
+     * The regions not touched by the changed pixels are considered
+     * to be final. Strictly speaking, the watershed might recolor them
+     * as well, when the changed key stroke floods its basin through a
+     * gap in the line art, but recalculating only the touched regions
+     * is exactly what the user expects from editing a key stroke.
+     */
+    KRITAIMAGE_EXPORT
+    QRect calculateAffectedColoringRect(KisPaintDeviceSP coloring,
+                                        KisPaintDeviceSP changedPixels,
+                                        const QRect &boundingRect);
+
+    /**
+     * Prepares the key strokes for recalculating the coloring only in
+     * \p rect. Returns the copies of \p strokes cropped to \p outerRect,
+     * which should contain \p rect and be one pixel bigger than it. The
+     * pixels of \p outerRect that lie outside \p rect take the color
+     * they have in \p coloring: they are added to the stroke of the
+     * same color. The watershed worker run over \p outerRect with these
+     * strokes joins seamlessly with the coloring outside \p rect.
+     *
+     * \p strokes should have the colors in the color space of \p coloring
+     */
+    KRITAIMAGE_EXPORT
+    QVector<KeyStroke> prepareKeyStrokesForRect(const QVector<KeyStroke> &strokes,
+                                                KisPaintDeviceSP coloring,
+                                                const QRect &rect,
+                                                const QRect &outerRect);
+
     struct KRITAIMAGE_EXPORT FilteringOptions : public boost::equality_comparable<FilteringOptions>
     {
         FilteringOptions() = default;
@@ -10,6 +10,7 @@
 
 #include "kis_paint_device.h"
 #include "kis_painter.h"
+#include "kis_global.h"
 
 #include "kis_paint_device_debug_utils.h"
 
@@ -23,6 +24,11 @@
 
 #include <lazybrush/KisWatershedWorker.h>
 
+#include <QRandomGenerator>
+
+#include <queue>
+#include <tuple>
+
 inline KisPaintDeviceSP loadTestImage(const QString &name, bool convertToAlpha)
 {
     QImage image(TestUtil::fetchDataFileLazy(name));
@@ -94,13 +100,13 @@ void KisWatershedWorkerTest::testWorkerSmall()
     worker.addKeyStroke(bLabelDev, KoColor(Qt::blue, mainDev->colorSpace()));
     worker.run();
 
-    QCOMPARE(worker.testingGroupPositiveEdge(1, 0), 35);
+    QCOMPARE(worker.testingGroupPositiveEdge(1, 0), 36);
     QCOMPARE(worker.testingGroupNegativeEdge(1, 0), 0);
-    QCOMPARE(worker.testingGroupForeignEdge(1, 0), 5);
+    QCOMPARE(worker.testingGroupForeignEdge(1, 0), 6);
 
     QCOMPARE(worker.testingGroupPositiveEdge(1, 255), 3);
-    QCOMPARE(worker.testingGroupNegativeEdge(1, 255), 15);
-    QCOMPARE(worker.testingGroupForeignEdge(1, 255), 8);
+    QCOMPARE(worker.testingGroupNegativeEdge(1, 255), 16);
+    QCOMPARE(worker.testingGroupForeignEdge(1, 255), 7);
 
     QCOMPARE(worker.testingGroupPositiveEdge(2, 0), 22);
     QCOMPARE(worker.testingGroupNegativeEdge(2, 0), 0);
@@ -182,4 +188,295 @@ void KisWatershedWorkerTest::testWorkerSmallWithAllies()
     QCOMPARE(worker.testingGroupConflicts(2, 0, 3), 0);
 }
 
+namespace {
+
+KisPaintDeviceSP createAlpha8Device(const QVector<quint8> &data, const QRect &rc)
+{
+    KisPaintDeviceSP dev = new KisPaintDevice(KoColorSpaceRegistry::instance()->alpha8());
+    dev->writeBytes(data.constData(), rc);
+    return dev;
+}
+
+/**
+ * A straightforward serial priority flood, which is used as a
+ * reference for the hierarchical queue of the worker. The points
+ * are ordered by level, then by distance from the border of the
+ * plateau, then by the order they were pushed. Returns the index of
+ * the key stroke every pixel is colored with.
+ */
+QVector<int> serialReferenceFlood(const QVector<quint8> &heightMap,
+                                  const QVector<int> &seeds,
+                                  const QRect &rc)
+{
+    struct ReferencePoint {
+        int x;
+        int y;
+        int level;
+        int distance;
+        int strokeIndex;
+        quint64 seqNo;
+
+        bool operator<(const ReferencePoint &rhs) const {
+            return std::make_tuple(level, distance, seqNo) >
+                std::make_tuple(rhs.level, rhs.distance, rhs.seqNo);
+        }
+    };
+
+    std::priority_queue<ReferencePoint> queue;
+    quint64 seqNo = 0;
+
+    QVector<int> result(rc.width() * rc.height(), -1);
+
+    for (int i = 0; i < seeds.size(); i++) {
+        if (seeds[i] >= 0) {
+            queue.push({i % rc.width(), i / rc.width(), heightMap[i], 0, seeds[i], seqNo++});
+        }
+    }
+
+    const QPoint offsets[] = {QPoint(-1, 0), QPoint(1, 0), QPoint(0, -1), QPoint(0, 1)};
+
+    while (!queue.empty()) {
+        const ReferencePoint pt = queue.top();
+        queue.pop();
+
+        const int index = pt.y * rc.width() + pt.x;
+        if (result[index] >= 0) continue;
+
+        result[index] = pt.strokeIndex;
+
+        for (const QPoint &offset : offsets) {
+            const int x = pt.x + offset.x();
+            const int y = pt.y + offset.y();
+
+            if (x < 0 || y < 0 || x >= rc.width() || y >= rc.height()) continue;
+
+            const int neighbourIndex = y * rc.width() + x;
+            if (result[neighbourIndex] >= 0) continue;
+
+            const int level = heightMap[neighbourIndex];
+            queue.push({x, y, level, level == pt.level ? pt.distance + 1 : 0, pt.strokeIndex, seqNo++});
+        }
+    }
+
+    return result;
+}
+
+}
+
+void KisWatershedWorkerTest::testFloodMatchesSerialReference_data()
+{
+    QTest::addColumn<int>("heightMapType");
+    QTest::addColumn<int>("seed");
+
+    QTest::newRow("plateaus") << 0 << 1;
+    QTest::newRow("plateaus-2") << 0 << 2;
+    QTest::newRow("noise") << 1 << 3;
+    QTest::newRow("stripes") << 2 << 4;
+}
+
+void KisWatershedWorkerTest::testFloodMatchesSerialReference()
+{
+    QFETCH(int, heightMapType);
+    QFETCH(int, seed);
+
+    QRandomGenerator random(seed);
+
+    const QRect rc(0, 0, 300, 200);
+    const int numPixels = rc.width() * rc.height();
+
+    /**
+     * The height maps contain a lot of pixels of equal level, so the
+     * result depends on the order of the points with equal priority
+     */
+    QVector<quint8> heightMap(numPixels);
+
+    for (int y = 0; y < rc.height(); y++) {
+        for (int x = 0; x < rc.width(); x++) {
+            quint8 &value = heightMap[y * rc.width() + x];
+
+            if (heightMapType == 0) {
+                value = 64 * ((x / 16 + 7 * (y / 16) + seed) % 4);
+            } else if (heightMapType == 1) {
+                value = 32 * random.bounded(8);
+            } else {
+                value = (x / 5) % 3 ? 0 : 255;
+            }
+        }
+    }
+
+    const QVector<QColor> colors = {Qt::red, Qt::green, Qt::blue};
+
+    QVector<int> seeds(numPixels, -1);
+    QVector<QVector<quint8>> strokes(colors.size(), QVector<quint8>(numPixels, 0));
+
+    for (int i = 0; i < colors.size(); i++) {
+        for (int j = 0; j < 5; j++) {
+            const QRect dab(random.bounded(rc.width()), random.bounded(rc.height()),
+                            1 + random.bounded(8), 1 + random.bounded(8));
+
+            for (int y = dab.top(); y <= dab.bottom(); y++) {
+                for (int x = dab.left(); x <= dab.right(); x++) {
+                    if (!rc.contains(x, y)) continue;
+
+                    strokes[i][y * rc.width() + x] = 255;
+
+                    // the later key strokes override the earlier ones
+                    seeds[y * rc.width() + x] = i;
+                }
+            }
+        }
+    }
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisPaintDeviceSP heightMapDev = createAlpha8Device(heightMap, rc);
+    KisPaintDeviceSP resultColoring = new KisPaintDevice(cs);
+
+    KisWatershedWorker worker(heightMapDev, resultColoring, rc);
+    for (int i = 0; i < colors.size(); i++) {
+        worker.addKeyStroke(createAlpha8Device(strokes[i], rc), KoColor(colors[i], cs));
+    }
+    worker.run();
+
+    const QVector<int> reference = serialReferenceFlood(heightMap, seeds, rc);
+
+    QVector<quint8> resultBytes(numPixels * cs->pixelSize());
+    resultColoring->readBytes(resultBytes.data(), rc);
+
+    for (int i = 0; i < numPixels; i++) {
+        const int strokeIndex = reference[i];
+        QVERIFY(strokeIndex >= 0);
+
+        const KoColor expectedColor(colors[strokeIndex], cs);
+
+        if (memcmp(resultBytes.constData() + i * cs->pixelSize(), expectedColor.data(), cs->pixelSize())) {
+            QFAIL(QString("The coloring differs from the serial flood at (%1, %2)")
+                  .arg(i % rc.width()).arg(i / rc.width()).toLatin1());
+        }
+    }
+}
+
+void KisWatershedWorkerTest::testIncrementalRecalculation()
+{
+    /**
+     * Four panels divided by a cross of "line art". The key strokes
+     * color the panels with red, green and blue, then one more green
+     * spot is added to the bottom-right panel.
+     */
+    const QRect rc(0, 0, 256, 256);
+    const QRect verticalLine(126, 0, 4, 256);
+    const QRect horizontalLine(0, 126, 256, 4);
+
+    QVector<quint8> heightMap(rc.width() * rc.height(), 0);
+
+    for (int y = 0; y < rc.height(); y++) {
+        for (int x = 0; x < rc.width(); x++) {
+            if (verticalLine.contains(x, y) || horizontalLine.contains(x, y)) {
+                heightMap[y * rc.width() + x] = 255;
+            }
+        }
+    }
+
+    KisPaintDeviceSP heightMapDev = createAlpha8Device(heightMap, rc);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace *alphaCS = KoColorSpaceRegistry::instance()->alpha8();
+
+    QVector<KisLazyFillTools::KeyStroke> oldStrokes;
+
+    oldStrokes << KisLazyFillTools::KeyStroke(new KisPaintDevice(alphaCS), KoColor(Qt::red, cs));
+    oldStrokes[0].dev->fill(QRect(30, 30, 5, 5), KoColor(Qt::black, alphaCS));
+
+    oldStrokes << KisLazyFillTools::KeyStroke(new KisPaintDevice(alphaCS), KoColor(Qt::green, cs));
+    oldStrokes[1].dev->fill(QRect(200, 30, 5, 5), KoColor(Qt::black, alphaCS));
+
+    oldStrokes << KisLazyFillTools::KeyStroke(new KisPaintDevice(alphaCS), KoColor(Qt::blue, cs));
+    oldStrokes[2].dev->fill(QRect(30, 200, 5, 5), KoColor(Qt::black, alphaCS));
+    oldStrokes[2].dev->fill(QRect(200, 160, 5, 5), KoColor(Qt::black, alphaCS));
+
+    QVector<KisLazyFillTools::KeyStroke> newStrokes;
+    Q_FOREACH (const KisLazyFillTools::KeyStroke &stroke, oldStrokes) {
+        newStrokes << KisLazyFillTools::KeyStroke(new KisPaintDevice(*stroke.dev), stroke.color);
+    }
+    newStrokes[1].dev->fill(QRect(200, 230, 5, 5), KoColor(Qt::black, alphaCS));
+
+    auto runWorker = [heightMapDev] (KisPaintDeviceSP dst,
+                                     const QVector<KisLazyFillTools::KeyStroke> &strokes,
+                                     const QRect &rect) {
+        KisWatershedWorker worker(heightMapDev, dst, rect);
+        Q_FOREACH (const KisLazyFillTools::KeyStroke &stroke, strokes) {
+            worker.addKeyStroke(stroke.dev, stroke.color);
+        }
+        worker.run();
+    };
+
+    KisPaintDeviceSP oldColoring = new KisPaintDevice(cs);
+    runWorker(oldColoring, oldStrokes, rc);
+
+    KisPaintDeviceSP fullColoring = new KisPaintDevice(cs);
+    runWorker(fullColoring, newStrokes, rc);
+
+    // recalculate the coloring the same way KisColorizeStrokeStrategy does
+    KisPaintDeviceSP changedPixels = new KisPaintDevice(alphaCS);
+    for (int i = 0; i < oldStrokes.size(); i++) {
+        KisLazyFillTools::markChangedKeyStrokePixels(oldStrokes[i].dev, newStrokes[i].dev, changedPixels);
+    }
+
+    QCOMPARE(changedPixels->exactBounds(), QRect(200, 230, 5, 5));
+
+    const QRect affectedRect =
+        KisLazyFillTools::calculateAffectedColoringRect(oldColoring, changedPixels, rc);
+
+    // only the blue regions below the horizontal line are affected
+    QVERIFY(affectedRect.contains(QRect(131, 131, 125, 125)));
+    QVERIFY(affectedRect.top() > horizontalLine.top());
+
+    const QRect workerRect = kisGrowRect(affectedRect, 1) & rc;
+
+    KisPaintDeviceSP incrementalColoring = new KisPaintDevice(*oldColoring);
+    const QVector<KisLazyFillTools::KeyStroke> preparedStrokes =
+        KisLazyFillTools::prepareKeyStrokesForRect(newStrokes, incrementalColoring, affectedRect, workerRect);
+    incrementalColoring->clear(affectedRect);
+    runWorker(incrementalColoring, preparedStrokes, workerRect);
+
+    const int pixelSize = cs->pixelSize();
+    const int numPixels = rc.width() * rc.height();
+
+    QVector<quint8> oldBytes(numPixels * pixelSize);
+    QVector<quint8> fullBytes(numPixels * pixelSize);
+    QVector<quint8> incrementalBytes(numPixels * pixelSize);
+
+    oldColoring->readBytes(oldBytes.data(), rc);
+    fullColoring->readBytes(fullBytes.data(), rc);
+    incrementalColoring->readBytes(incrementalBytes.data(), rc);
+
+    for (int i = 0; i < numPixels; i++) {
+        const QPoint pt(i % rc.width(), i / rc.width());
+        const quint8 *incrementalPtr = incrementalBytes.constData() + i * pixelSize;
+
+        // the coloring outside the affected area is not touched
+        if (!affectedRect.contains(pt)) {
+            QVERIFY2(!memcmp(incrementalPtr, oldBytes.constData() + i * pixelSize, pixelSize),
+                     QString("The pixel outside the affected area has changed at (%1, %2)")
+                     .arg(pt.x()).arg(pt.y()).toLatin1());
+        }
+
+        /**
+         * The panels are flooded at level 0 before any pixel of
+         * the line art is touched, so their coloring doesn't depend
+         * on the area the worker is run over. The pixels of the line
+         * art itself are shared by the competing basins, so they are
+         * not compared.
+         */
+        if (!heightMap[i]) {
+            QVERIFY2(!memcmp(incrementalPtr, fullBytes.constData() + i * pixelSize, pixelSize),
+                     QString("The coloring differs from the full recalculation at (%1, %2)")
+                     .arg(pt.x()).arg(pt.y()).toLatin1());
+        }
+    }
+
+    // the new spot should have the color of its key stroke
+    QCOMPARE(incrementalColoring->pixel(QPoint(202, 232)), KoColor(Qt::green, cs));
+}
+
 SIMPLE_TEST_MAIN(KisWatershedWorkerTest)
@@ -17,6 +17,11 @@ private Q_SLOTS:
 
     void testWorkerSmall();
     void testWorkerSmallWithAllies();
+
+    void testFloodMatchesSerialReference_data();
+    void testFloodMatchesSerialReference();
+
+    void testIncrementalRecalculation();
 };
 
 #endif // KISWATERSHEDWORKERTEST_H
@@ -250,6 +250,66 @@ void KisCageTransformWorkerTest::testUnityGreenCoordinates()
         newPoints << cage.transformedPoint(i, transfPoints);
         QCOMPARE(points[i], newPoints.last());
     }
+
+    QCOMPARE(cage.transformedPoints(transfPoints), newPoints);
+}
+
+void KisCageTransformWorkerTest::testReusePreparedTransform()
+{
+    QImage image(TestUtil::fetchDataFileLazy("test_cage_transform.png"));
+    image = image.convertToFormat(QImage::Format_ARGB32);
+
+    const QRectF bounds(image.rect());
+
+    QVector<QPointF> origPoints;
+    origPoints << bounds.topLeft();
+    origPoints << 0.5 * (bounds.topLeft() + bounds.topRight());
+    origPoints << 0.5 * (bounds.topLeft() + bounds.bottomRight());
+    origPoints << 0.5 * (bounds.topRight() + bounds.bottomRight());
+    origPoints << bounds.bottomRight();
+    origPoints << bounds.bottomLeft();
+
+    QVector<QPointF> transfPoints1 = origPoints;
+    transfPoints1[2] += QPointF(20, 10);
+
+    QVector<QPointF> transfPoints2 = origPoints;
+    transfPoints2[2] += QPointF(-15, 30);
+    transfPoints2[4] += QPointF(10, 10);
+
+    const QPointF srcOffset(0, 0);
+    const int pixelPrecision = 8;
+
+    KisCageTransformWorker firstWorker(image, srcOffset, origPoints, 0, pixelPrecision);
+    firstWorker.prepareTransform();
+    firstWorker.setTransformedCage(transfPoints1);
+
+    QPointF firstOffset;
+    firstWorker.runOnQImage(&firstOffset);
+
+    // the second drag of the handles reuses the coordinates
+    KisCageTransformWorker reusingWorker(image, srcOffset, origPoints, 0, pixelPrecision);
+    QVERIFY(reusingWorker.reusePreparedTransform(firstWorker));
+    reusingWorker.setTransformedCage(transfPoints2);
+
+    QPointF reusingOffset;
+    QImage reusingResult = reusingWorker.runOnQImage(&reusingOffset);
+
+    KisCageTransformWorker referenceWorker(image, srcOffset, origPoints, 0, pixelPrecision);
+    referenceWorker.prepareTransform();
+    referenceWorker.setTransformedCage(transfPoints2);
+
+    QPointF referenceOffset;
+    QImage referenceResult = referenceWorker.runOnQImage(&referenceOffset);
+
+    QCOMPARE(reusingOffset, referenceOffset);
+    QCOMPARE(reusingResult, referenceResult);
+
+    // the change of the original cage requires a new preparation
+    QVector<QPointF> changedOrigPoints = origPoints;
+    changedOrigPoints[2] += QPointF(5, 5);
+
+    KisCageTransformWorker changedWorker(image, srcOffset, changedOrigPoints, 0, pixelPrecision);
+    QVERIFY(!changedWorker.reusePreparedTransform(firstWorker));
 }
 
 #include "kis_algebra_2d.h"
@@ -24,6 +24,7 @@ private Q_SLOTS:
     void stressTestRandomCages();
 
     void testUnityGreenCoordinates();
+    void testReusePreparedTransform();
 
     void testTransformAsBase();
     void testAngleBetweenVectors();
@@ -204,4 +204,32 @@ void KisColorizeMaskTest::testCrop()
     QCOMPARE(strokes[2].dev->exactBounds(), QRect(0,0,5,5));
 }
 
+void KisColorizeMaskTest::testChangeCleanUpAmount()
+{
+    ColorizeMaskTester t;
+
+    // let the mask process sigFinished and remember the current key strokes
+    QTest::qWait(50);
+
+    const int oldSequenceNumber = t.mask->coloringProjection()->sequenceNumber();
+
+    // the key strokes stay the same, only the filtering options change
+    t.mask->setCleanUpAmount(1.0);
+    t.mask->forceRegenerateMask();
+    t.p.image->waitForDone();
+    QTest::qWait(50);
+
+    QVERIFY(t.mask->coloringProjection()->sequenceNumber() != oldSequenceNumber);
+
+    ColorizeMaskTester ref;
+    ref.mask->setCleanUpAmount(1.0);
+    ref.mask->forceRegenerateMask();
+    ref.p.image->waitForDone();
+
+    const QImage result = t.mask->coloringProjection()->convertToQImage(0, t.refRect);
+    const QImage expected = ref.mask->coloringProjection()->convertToQImage(0, t.refRect);
+
+    QCOMPARE(result, expected);
+}
+
 KISTEST_MAIN(KisColorizeMaskTest)
@@ -15,6 +15,7 @@ class KisColorizeMaskTest : public QObject
 private Q_SLOTS:
     void test();
     void testCrop();
+    void testChangeCleanUpAmount();
 };
 
 #endif /* __KIS_COLORIZE_MASK_TEST_H */
@@ -15,8 +15,11 @@
 #include <KoColorSpace.h>
 #include <KoColorSpaceRegistry.h>
 #include <KoColorSpaceTraits.h>
+#include <KoColorModelStandardIds.h>
 
+#include "kis_global.h"
 #include "kis_paint_device.h"
+#include "kis_sequential_iterator.h"
 #include "kis_convolution_painter.h"
 #include "kis_convolution_kernel.h"
 #include <kis_gaussian_kernel.h>
@@ -267,6 +270,200 @@ void KisConvolutionPainterTest::testAsymmSkipAlpha()
 }
 
 
+void KisConvolutionPainterTest::testSeparableKernelDetection()
+{
+    qreal offset = 0.0;
+    qreal factor = 1.0;
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, 1> column;
+    Eigen::Matrix<qreal, 1, Eigen::Dynamic> row;
+
+    KisConvolutionKernelSP sobel =
+        KisConvolutionKernel::fromMatrix(initAsymmFilter(offset, factor), offset, factor);
+    QVERIFY(sobel->isSeparable(&column, &row));
+    QVERIFY(((column * row) - *sobel->data()).cwiseAbs().maxCoeff() < 1e-9);
+
+    KisConvolutionKernelSP symm =
+        KisConvolutionKernel::fromMatrix(initSymmFilter(offset, factor), offset, factor);
+    QVERIFY(!symm->isSeparable());
+
+    QVERIFY(KisGaussianKernel::createUniform2DKernel(2.0, 3.0)->isSeparable());
+    QVERIFY(KisGaussianKernel::createHorizontalKernel(2.0)->isSeparable());
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> sharpen(3, 3);
+    sharpen <<  0, -2,   0,
+               -2,  11, -2,
+                0, -2,   0;
+    QVERIFY(!KisConvolutionKernel::fromMatrix(sharpen, 0, 3)->isSeparable());
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> zero =
+        Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic>::Zero(3, 3);
+    QVERIFY(!KisConvolutionKernel::fromMatrix(zero, 0, 1)->isSeparable());
+}
+
+void KisConvolutionPainterTest::testSeparableMatchesSpatial()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    const QRect imageRect(0, 0, 80, 70);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    srand(31524744);
+    KisSequentialIterator it(dev, imageRect);
+    while (it.nextPixel()) {
+        KoColor color(QColor(rand() % 256, rand() % 256, rand() % 256, 32 + rand() % 224), cs);
+        memcpy(it.rawData(), color.data(), cs->pixelSize());
+    }
+
+    KisDefaultBoundsBaseSP bounds = new TestUtil::TestingTimedDefaultBounds(imageRect);
+    dev->setDefaultBounds(bounds);
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, 1> column(3);
+    column << 1, 2, 1;
+    Eigen::Matrix<qreal, 1, Eigen::Dynamic> row(5);
+    row << 1, 4, 6, 4, 1;
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> matrix = column * row;
+    KisConvolutionKernelSP separableKernel = KisConvolutionKernel::fromMatrix(matrix, 0, matrix.sum());
+    QVERIFY(separableKernel->isSeparable());
+
+    /**
+     * A tiny perturbation makes the kernel non-separable, so it is
+     * processed by the generic spatial worker
+     */
+    matrix(0, 0) += 1e-4;
+    KisConvolutionKernelSP spatialKernel = KisConvolutionKernel::fromMatrix(matrix, 0, matrix.sum());
+    QVERIFY(!spatialKernel->isSeparable());
+
+    const QRect applyRect = imageRect.adjusted(5, 3, -7, -4);
+
+    KisPaintDeviceSP separableDev = new KisPaintDevice(*dev);
+    KisPaintDeviceSP spatialDev = new KisPaintDevice(*dev);
+
+    KisConvolutionPainter separablePainter(separableDev, KisConvolutionPainter::SPATIAL);
+    separablePainter.applyMatrix(separableKernel, dev, applyRect.topLeft(), applyRect.topLeft(), applyRect.size());
+
+    KisConvolutionPainter spatialPainter(spatialDev, KisConvolutionPainter::SPATIAL);
+    spatialPainter.applyMatrix(spatialKernel, dev, applyRect.topLeft(), applyRect.topLeft(), applyRect.size());
+
+    QByteArray separableData(imageRect.width() * imageRect.height() * cs->pixelSize(), 0);
+    QByteArray spatialData(separableData.size(), 0);
+
+    separableDev->readBytes((quint8*)separableData.data(), imageRect);
+    spatialDev->readBytes((quint8*)spatialData.data(), imageRect);
+
+    int maxDifference = 0;
+    for (int i = 0; i < separableData.size(); i++) {
+        maxDifference = qMax(maxDifference,
+                             qAbs(int(quint8(separableData[i])) - int(quint8(spatialData[i]))));
+    }
+
+    QVERIFY(maxDifference <= 1);
+}
+
+void KisConvolutionPainterTest::testTiledFFTWMatchesSpatial_data()
+{
+    QTest::addColumn<QString>("colorDepthId");
+    QTest::addColumn<QSize>("areaSize");
+    QTest::addColumn<int>("tolerance");
+
+    /**
+     * The areas are bigger than the maximum size of the FFT, so
+     * they are convolved in several tiles and the result crosses
+     * the seams between them. Integer color spaces are convolved in
+     * single precision.
+     */
+    QTest::newRow("u8-wide") << Integer8BitsColorDepthID.id() << QSize(2100, 24) << 1;
+    QTest::newRow("u8-tall") << Integer8BitsColorDepthID.id() << QSize(24, 2100) << 1;
+    QTest::newRow("u16-wide") << Integer16BitsColorDepthID.id() << QSize(2100, 24) << 4;
+    QTest::newRow("u16-tall") << Integer16BitsColorDepthID.id() << QSize(24, 2100) << 4;
+}
+
+void KisConvolutionPainterTest::testTiledFFTWMatchesSpatial()
+{
+    if (!KisConvolutionPainter::supportsFFTW()) {
+        QSKIP("Krita is built without FFTW");
+    }
+
+    QFETCH(QString, colorDepthId);
+    QFETCH(QSize, areaSize);
+    QFETCH(int, tolerance);
+
+    const KoColorSpace *cs =
+        KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), colorDepthId, 0);
+    QVERIFY(cs);
+
+    const QRect applyRect(QPoint(10, 10), areaSize);
+    const QRect imageRect = kisGrowRect(applyRect, 10);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    srand(73294721);
+    KisSequentialIterator it(dev, imageRect);
+    while (it.nextPixel()) {
+        KoColor color(QColor(rand() % 256, rand() % 256, rand() % 256, 255), cs);
+        memcpy(it.rawData(), color.data(), cs->pixelSize());
+    }
+
+    KisDefaultBoundsBaseSP bounds = new TestUtil::TestingTimedDefaultBounds(imageRect);
+    dev->setDefaultBounds(bounds);
+
+    /**
+     * The kernel is not symmetric and has different width and height,
+     * so any mix-up of the tile margins shifts the result
+     */
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> matrix(5, 7);
+    for (int y = 0; y < matrix.rows(); y++) {
+        for (int x = 0; x < matrix.cols(); x++) {
+            matrix(y, x) = 1 + rand() % 16;
+        }
+    }
+
+    KisConvolutionKernelSP kernel = KisConvolutionKernel::fromMatrix(matrix, 0, matrix.sum());
+    QVERIFY(!kernel->isSeparable());
+
+    KisPaintDeviceSP fftwDev = new KisPaintDevice(*dev);
+    KisPaintDeviceSP spatialDev = new KisPaintDevice(*dev);
+
+    KisConvolutionPainter fftwPainter(fftwDev, KisConvolutionPainter::FFTW);
+    fftwPainter.applyMatrix(kernel, dev, applyRect.topLeft(), applyRect.topLeft(), applyRect.size());
+
+    KisConvolutionPainter spatialPainter(spatialDev, KisConvolutionPainter::SPATIAL);
+    spatialPainter.applyMatrix(kernel, dev, applyRect.topLeft(), applyRect.topLeft(), applyRect.size());
+
+    const int numPixels = imageRect.width() * imageRect.height();
+    QByteArray fftwData(numPixels * cs->pixelSize(), 0);
+    QByteArray spatialData(fftwData.size(), 0);
+
+    fftwDev->readBytes((quint8*)fftwData.data(), imageRect);
+    spatialDev->readBytes((quint8*)spatialData.data(), imageRect);
+
+    const int channelSize = cs->channelCount() ? cs->pixelSize() / cs->channelCount() : 1;
+    const int numChannels = numPixels * cs->channelCount();
+
+    for (int i = 0; i < numChannels; i++) {
+        int fftwValue = 0;
+        int spatialValue = 0;
+
+        if (channelSize == 1) {
+            fftwValue = reinterpret_cast<const quint8*>(fftwData.constData())[i];
+            spatialValue = reinterpret_cast<const quint8*>(spatialData.constData())[i];
+        } else {
+            fftwValue = reinterpret_cast<const quint16*>(fftwData.constData())[i];
+            spatialValue = reinterpret_cast<const quint16*>(spatialData.constData())[i];
+        }
+
+        if (qAbs(fftwValue - spatialValue) > tolerance) {
+            const int pixelIndex = i / cs->channelCount();
+
+            QFAIL(QString("FFTW result differs from the spatial one at (%1, %2): %3 vs %4")
+                  .arg(imageRect.x() + pixelIndex % imageRect.width())
+                  .arg(imageRect.y() + pixelIndex / imageRect.width())
+                  .arg(fftwValue).arg(spatialValue).toLatin1());
+        }
+    }
+}
+
 // #include <valgrind/callgrind.h>
 void KisConvolutionPainterTest::benchmarkConvolution()
 {
@@ -490,6 +687,105 @@ void KisConvolutionPainterTest::testErode()
     TestUtil::checkQImage(dev->convertToQImage(0, imageRect), "convolution_painter_test", "dilate", "erode5");
 }
 
+#include "kis_global.h"
+#include "KisGaussianBoxCascadeWorker.h"
+
+void KisConvolutionPainterTest::testGaussianBoxCascadeWidths()
+{
+    QVERIFY(KisGaussianBoxCascadeWorker::boxWidthsForRadius(0.0).isEmpty());
+
+    const QVector<qreal> radii({0.5, 5.0, 65.67, 100.0, 333.0, 1000.0});
+
+    Q_FOREACH (qreal radius, radii) {
+        const QVector<int> widths = KisGaussianBoxCascadeWorker::boxWidthsForRadius(radius);
+        QCOMPARE(widths.size(), int(KisGaussianBoxCascadeWorker::numBoxes));
+
+        qreal variance = 0.0;
+        Q_FOREACH (int width, widths) {
+            QVERIFY(width & 0x1);
+            variance += (pow2(width) - 1.0) / 12.0;
+        }
+
+        QVERIFY(KisGaussianBoxCascadeWorker::supportFromRadius(radius) <=
+                KisGaussianKernel::kernelSizeFromRadius(radius) / 2);
+
+        if (radius >= 5.0) {
+            const qreal sigma = KisGaussianKernel::sigmaFromRadius(radius);
+            QVERIFY(qAbs(std::sqrt(variance) - sigma) < 0.05 * sigma);
+        }
+    }
+}
+
+void KisConvolutionPainterTest::testGaussianBoxCascadeAccuracy_data()
+{
+    QTest::addColumn<qreal>("radius");
+    QTest::addColumn<bool>("use16Bit");
+
+    QTest::newRow("r70-8bit") << 70.0 << false;
+    QTest::newRow("r200-8bit") << 200.0 << false;
+    QTest::newRow("r70-16bit") << 70.0 << true;
+}
+
+void KisConvolutionPainterTest::testGaussianBoxCascadeAccuracy()
+{
+    QFETCH(qreal, radius);
+    QFETCH(bool, use16Bit);
+
+    const KoColorSpace *cs = use16Bit ?
+        KoColorSpaceRegistry::instance()->rgb16() :
+        KoColorSpaceRegistry::instance()->rgb8();
+
+    const QRect imageRect(0, 0, 512, 384);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+    dev->fill(imageRect, KoColor(Qt::white, cs));
+    dev->fill(QRect(100, 80, 200, 150), KoColor(Qt::black, cs));
+    dev->fill(QRect(250, 200, 200, 100), KoColor(Qt::red, cs));
+
+    KisDefaultBoundsBaseSP bounds = new TestUtil::TestingTimedDefaultBounds(imageRect);
+    dev->setDefaultBounds(bounds);
+
+    KisPaintDeviceSP exactDev = new KisPaintDevice(*dev);
+    KisPaintDeviceSP boxDev = new KisPaintDevice(*dev);
+
+    KisGaussianKernel::applyGaussian(exactDev, imageRect, radius, radius, QBitArray(), 0,
+                                     false, BORDER_REPEAT, KisGaussianKernel::Exact);
+
+    KisGaussianKernel::applyGaussian(boxDev, imageRect, radius, radius, QBitArray(), 0,
+                                     false, BORDER_REPEAT, KisGaussianKernel::BoxCascade);
+
+    // compare as 8-bit images to have the same tolerance for all the depths
+    const QImage exactImage = exactDev->convertToQImage(0, imageRect);
+    const QImage boxImage = boxDev->convertToQImage(0, imageRect);
+
+    int maxDifference = 0;
+    qint64 totalDifference = 0;
+
+    for (int y = 0; y < imageRect.height(); y++) {
+        const QRgb *exactLine = reinterpret_cast<const QRgb*>(exactImage.constScanLine(y));
+        const QRgb *boxLine = reinterpret_cast<const QRgb*>(boxImage.constScanLine(y));
+
+        for (int x = 0; x < imageRect.width(); x++) {
+            const int difference =
+                qMax(qMax(qAbs(qRed(exactLine[x]) - qRed(boxLine[x])),
+                          qAbs(qGreen(exactLine[x]) - qGreen(boxLine[x]))),
+                     qMax(qAbs(qBlue(exactLine[x]) - qBlue(boxLine[x])),
+                          qAbs(qAlpha(exactLine[x]) - qAlpha(boxLine[x]))));
+
+            maxDifference = qMax(maxDifference, difference);
+            totalDifference += difference;
+        }
+    }
+
+    const qreal meanDifference = qreal(totalDifference) / (imageRect.width() * imageRect.height());
+
+    // the error of the cascade is bounded by 6 levels of 8-bit range
+    QVERIFY2(maxDifference <= 6,
+             QString("max difference: %1").arg(maxDifference).toLatin1());
+    QVERIFY2(meanDifference < 1.0,
+             QString("mean difference: %1").arg(meanDifference).toLatin1());
+}
+
 #include "kis_edge_detection_kernel.h"
 
 void KisConvolutionPainterTest::testNormalMap(KisPaintDeviceSP dev, bool useFftw, const QString &prefix)
@@ -37,6 +37,12 @@ private Q_SLOTS:
     void testAsymmSkipBlue();
     void testAsymmSkipAlpha();
 
+    void testSeparableKernelDetection();
+    void testSeparableMatchesSpatial();
+
+    void testTiledFFTWMatchesSpatial_data();
+    void testTiledFFTWMatchesSpatial();
+
     void benchmarkConvolution();
     void testGaussianSpatial();
     void testGaussianFFTW();
@@ -50,6 +56,10 @@ private Q_SLOTS:
     void testDilate();
     void testErode();
 
+    void testGaussianBoxCascadeWidths();
+    void testGaussianBoxCascadeAccuracy_data();
+    void testGaussianBoxCascadeAccuracy();
+
     void testNormalMapSpatial();
     void testNormalMapFFTW();
 };
@@ -121,6 +121,41 @@ void KisLiquifyTransformWorkerTest::testPointsQImage()
     TestUtil::checkQImage(result, "liquify_transform_test", "liquify_qimage", "resultImage");
 }
 
+void KisLiquifyTransformWorkerTest::testIncrementalQImage()
+{
+    QImage image(TestUtil::fetchDataFileLazy("test_transform_quality_second.png"));
+    image = image.convertToFormat(QImage::Format_ARGB32);
+
+    const QRect bounds(QPoint(), image.size());
+    const QTransform imageToThumbTransform = QTransform::fromScale(0.5, 0.5);
+    const QImage thumb =
+        image.transformed(imageToThumbTransform).convertToFormat(QImage::Format_ARGB32);
+
+    KisLiquifyTransformWorker incrementalWorker(bounds, 0, 8);
+    KisLiquifyTransformWorker referenceWorker(bounds, 0, 8);
+
+    QPointF incrementalOffset;
+    QPointF referenceOffset;
+
+    incrementalWorker.translatePoints(QPointF(200,200), QPointF(30, 0), 50, false, 0.2);
+    incrementalWorker.runOnQImage(thumb, QPointF(), imageToThumbTransform, &incrementalOffset);
+
+    // the second stroke updates only the area around it
+    incrementalWorker.rotatePoints(QPointF(300,250), M_PI / 6, 40, false, 0.2);
+    incrementalWorker.undoPoints(QPointF(200,200), 0.5, 30);
+    QImage incrementalResult =
+        incrementalWorker.runOnQImage(thumb, QPointF(), imageToThumbTransform, &incrementalOffset);
+
+    referenceWorker.translatePoints(QPointF(200,200), QPointF(30, 0), 50, false, 0.2);
+    referenceWorker.rotatePoints(QPointF(300,250), M_PI / 6, 40, false, 0.2);
+    referenceWorker.undoPoints(QPointF(200,200), 0.5, 30);
+    QImage referenceResult =
+        referenceWorker.runOnQImage(thumb, QPointF(), imageToThumbTransform, &referenceOffset);
+
+    QCOMPARE(incrementalOffset, referenceOffset);
+    QCOMPARE(incrementalResult, referenceResult);
+}
+
 void KisLiquifyTransformWorkerTest::testIdentityTransform()
 {
     TestUtil::TestProgressBar bar;
@@ -15,6 +15,7 @@ class KisLiquifyTransformWorkerTest : public QObject
 private Q_SLOTS:
     void testPoints();
     void testPointsQImage();
+    void testIncrementalQImage();
     void testIdentityTransform();
 };
 
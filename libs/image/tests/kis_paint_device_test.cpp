@@ -1537,6 +1537,66 @@ void KisPaintDeviceTest::testLodDevice()
                                   "lod", "lod1-offset-6-14"));
 }
 
+KisRegion syncLodCacheIncrementally(KisPaintDeviceSP dev, int levelOfDetail)
+{
+    QScopedPointer<KisPaintDevice::LodDataStruct> s(dev->createLodDataStruct(levelOfDetail));
+
+    KisRegion region = dev->regionForLodSyncing(s.data());
+    Q_FOREACH(QRect rect2, KritaUtils::splitRegionIntoPatches(region, KritaUtils::optimalPatchSize())) {
+        dev->updateLodDataStruct(s.data(), rect2);
+    }
+
+    dev->uploadLodDataStruct(s.data());
+
+    return region;
+}
+
+void KisPaintDeviceTest::testLodDeviceIncrementalSync()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    TestingLodDefaultBounds *bounds = new TestingLodDefaultBounds(QRect(0,0,300,300));
+    dev->setDefaultBounds(bounds);
+
+    fillGradientDevice(dev, QRect(10,10,250,250));
+
+    // the first sync should always be full
+    bounds->testingSetLevelOfDetail(1);
+    KisRegion region = syncLodCacheIncrementally(dev, 1);
+    QCOMPARE(region, dev->regionForLodSyncing());
+
+    // nothing has changed, nothing to sync
+    region = syncLodCacheIncrementally(dev, 1);
+    QVERIFY(region.isEmpty());
+
+    // change one tile on the source device
+    bounds->testingSetLevelOfDetail(0);
+    dev->fill(QRect(70,70,10,10), KoColor(Qt::blue, cs));
+    dev->clear(QRect(192,192,64,64));
+
+    bounds->testingSetLevelOfDetail(1);
+    region = syncLodCacheIncrementally(dev, 1);
+    QCOMPARE(region.boundingRect(), QRect(64,64,192,192));
+    QVERIFY(!region.toQRegion().intersects(QRect(0,0,64,64)));
+
+    // compare to the fully regenerated plane
+    KisPaintDeviceSP refDev = new KisPaintDevice(*dev);
+    TestingLodDefaultBounds *refBounds = new TestingLodDefaultBounds(QRect(0,0,300,300));
+    refDev->setDefaultBounds(refBounds);
+    refBounds->testingSetLevelOfDetail(1);
+    syncLodCache(refDev, 1);
+
+    QImage result = dev->convertToQImage(0, 0, 0, 150, 150);
+    QImage refResult = refDev->convertToQImage(0, 0, 0, 150, 150);
+    QCOMPARE(result, refResult);
+
+    // changing the level of detail should cause the full sync
+    bounds->testingSetLevelOfDetail(2);
+    region = syncLodCacheIncrementally(dev, 2);
+    QCOMPARE(region, dev->regionForLodSyncing());
+}
+
 void KisPaintDeviceTest::benchmarkLod1Generation()
 {
     const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
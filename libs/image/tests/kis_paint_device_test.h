@@ -53,6 +53,7 @@ private Q_SLOTS:
 
     void testLodTransform();
     void testLodDevice();
+    void testLodDeviceIncrementalSync();
     void benchmarkLod1Generation();
     void benchmarkLod2Generation();
     void benchmarkLod3Generation();
@@ -9,8 +9,11 @@
 
 #include <simpletest.h>
 #include <brushengine/kis_paint_information.h>
+#include <brushengine/KisPaintInformationRecording.h>
 #include "kis_debug.h"
 
+#include <QBuffer>
+
 
 #include <QDomDocument>
 #include <Eigen/Core>
@@ -43,6 +46,60 @@ void KisPaintInformationTest::testSerialisation()
      */
 }
 
+void KisPaintInformationTest::testRecordingSerialisation()
+{
+    KisPaintInformation pi1(QPointF(10.5, 20.25), 0.5, 30.0, -15.0, 90.0, 0.25, 1.0, 16.0, 0.75);
+    pi1.setCanvasRotation(45.0);
+    pi1.setCanvasMirroredH(true);
+
+    KisPaintInformation pi2(QPointF(12.0, 22.0), 0.75, 0.0, 0.0, 0.0, 0.0, 1.0, 21.0, 0.5);
+    pi2.setCanvasMirroredV(true);
+
+    KisPaintInformationRecording recording;
+    recording.setCanvasSize(QSize(1024, 768));
+    recording.addStroke({pi1, pi2});
+    recording.addStroke({pi2});
+
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    QVERIFY(recording.write(&buffer));
+    buffer.seek(0);
+
+    KisPaintInformationRecording result;
+    QVERIFY(result.read(&buffer));
+
+    QCOMPARE(result.canvasSize(), QSize(1024, 768));
+    QCOMPARE(result.strokes().size(), 2);
+    QCOMPARE(result.numSamples(), 3);
+
+    const KisPaintInformation &r1 = result.strokes()[0][0];
+    QCOMPARE(r1.pos(), pi1.pos());
+    QCOMPARE(r1.pressure(), pi1.pressure());
+    QCOMPARE(r1.xTilt(), pi1.xTilt());
+    QCOMPARE(r1.yTilt(), pi1.yTilt());
+    QCOMPARE(r1.rotation(), pi1.rotation());
+    QCOMPARE(r1.tangentialPressure(), pi1.tangentialPressure());
+    QCOMPARE(r1.currentTime(), pi1.currentTime());
+    QCOMPARE(r1.drawingSpeed(), pi1.drawingSpeed());
+    QCOMPARE(r1.canvasRotation(), pi1.canvasRotation());
+    QCOMPARE(r1.canvasMirroredH(), true);
+    QCOMPARE(r1.canvasMirroredV(), false);
+
+    const KisPaintInformation &r2 = result.strokes()[1][0];
+    QCOMPARE(r2.pos(), pi2.pos());
+    QCOMPARE(r2.canvasMirroredH(), false);
+    QCOMPARE(r2.canvasMirroredV(), true);
+
+    // a truncated recording is rejected
+    buffer.seek(0);
+    QBuffer truncated;
+    truncated.setData(buffer.data().left(buffer.size() - 4));
+    truncated.open(QIODevice::ReadOnly);
+
+    KisPaintInformationRecording broken;
+    QVERIFY(!broken.read(&truncated));
+}
+
 #include <boost/random/taus88.hpp>
 #include <boost/random/uniform_smallint.hpp>
 
@@ -18,6 +18,7 @@
 #include <KoColorSpaceRegistry.h>
 #include "kis_types.h"
 #include "kis_paint_device.h"
+#include "kis_pixel_selection.h"
 
 
 void KisScanlineFillTest::testFillGeneral(const QVector<KisFillInterval> &initialBackwardIntervals,
@@ -283,4 +284,87 @@ void KisScanlineFillTest::testExternalFill()
     QCOMPARE(c, QColor(Qt::blue));
 }
 
+/**
+ * Creates a serpentine corridor crossing the borders of the blocks of
+ * the parallel fill many times, so that the components are merged only
+ * after several waves. There is also a closed box that should not be
+ * filled and a few spots of a slightly different color.
+ */
+inline KisPaintDeviceSP createParallelFillDevice(const QRect &rc)
+{
+    KisPaintDeviceSP dev = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    const KoColor wallColor(Qt::red, dev->colorSpace());
+
+    bool gapAtBottom = true;
+    for (int x = 40; x < rc.right(); x += 60) {
+        dev->fill(QRect(x, gapAtBottom ? rc.top() : rc.top() + 30, 8, rc.height() - 30), wallColor);
+        gapAtBottom = !gapAtBottom;
+    }
+
+    dev->fill(QRect(300, 200, 100, 100), wallColor);
+    dev->fill(QRect(310, 210, 80, 80), KoColor(Qt::transparent, dev->colorSpace()));
+
+    for (int i = 0; i < 10; i++) {
+        dev->fill(QRect(10 + 61 * i, 100 + 37 * i, 20, 20),
+                  KoColor(QColor(0, 0, 0, 10 * i), dev->colorSpace()));
+    }
+
+    return dev;
+}
+
+void KisScanlineFillTest::testParallelFill()
+{
+    const QRect boundingRect(0, 0, 700, 600);
+    const KoColor fillColor(Qt::blue, KoColorSpaceRegistry::instance()->rgb8());
+
+    KisPaintDeviceSP dev = createParallelFillDevice(boundingRect);
+    KisPaintDeviceSP refDev = new KisPaintDevice(*dev);
+
+    KisScanlineFill fill(dev, QPoint(650, 550), boundingRect);
+    fill.setThreshold(20);
+    fill.fill(fillColor);
+
+    KisScanlineFill refFill(refDev, QPoint(650, 550), boundingRect);
+    refFill.setThreshold(20);
+    refFill.setParallelFillEnabled(false);
+    refFill.fill(fillColor);
+
+    QColor c;
+    dev->pixel(5, 5, &c);
+    QCOMPARE(c, QColor(Qt::blue));
+    dev->pixel(350, 250, &c);
+    QCOMPARE(c.alpha(), 0);
+
+    QCOMPARE(dev->exactBounds(), refDev->exactBounds());
+
+    QPoint errorPoint;
+    QVERIFY(TestUtil::comparePaintDevices(errorPoint, dev, refDev));
+}
+
+void KisScanlineFillTest::testParallelFillSelection()
+{
+    const QRect boundingRect(0, 0, 700, 600);
+
+    KisPaintDeviceSP dev = createParallelFillDevice(boundingRect);
+
+    KisPixelSelectionSP selection = new KisPixelSelection();
+    KisPixelSelectionSP refSelection = new KisPixelSelection();
+
+    KisScanlineFill fill(dev, QPoint(5, 5), boundingRect);
+    fill.setThreshold(30);
+    fill.setOpacitySpread(50);
+    fill.fillSelection(selection);
+
+    KisScanlineFill refFill(dev, QPoint(5, 5), boundingRect);
+    refFill.setThreshold(30);
+    refFill.setOpacitySpread(50);
+    refFill.setParallelFillEnabled(false);
+    refFill.fillSelection(refSelection);
+
+    QCOMPARE(selection->selectedExactRect(), refSelection->selectedExactRect());
+
+    QPoint errorPoint;
+    QVERIFY(TestUtil::comparePaintDevices(errorPoint, selection, refSelection));
+}
+
 SIMPLE_TEST_MAIN(KisScanlineFillTest)
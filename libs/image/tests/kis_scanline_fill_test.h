@@ -27,6 +27,9 @@ private Q_SLOTS:
     void testClearNonZeroComponent();
     void testExternalFill();
 
+    void testParallelFill();
+    void testParallelFillSelection();
+
 private:
     void testFillGeneral(const QVector<KisFillInterval> &initialBackwardIntervals,
                          const QVector<QColor> &expectedResult,
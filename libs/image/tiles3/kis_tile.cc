@@ -19,6 +19,7 @@ void KisTile::init(qint32 col, qint32 row,
     m_col = col;
     m_row = row;
     m_lockCounter = 0;
+    m_lodSyncDirty.storeRelease(1);
 
     m_extent = QRect(m_col * KisTileData::WIDTH, m_row * KisTileData::HEIGHT,
                      KisTileData::WIDTH, KisTileData::HEIGHT);
@@ -225,6 +226,10 @@ void KisTile::lockForWrite()
 
     blockSwapping();
 
+    if (!m_lodSyncDirty.loadAcquire()) {
+        m_lodSyncDirty.storeRelease(1);
+    }
+
     /* We are doing COW here */
     if (lazyCopying()) {
         m_COWMutex.lock();
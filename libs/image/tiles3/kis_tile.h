@@ -119,6 +119,16 @@ public:
         return m_tileData;
     }
 
+    /**
+     * Returns true if the tile has been locked for writing since its
+     * creation or since the previous call to this function. Used by
+     * KisTiledDataManager to track the tiles that should be resynced
+     * into the LoD planes.
+     */
+    inline bool testAndClearLodSyncDirty() {
+        return m_lodSyncDirty.fetchAndStoreOrdered(0);
+    }
+
 private:
     void init(qint32 col, qint32 row,
               KisTileData *defaultTileData, KisMementoManager* mm);
@@ -148,6 +158,12 @@ private:
 
     QAtomicPointer<KisMementoManager> m_mementoManager;
 
+    /**
+     * Set every time the tile is locked for writing, reset by
+     * testAndClearLodSyncDirty()
+     */
+    QAtomicInt m_lodSyncDirty;
+
     /**
      * This is a special mutex for guarding copy-on-write
      * operations. We do not use lockless way here as it'll
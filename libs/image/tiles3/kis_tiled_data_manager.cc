@@ -9,6 +9,8 @@
 #include <QRect>
 #include <QVector>
 
+#include <algorithm>
+
 #include "kis_tile.h"
 #include "kis_tiled_data_manager.h"
 #include "kis_tile_data_wrapper.h"
@@ -95,6 +97,7 @@ void KisTiledDataManager::setDefaultPixelImpl(const quint8 *defaultPixel)
     m_mementoManager->setDefaultTileData(td);
 
     memcpy(m_defaultPixel, defaultPixel, pixelSize());
+    m_lodSyncFullUpdateNeeded = true;
 }
 
 bool KisTiledDataManager::write(KisPaintDeviceWriter &store)
@@ -167,6 +170,8 @@ bool KisTiledDataManager::read(QIODevice *stream)
     KisAbstractTileCompressorSP compressor =
         KisTileCompressorFactory::create(tilesVersion);
 
+    m_lodSyncFullUpdateNeeded = true;
+
     bool readSuccess = true;
     for (quint32 i = 0; i < numTiles; i++) {
         if (!compressor->readTile(stream, this)) {
@@ -675,6 +680,62 @@ KisRegion KisTiledDataManager::region() const
     return KisRegion(std::move(rects));
 }
 
+KisRegion KisTiledDataManager::takeLodSyncChangedRegion(bool *fullUpdateNeeded)
+{
+    QWriteLocker locker(&m_lock);
+
+    auto tileIndexLess = [] (const QPoint &lhs, const QPoint &rhs) {
+        return lhs.y() < rhs.y() || (lhs.y() == rhs.y() && lhs.x() < rhs.x());
+    };
+
+    auto tileIndexToRect = [] (const QPoint &index) {
+        return QRect(index.x() * KisTileData::WIDTH, index.y() * KisTileData::HEIGHT,
+                     KisTileData::WIDTH, KisTileData::HEIGHT);
+    };
+
+    QVector<QPoint> currentTiles;
+    QVector<QRect> changedRects;
+
+    {
+        KisTileHashTableConstIterator iter(m_hashTable);
+        KisTileSP tile;
+
+        while ((tile = iter.tile())) {
+            currentTiles << QPoint(tile->col(), tile->row());
+
+            /**
+             * We should reset the flag for all the tiles, even
+             * when the full update is requested
+             */
+            if (tile->testAndClearLodSyncDirty() || m_lodSyncFullUpdateNeeded) {
+                changedRects << tile->extent();
+            }
+            iter.next();
+        }
+    }
+
+    std::sort(currentTiles.begin(), currentTiles.end(), tileIndexLess);
+
+    if (!m_lodSyncFullUpdateNeeded) {
+        QVector<QPoint> removedTiles;
+        std::set_difference(m_lodSyncTiles.begin(), m_lodSyncTiles.end(),
+                            currentTiles.begin(), currentTiles.end(),
+                            std::back_inserter(removedTiles),
+                            tileIndexLess);
+
+        std::transform(removedTiles.begin(), removedTiles.end(),
+                       std::back_inserter(changedRects),
+                       tileIndexToRect);
+    }
+
+    *fullUpdateNeeded = m_lodSyncFullUpdateNeeded;
+
+    m_lodSyncTiles = currentTiles;
+    m_lodSyncFullUpdateNeeded = false;
+
+    return KisRegion(std::move(changedRects));
+}
+
 void KisTiledDataManager::setPixel(qint32 x, qint32 y, const quint8 * data)
 {
     KisTileDataWrapper tw(this, x, y, KisTileDataWrapper::WRITE);
@@ -157,6 +157,7 @@ public:
 
         QWriteLocker locker(&m_lock);
         m_mementoManager->rollback(m_hashTable, memento);
+        m_lodSyncFullUpdateNeeded = true;
         const quint8 *defaultPixel = memento->oldDefaultPixel();
         if(memcmp(m_defaultPixel, defaultPixel, m_pixelSize)) {
             setDefaultPixelImpl(defaultPixel);
@@ -168,6 +169,7 @@ public:
 
         QWriteLocker locker(&m_lock);
         m_mementoManager->rollforward(m_hashTable, memento);
+        m_lodSyncFullUpdateNeeded = true;
         const quint8 *defaultPixel = memento->newDefaultPixel();
         if(memcmp(m_defaultPixel, defaultPixel, m_pixelSize)) {
             setDefaultPixelImpl(defaultPixel);
@@ -216,6 +218,24 @@ public:
 
     KisRegion region() const;
 
+    /**
+     * Returns the region of the tiles that have been changed since the
+     * previous call to this function. The tracking is done with the tile
+     * granularity and is conservative, that is, the region may include
+     * the tiles that were locked for writing, but never actually changed.
+     * The tiles removed from the data manager are reported as changed
+     * as well.
+     *
+     * If the history of changes is unknown (the data manager has just been
+     * created, rolled back or its default pixel has changed),
+     * \p fullUpdateNeeded is set to true and the entire region of the
+     * data manager is returned.
+     *
+     * The function is used for incremental syncing of the LoD planes and
+     * should not be called concurrently with any writers.
+     */
+    KisRegion takeLodSyncChangedRegion(bool *fullUpdateNeeded);
+
     void clear(QRect clearRect, quint8 clearValue);
     void clear(QRect clearRect, const quint8 *clearPixel);
     void clear(qint32 x, qint32 y, qint32 w, qint32 h, quint8 clearValue);
@@ -338,6 +358,13 @@ private:
     qint32 m_pixelSize;
     KisTiledExtentManager m_extentManager;
 
+    /**
+     * The tiles present at the moment of the last call to
+     * takeLodSyncChangedRegion(), sorted in row-major order
+     */
+    QVector<QPoint> m_lodSyncTiles;
+    bool m_lodSyncFullUpdateNeeded = true;
+
     mutable QReadWriteLock m_lock;
 
 private:
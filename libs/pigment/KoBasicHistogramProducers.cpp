@@ -134,6 +134,8 @@ void KoBasicU8HistogramProducer::addRegionToBin(const quint8 * pixels, const qui
             nPixels--;
         }
     }
+
+    delete[] dstPixels;
 }
 
 // ------------ U16 ---------------------
@@ -206,6 +208,8 @@ void KoBasicU16HistogramProducer::addRegionToBin(const quint8 * pixels, const qu
             nPixels--;
         }
     }
+
+    delete[] dstPixels;
 }
 
 // ------------ Float32 ---------------------
@@ -279,6 +283,8 @@ void KoBasicF32HistogramProducer::addRegionToBin(const quint8 * pixels, const qu
 
         }
     }
+
+    delete[] dstPixels;
 }
 
 #ifdef HAVE_OPENEXR
@@ -352,6 +358,8 @@ void KoBasicF16HalfHistogramProducer::addRegionToBin(const quint8 * pixels, cons
             nPixels--;
         }
     }
+
+    delete[] dstPixels;
 }
 #endif
 
@@ -0,0 +1,242 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDisplayFilterLut3D.h"
+
+#include <cmath>
+
+#include "kis_assert.h"
+#include "kis_display_filter.h"
+
+namespace {
+
+/**
+ * 18 stops of dynamic range with the offset below 2^-10, which is
+ * enough for the preview of the HDR images
+ */
+const float maxInputValue = 256.0f;
+const float shaperOffset = 1.0f / 1024.0f;
+const float shaperMinLog = std::log2(shaperOffset);
+const float shaperRange = std::log2(maxInputValue + shaperOffset) - shaperMinLog;
+
+inline float shaper(float x)
+{
+    return (std::log2(x + shaperOffset) - shaperMinLog) / shaperRange;
+}
+
+inline float inverseShaper(float t)
+{
+    return shaperOffset * std::exp2(t * shaperRange) - shaperOffset;
+}
+
+inline bool isInDomain(const float *pixel)
+{
+    // NaN's fail both comparisons
+    return pixel[0] >= 0.0f && pixel[0] <= maxInputValue &&
+        pixel[1] >= 0.0f && pixel[1] <= maxInputValue &&
+        pixel[2] >= 0.0f && pixel[2] <= maxInputValue;
+}
+
+}
+
+KisDisplayFilterLut3D::KisDisplayFilterLut3D(QSharedPointer<KisDisplayFilter> filter, int edgeSize)
+    : m_filter(filter),
+      m_edgeSize(edgeSize),
+      m_isValid(false)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(m_filter);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(m_edgeSize >= 2);
+
+    if (!checkAlphaIndependent()) return;
+
+    const int numNodes = m_edgeSize * m_edgeSize * m_edgeSize;
+    std::vector<float> nodeValues(m_edgeSize);
+
+    for (int i = 0; i < m_edgeSize; i++) {
+        nodeValues[i] = inverseShaper(float(i) / (m_edgeSize - 1));
+    }
+
+    std::vector<float> lattice(4 * numNodes);
+    float *ptr = lattice.data();
+
+    for (int b = 0; b < m_edgeSize; b++) {
+        for (int g = 0; g < m_edgeSize; g++) {
+            for (int r = 0; r < m_edgeSize; r++) {
+                ptr[0] = nodeValues[r];
+                ptr[1] = nodeValues[g];
+                ptr[2] = nodeValues[b];
+                ptr[3] = 1.0f;
+                ptr += 4;
+            }
+        }
+    }
+
+    m_filter->filter(reinterpret_cast<quint8*>(lattice.data()), numNodes);
+
+    m_table.resize(3 * numNodes);
+    for (int i = 0; i < numNodes; i++) {
+        m_table[3 * i + 0] = lattice[4 * i + 0];
+        m_table[3 * i + 1] = lattice[4 * i + 1];
+        m_table[3 * i + 2] = lattice[4 * i + 2];
+    }
+
+    m_isValid = true;
+}
+
+bool KisDisplayFilterLut3D::isValid() const
+{
+    return m_isValid;
+}
+
+bool KisDisplayFilterLut3D::checkAlphaIndependent() const
+{
+    /**
+     * The 3D LUT can represent only the filters that don't mix alpha
+     * into the color channels and don't modify alpha itself. Check it
+     * on a few probe colors.
+     */
+    const float probes[][3] = {
+        {0.0f, 0.0f, 0.0f},
+        {0.18f, 0.18f, 0.18f},
+        {1.0f, 1.0f, 1.0f},
+        {0.8f, 0.2f, 0.05f},
+        {0.05f, 0.7f, 0.3f},
+        {4.0f, 2.0f, 16.0f}
+    };
+    const int numProbes = sizeof(probes) / sizeof(probes[0]);
+    const float testAlpha = 0.25f;
+
+    std::vector<float> opaque(4 * numProbes);
+    std::vector<float> translucent(4 * numProbes);
+
+    for (int i = 0; i < numProbes; i++) {
+        for (int ch = 0; ch < 3; ch++) {
+            opaque[4 * i + ch] = probes[i][ch];
+            translucent[4 * i + ch] = probes[i][ch];
+        }
+        opaque[4 * i + 3] = 1.0f;
+        translucent[4 * i + 3] = testAlpha;
+    }
+
+    m_filter->filter(reinterpret_cast<quint8*>(opaque.data()), numProbes);
+    m_filter->filter(reinterpret_cast<quint8*>(translucent.data()), numProbes);
+
+    const float eps = 1e-5f;
+
+    for (int i = 0; i < numProbes; i++) {
+        for (int ch = 0; ch < 3; ch++) {
+            if (std::abs(opaque[4 * i + ch] - translucent[4 * i + ch]) > eps) {
+                return false;
+            }
+        }
+
+        if (std::abs(opaque[4 * i + 3] - 1.0f) > eps ||
+            std::abs(translucent[4 * i + 3] - testAlpha) > eps) {
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+inline void KisDisplayFilterLut3D::applyPixel(float *pixel) const
+{
+    const int maxIndex = m_edgeSize - 2;
+    const float scale = m_edgeSize - 1;
+
+    const float fr = shaper(pixel[0]) * scale;
+    const float fg = shaper(pixel[1]) * scale;
+    const float fb = shaper(pixel[2]) * scale;
+
+    const int ir = qMin(int(fr), maxIndex);
+    const int ig = qMin(int(fg), maxIndex);
+    const int ib = qMin(int(fb), maxIndex);
+
+    const float dr = fr - ir;
+    const float dg = fg - ig;
+    const float db = fb - ib;
+
+    const int strideR = 3;
+    const int strideG = 3 * m_edgeSize;
+    const int strideB = 3 * m_edgeSize * m_edgeSize;
+
+    const float *c000 = m_table.data() + ib * strideB + ig * strideG + ir * strideR;
+    const float *c100 = c000 + strideR;
+    const float *c010 = c000 + strideG;
+    const float *c001 = c000 + strideB;
+    const float *c110 = c100 + strideG;
+    const float *c101 = c100 + strideB;
+    const float *c011 = c010 + strideB;
+    const float *c111 = c110 + strideB;
+
+    /**
+     * Tetrahedral interpolation: the cube is split into six tetrahedra
+     * along its main diagonal, the weights are the sorted fractions
+     */
+    const float *v1;
+    const float *v2;
+    float w0, w1, w2;
+
+    if (dr >= dg) {
+        if (dg >= db) {
+            v1 = c100; v2 = c110; w0 = dr; w1 = dg; w2 = db;
+        } else if (dr >= db) {
+            v1 = c100; v2 = c101; w0 = dr; w1 = db; w2 = dg;
+        } else {
+            v1 = c001; v2 = c101; w0 = db; w1 = dr; w2 = dg;
+        }
+    } else {
+        if (db >= dg) {
+            v1 = c001; v2 = c011; w0 = db; w1 = dg; w2 = dr;
+        } else if (db >= dr) {
+            v1 = c010; v2 = c011; w0 = dg; w1 = db; w2 = dr;
+        } else {
+            v1 = c010; v2 = c110; w0 = dg; w1 = dr; w2 = db;
+        }
+    }
+
+    for (int ch = 0; ch < 3; ch++) {
+        pixel[ch] = c000[ch] +
+            w0 * (v1[ch] - c000[ch]) +
+            w1 * (v2[ch] - v1[ch]) +
+            w2 * (c111[ch] - v2[ch]);
+    }
+}
+
+void KisDisplayFilterLut3D::apply(quint8 *pixels, quint32 numPixels) const
+{
+    if (!m_isValid) {
+        m_filter->filter(pixels, numPixels);
+        return;
+    }
+
+    float *pixel = reinterpret_cast<float*>(pixels);
+
+    // consecutive out-of-range pixels are passed to the filter in one go
+    float *outOfDomainRun = 0;
+    quint32 outOfDomainRunLength = 0;
+
+    for (quint32 i = 0; i < numPixels; i++, pixel += 4) {
+        if (Q_LIKELY(isInDomain(pixel))) {
+            if (outOfDomainRunLength) {
+                m_filter->filter(reinterpret_cast<quint8*>(outOfDomainRun), outOfDomainRunLength);
+                outOfDomainRunLength = 0;
+            }
+
+            applyPixel(pixel);
+        } else {
+            if (!outOfDomainRunLength) {
+                outOfDomainRun = pixel;
+            }
+            outOfDomainRunLength++;
+        }
+    }
+
+    if (outOfDomainRunLength) {
+        m_filter->filter(reinterpret_cast<quint8*>(outOfDomainRun), outOfDomainRunLength);
+    }
+}
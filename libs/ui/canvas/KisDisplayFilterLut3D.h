@@ -0,0 +1,83 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDISPLAYFILTERLUT3D_H
+#define KISDISPLAYFILTERLUT3D_H
+
+#include <vector>
+
+#include <QtGlobal>
+#include <QSharedPointer>
+
+#include "kritaui_export.h"
+#include "KisLazyStorage.h"
+
+class KisDisplayFilter;
+
+/**
+ * A 3D LUT baked from the current state of a display filter
+ *
+ * Passing every pixel through the OCIO processor is very expensive,
+ * so when a big chunk of the image should be filtered on the CPU side
+ * (QPainter canvas, thumbnails and previews), we sample the filter
+ * once into a lattice and interpolate between the lattice nodes
+ * (tetrahedral interpolation).
+ *
+ * The filter works on scene-linear RGBA F32 data, which can be way
+ * above 1.0, so the lattice is distributed with a logarithmic shaper
+ * covering [0, maxInputValue]. The pixels outside this range (and
+ * NaNs) are passed to the filter directly.
+ *
+ * Some configurations of the filter cannot be represented by a 3D LUT,
+ * e.g. when alpha channel is swizzled into the color channels. For
+ * such filters the LUT is not valid and apply() falls back to the
+ * filter itself.
+ *
+ * The LUT is immutable, so it is safe to use it from multiple threads.
+ * It should be rebaked every time the filter's processor is changed,
+ * e.g. on the exposure or gamma change.
+ */
+class KRITAUI_EXPORT KisDisplayFilterLut3D
+{
+public:
+    static const int defaultEdgeSize = 48;
+
+    KisDisplayFilterLut3D(QSharedPointer<KisDisplayFilter> filter, int edgeSize = defaultEdgeSize);
+
+    /**
+     * \return true if the filter can be represented by the LUT
+     */
+    bool isValid() const;
+
+    /**
+     * Filters \p numPixels of RGBA F32 data in place. The result
+     * approximates KisDisplayFilter::filter() of the source filter.
+     */
+    void apply(quint8 *pixels, quint32 numPixels) const;
+
+private:
+    bool checkAlphaIndependent() const;
+    inline void applyPixel(float *pixel) const;
+
+private:
+    QSharedPointer<KisDisplayFilter> m_filter;
+    int m_edgeSize;
+    bool m_isValid;
+    std::vector<float> m_table;
+};
+
+typedef QSharedPointer<KisDisplayFilterLut3D> KisDisplayFilterLut3DSP;
+
+/**
+ * The LUT is baked on the first access only. The display color
+ * converter creates it on every change of the filter and shares it
+ * with the QPainter canvas, so the OpenGL canvas, which applies the
+ * filter in a shader, never pays for the baking.
+ */
+typedef KisLazyStorage<KisDisplayFilterLut3D, QSharedPointer<KisDisplayFilter>> KisLazyDisplayFilterLut3D;
+typedef QSharedPointer<KisLazyDisplayFilterLut3D> KisLazyDisplayFilterLut3DSP;
+
+#endif // KISDISPLAYFILTERLUT3D_H
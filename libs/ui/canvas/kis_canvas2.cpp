@@ -21,6 +21,8 @@
 #include <QDesktopWidget>
 #include <QScreen>
 #include <QWindow>
+#include <QTimer>
+#include <QThread>
 
 #include <kis_debug.h>
 
@@ -183,10 +185,23 @@ public:
     QRect renderingLimit;
     int isBatchUpdateActive = 0;
 
+    QVector<QRect> postponedUpdatePatches;
+    QTimer postponedUpdatePatchesTimer;
+
     bool effectiveLodAllowedInImage() const {
         return lodPreferredInImage && !bootstrapLodBlocked;
     }
 
+    /**
+     * The postponed patches are in the coordinates of the current
+     * image, so they should be dropped when the image is resized
+     * or replaced
+     */
+    void cancelPostponedUpdatePatches() {
+        postponedUpdatePatchesTimer.stop();
+        postponedUpdatePatches.clear();
+    }
+
     bool lodIsSupported() const {
         return currentCanvasIsOpenGL &&
                 KisOpenGL::supportsLoD() &&
@@ -296,6 +311,10 @@ void KisCanvas2::setup()
 
     connect(&m_d->regionOfInterestUpdateCompressor, SIGNAL(timeout()), SLOT(slotUpdateRegionOfInterest()));
 
+    m_d->postponedUpdatePatchesTimer.setSingleShot(true);
+    m_d->postponedUpdatePatchesTimer.setInterval(0);
+    connect(&m_d->postponedUpdatePatchesTimer, SIGNAL(timeout()), SLOT(slotUpdatePostponedPatches()));
+
     connect(m_d->view->document(), SIGNAL(sigReferenceImagesChanged()), this, SLOT(slotReferenceImagesChanged()));
 
     initializeFpsDecoration();
@@ -546,7 +565,8 @@ void KisCanvas2::createQPainterCanvas()
     m_d->prescaledProjection->setMonitorProfile(m_d->displayColorConverter.monitorProfile(),
                                                 m_d->displayColorConverter.renderingIntent(),
                                                 m_d->displayColorConverter.conversionFlags());
-    m_d->prescaledProjection->setDisplayFilter(m_d->displayColorConverter.displayFilter());
+    m_d->prescaledProjection->setDisplayFilter(m_d->displayColorConverter.displayFilter(),
+                                               m_d->displayColorConverter.displayFilterLut());
     canvasWidget->setPrescaledProjection(m_d->prescaledProjection);
     setCanvasWidget(canvasWidget);
 }
@@ -603,6 +623,8 @@ void KisCanvas2::initializeImage()
 {
     KisImageSP image = m_d->view->image();
 
+    m_d->cancelPostponedUpdatePatches();
+
     m_d->displayColorConverter.setImageColorSpace(image->colorSpace());
     m_d->coordinatesConverter->setImage(image);
     m_d->toolProxy.initializeImage(image);
@@ -637,6 +659,8 @@ void KisCanvas2::disconnectImage()
     image->immediateLockForReadOnly();
     disconnect(image.data(), 0, this, 0);
     image->unlock();
+
+    m_d->cancelPostponedUpdatePatches();
 }
 
 void KisCanvas2::connectCurrentCanvas()
@@ -688,12 +712,50 @@ void KisCanvas2::startUpdateInPatches(const QRect &imageRect)
         int patchWidth = imageConfig.updatePatchWidth();
         int patchHeight = imageConfig.updatePatchHeight();
 
+        /**
+         * The QPainter canvas converts the patches synchronously, which
+         * is slow, e.g. when the exposure of an OCIO filter is changed.
+         * So we convert the patches visible on screen first and postpone
+         * the rest of them. The postponed patches are converted in small
+         * portions from the event loop, so the visible part of the canvas
+         * is repainted as soon as possible.
+         */
+        const bool canPostpone = QThread::currentThread() == thread();
+        const QRect visibleRect =
+            m_d->coordinatesConverter->widgetRectInImagePixels().toAlignedRect();
+
         for (int y = 0; y < imageRect.height(); y += patchHeight) {
             for (int x = 0; x < imageRect.width(); x += patchWidth) {
                 QRect patchRect(x, y, patchWidth, patchHeight);
-                startUpdateCanvasProjection(patchRect);
+
+                if (!canPostpone) {
+                    startUpdateCanvasProjection(patchRect);
+                } else if (patchRect.intersects(visibleRect)) {
+                    m_d->postponedUpdatePatches.removeOne(patchRect);
+                    startUpdateCanvasProjection(patchRect);
+                } else if (!m_d->postponedUpdatePatches.contains(patchRect)) {
+                    m_d->postponedUpdatePatches.append(patchRect);
+                }
             }
         }
+
+        if (!m_d->postponedUpdatePatches.isEmpty()) {
+            m_d->postponedUpdatePatchesTimer.start();
+        }
+    }
+}
+
+void KisCanvas2::slotUpdatePostponedPatches()
+{
+    // the number of patches converted in one go, 4 MiB of RGBA8 data
+    const int maxPatchesPerIteration = 4;
+
+    for (int i = 0; i < maxPatchesPerIteration && !m_d->postponedUpdatePatches.isEmpty(); i++) {
+        startUpdateCanvasProjection(m_d->postponedUpdatePatches.takeFirst());
+    }
+
+    if (!m_d->postponedUpdatePatches.isEmpty()) {
+        m_d->postponedUpdatePatchesTimer.start();
     }
 }
 
@@ -823,6 +885,12 @@ void KisCanvas2::startResizingImage()
 
 void KisCanvas2::finishResizingImage(qint32 w, qint32 h)
 {
+    /**
+     * This slot is always called in the GUI thread, before the patches
+     * of the resized image are postponed by startUpdateInPatches()
+     */
+    m_d->cancelPostponedUpdatePatches();
+
     m_d->canvasWidget->finishResizingImage(w, h);
 }
 
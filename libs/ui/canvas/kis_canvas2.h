@@ -300,6 +300,8 @@ private Q_SLOTS:
 
     void slotImageColorSpaceChanged();
 
+    void slotUpdatePostponedPatches();
+
 public:
     // interface for KisCanvasController only
     void setWrapAroundViewingMode(bool value);
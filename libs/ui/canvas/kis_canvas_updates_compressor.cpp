@@ -6,42 +6,90 @@
 
 #include "kis_canvas_updates_compressor.h"
 
+#include <QVarLengthArray>
+#include <algorithm>
+
+KisCanvasUpdatesCompressor::KisCanvasUpdatesCompressor()
+{
+}
+
+KisCanvasUpdatesCompressor::~KisCanvasUpdatesCompressor()
+{
+    Node *node = m_top.fetchAndStoreOrdered(0);
+
+    while (node) {
+        Node *next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
 bool KisCanvasUpdatesCompressor::putUpdateInfo(KisUpdateInfoSP info)
 {
-    const int levelOfDetail = info->levelOfDetail();
     const QRect newUpdateRect = info->dirtyImageRect();
     if (newUpdateRect.isEmpty()) return false;
 
-    QMutexLocker l(&m_mutex);
-
-    if (info->canBeCompressed()) {
-        KisUpdateInfoList::iterator it = m_updatesList.begin();
-        while (it != m_updatesList.end()) {
-            if ((*it)->canBeCompressed() &&
-                levelOfDetail == (*it)->levelOfDetail() &&
-                newUpdateRect.contains((*it)->dirtyImageRect())) {
-
-                /**
-                 * We should always remove the overridden update and put 'info' to the end
-                 * of the queue. Otherwise, the updates will become reordered and the canvas
-                 * may have tiles artifacts with "outdated" data
-                 */
-                it = m_updatesList.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
+    Node *newNode = new Node();
+    newNode->info = info;
 
-    m_updatesList.append(info);
+    Node *top = 0;
 
-    return m_updatesList.size() <= 1;
+    do {
+        top = m_top.loadAcquire();
+        newNode->next = top;
+    } while (!m_top.testAndSetOrdered(top, newNode));
+
+    return !top;
 }
 
 void KisCanvasUpdatesCompressor::takeUpdateInfo(KisUpdateInfoList &list)
 {
     KIS_SAFE_ASSERT_RECOVER(list.isEmpty()) { list.clear(); }
 
-    QMutexLocker l(&m_mutex);
-    m_updatesList.swap(list);
+    Node *node = m_top.fetchAndStoreOrdered(0);
+    if (!node) return;
+
+    /**
+     * The stack stores the updates in the reversed order, so we walk from
+     * the newest update to the oldest one. The older update is dropped if
+     * it is fully covered by any newer compressible update of the same
+     * level of detail. It is enough to check only the kept updates, since
+     * the dropped updates are already covered by some kept ones.
+     */
+    struct CompressedRect {
+        QRect rect;
+        int levelOfDetail;
+    };
+
+    QVarLengthArray<CompressedRect, 64> newerRects;
+    QVector<KisUpdateInfoSP> reversedUpdates;
+
+    while (node) {
+        KisUpdateInfoSP info = node->info;
+
+        if (info->canBeCompressed()) {
+            const QRect rect = info->dirtyImageRect();
+            const int levelOfDetail = info->levelOfDetail();
+
+            auto it = std::find_if(newerRects.begin(), newerRects.end(),
+                                   [&] (const CompressedRect &newer) {
+                                       return newer.levelOfDetail == levelOfDetail &&
+                                           newer.rect.contains(rect);
+                                   });
+
+            if (it == newerRects.end()) {
+                newerRects.append({rect, levelOfDetail});
+                reversedUpdates.append(info);
+            }
+        } else {
+            reversedUpdates.append(info);
+        }
+
+        Node *next = node->next;
+        delete node;
+        node = next;
+    }
+
+    list.reserve(reversedUpdates.size());
+    std::copy(reversedUpdates.crbegin(), reversedUpdates.crend(), std::back_inserter(list));
 }
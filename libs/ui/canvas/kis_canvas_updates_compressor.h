@@ -8,22 +8,53 @@
 #define __KIS_CANVAS_UPDATES_COMPRESSOR_H
 
 #include <QList>
-#include <QMutex>
-#include <QMutexLocker>
+#include <QAtomicPointer>
 
 #include "kis_update_info.h"
+#include "kritaui_export.h"
 
 typedef QList<KisUpdateInfoSP> KisUpdateInfoList;
 
-class KisCanvasUpdatesCompressor
+/**
+ * A multiple-producers single-consumer queue of the canvas updates
+ *
+ * The image worker threads put the updates into the queue without any
+ * locking: the updates are pushed into an intrusive lock-free stack. The
+ * GUI thread takes the entire stack in one atomic operation, so there is
+ * no ABA problem and no need for any memory reclamation scheme.
+ *
+ * The compression of the updates (removing the updates overridden by
+ * the newer ones) happens in the consumer thread in takeUpdateInfo(),
+ * so the worker threads never wait for each other or for the GUI thread.
+ */
+class KRITAUI_EXPORT KisCanvasUpdatesCompressor
 {
 public:
+    KisCanvasUpdatesCompressor();
+    ~KisCanvasUpdatesCompressor();
+
+    /**
+     * Adds \p info to the queue. Safe to call from any thread.
+     *
+     * \return true if the queue has been empty before the call, that is,
+     *         the consumer should be notified about the new updates
+     */
     bool putUpdateInfo(KisUpdateInfoSP info);
+
+    /**
+     * Takes all the pending updates from the queue in the order they
+     * have been added and removes the ones overridden by the newer
+     * updates. Should be called by the consumer thread only.
+     */
     void takeUpdateInfo(KisUpdateInfoList &list);
 
 private:
-    QMutex m_mutex;
-    KisUpdateInfoList m_updatesList;
+    struct Node {
+        Node *next = 0;
+        KisUpdateInfoSP info;
+    };
+
+    QAtomicPointer<Node> m_top;
 };
 
 #endif /* __KIS_CANVAS_UPDATES_COMPRESSOR_H */
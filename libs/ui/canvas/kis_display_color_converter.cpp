@@ -29,6 +29,8 @@
 #include "kis_paint_device.h"
 #include "kis_iterator_ng.h"
 #include "kis_fixed_paint_device.h"
+#include "KisDisplayFilterLut3D.h"
+#include "kis_pointer_utils.h"
 #include "opengl/KisOpenGLModeProber.h"
 
 Q_GLOBAL_STATIC(KisDisplayColorConverter, s_instance)
@@ -159,6 +161,12 @@ struct KisDisplayColorConverter::Private
 
     QSharedPointer<KisDisplayFilter> displayFilter;
 
+    /**
+     * The LUT is used for filtering big chunks of pixels only, the
+     * separate colors are still filtered by the exact processor
+     */
+    KisLazyDisplayFilterLut3DSP displayFilterLut;
+
     KoColor intermediateFgColor;
     KisNodeSP connectedNode;
     KisImageSP image;
@@ -169,6 +177,14 @@ struct KisDisplayColorConverter::Private
     inline KoColor approximateFromQColor(const QColor &qcolor);
     inline QColor approximateToQColor(const KoColor &color);
 
+    inline void filterPixels(quint8 *pixels, quint32 numPixels) const {
+        if (displayFilterLut) {
+            (*displayFilterLut)->apply(pixels, numPixels);
+        } else {
+            displayFilter->filter(pixels, numPixels);
+        }
+    }
+
     void slotCanvasResourceChanged(int key, const QVariant &v);
     void slotUpdateCurrentNodeColorSpace();
     void selectPaintingColorSpace();
@@ -440,6 +456,17 @@ void KisDisplayColorConverter::setDisplayFilter(QSharedPointer<KisDisplayFilter>
 
     m_d->displayFilter = displayFilter;
 
+    /**
+     * The filter is reset every time its processor changes, e.g. on
+     * every change of the exposure, so the LUT should be rebaked. It
+     * is baked lazily, because the OpenGL canvas uses it only for rare
+     * bulk conversions.
+     */
+    m_d->displayFilterLut.clear();
+    if (m_d->displayFilter) {
+        m_d->displayFilterLut = toQShared(new KisLazyDisplayFilterLut3D(m_d->displayFilter));
+    }
+
     if (m_d->displayFilter) {
         m_d->updateIntermediateFgColor(
             m_d->resourceManager->foregroundColor());
@@ -481,6 +508,11 @@ QSharedPointer<KisDisplayFilter> KisDisplayColorConverter::displayFilter() const
     return m_d->displayFilter;
 }
 
+KisLazyDisplayFilterLut3DSP KisDisplayColorConverter::displayFilterLut() const
+{
+    return m_d->displayFilterLut;
+}
+
 const KoColorProfile* KisDisplayColorConverter::monitorProfile() const
 {
     return m_d->monitorProfile;
@@ -590,7 +622,7 @@ QImage KisDisplayColorConverter::toQImage(KisPaintDeviceSP srcDevice, bool proof
         int numConseqPixels = it.nConseqPixels();
         while (it.nextPixels(numConseqPixels)) {
             numConseqPixels = it.nConseqPixels();
-            m_d->displayFilter->filter(it.rawData(), numConseqPixels);
+            m_d->filterPixels(it.rawData(), numConseqPixels);
         }
 
         device->setProfile(m_d->ocioOutputProfile(), 0);
@@ -636,7 +668,7 @@ QImage KisDisplayColorConverter::toQImage(const KoColorSpace *srcColorSpace, con
                                       numPixels,
                                       m_d->renderingIntent,
                                       m_d->conversionFlags);
-        m_d->displayFilter->filter(ocioBuffer.data(), numPixels);
+        m_d->filterPixels(ocioBuffer.data(), numPixels);
 
         return m_d->ocioOutputColorSpace()->convertToQImage(ocioBuffer.data(), size.width(), size.height(),
                                                             m_d->qtWidgetsProfile(),
@@ -664,7 +696,7 @@ void KisDisplayColorConverter::applyDisplayFilteringF32(KisFixedPaintDeviceSP de
         KIS_ASSERT_RECOVER_RETURN(m_d->ocioInputColorSpace()->pixelSize() == 16);
 
         device->convertTo(m_d->ocioInputColorSpace());
-        m_d->displayFilter->filter(device->data(), device->bounds().width() * device->bounds().height());
+        m_d->filterPixels(device->data(), device->bounds().width() * device->bounds().height());
         device->setProfile(m_d->ocioOutputProfile());
     }
 
@@ -14,6 +14,7 @@
 
 #include "kis_types.h"
 #include "canvas/kis_display_filter.h"
+#include "canvas/KisDisplayFilterLut3D.h"
 
 class KoColor;
 class KoColorProfile;
@@ -53,6 +54,12 @@ public:
     void setMonitorProfile(const KoColorProfile *monitorProfile);
     void setDisplayFilter(QSharedPointer<KisDisplayFilter> displayFilter);
 
+    /**
+     * The LUT of the current display filter, baked on the first use.
+     * Null if there is no filter.
+     */
+    KisLazyDisplayFilterLut3DSP displayFilterLut() const;
+
     QColor toQColor(const KoColor &c, bool proofToPaintColors = false) const;
     KoColor approximateFromRenderedQColor(const QColor &c) const;
 
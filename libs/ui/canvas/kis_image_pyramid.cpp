@@ -13,6 +13,7 @@
 #include <KoColorSpaceMaths.h>
 
 #include "kis_display_filter.h"
+#include "kis_pointer_utils.h"
 #include "kis_painter.h"
 #include "kis_iterator_ng.h"
 #include "kis_datamanager.h"
@@ -135,9 +136,19 @@ void KisImagePyramid::setChannelFlags(const QBitArray &channelFlags)
     m_onlyOneChannelSelected = (selectedChannels == 1);
 }
 
-void KisImagePyramid::setDisplayFilter(QSharedPointer<KisDisplayFilter> displayFilter)
+void KisImagePyramid::setDisplayFilter(QSharedPointer<KisDisplayFilter> displayFilter, KisLazyDisplayFilterLut3DSP displayFilterLut)
 {
     m_displayFilter = displayFilter;
+    m_displayFilterLut = displayFilterLut;
+}
+
+void KisImagePyramid::filterPixels(quint8 *pixels, quint32 numPixels) const
+{
+    if (m_displayFilterLut) {
+        (*m_displayFilterLut)->apply(pixels, numPixels);
+    } else {
+        m_displayFilter->filter(pixels, numPixels);
+    }
 }
 
 void KisImagePyramid::rebuildPyramid()
@@ -244,11 +255,11 @@ void KisImagePyramid::retrieveImageData(const QRect &rect)
                 destinationProfile);
 
         if (projectionCs->colorDepthId() == Float32BitsColorDepthID) {
-            m_displayFilter->filter(originalBytes.data(), numPixels);
+            filterPixels(originalBytes.data(), numPixels);
         } else {
             QScopedArrayPointer<quint8> dst(new quint8[floatCs->pixelSize() * numPixels]);
             projectionCs->convertPixelsTo(originalBytes.data(), dst.data(), floatCs, numPixels, KoColorConversionTransformation::internalRenderingIntent(), KoColorConversionTransformation::internalConversionFlags());
-            m_displayFilter->filter(dst.data(), numPixels);
+            filterPixels(dst.data(), numPixels);
             originalBytes.swap(dst);
         }
 
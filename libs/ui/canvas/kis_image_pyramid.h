@@ -29,7 +29,7 @@ public:
     void setImageSize(qint32 w, qint32 h) override;
     void setMonitorProfile(const KoColorProfile* monitorProfile, KoColorConversionTransformation::Intent renderingIntent, KoColorConversionTransformation::ConversionFlags conversionFlags) override;
     void setChannelFlags(const QBitArray &channelFlags) override;
-    void setDisplayFilter(QSharedPointer<KisDisplayFilter> displayFilter) override;
+    void setDisplayFilter(QSharedPointer<KisDisplayFilter> displayFilter, KisLazyDisplayFilterLut3DSP displayFilterLut) override;
     void updateCache(const QRect &dirtyImageRect) override;
     void recalculateCache(KisPPUpdateInfoSP info) override;
 
@@ -64,6 +64,13 @@ public:
 private:
 
     void retrieveImageData(const QRect &rect);
+
+    /**
+     * Filters RGBA F32 pixels with the LUT shared with the display
+     * color converter or with the filter itself, if there is no LUT
+     */
+    void filterPixels(quint8 *pixels, quint32 numPixels) const;
+
     void rebuildPyramid();
     void clearPyramid();
 
@@ -110,6 +117,7 @@ private:
     const KoColorSpace* m_monitorColorSpace {0};
 
     QSharedPointer<KisDisplayFilter> m_displayFilter;
+    KisLazyDisplayFilterLut3DSP m_displayFilterLut;
 
     KoColorConversionTransformation::Intent m_renderingIntent { KoColorConversionTransformation::IntentPerceptual };
     KoColorConversionTransformation::ConversionFlags m_conversionFlags { KoColorConversionTransformation::Empty };
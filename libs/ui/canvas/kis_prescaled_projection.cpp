@@ -260,9 +260,9 @@ void KisPrescaledProjection::setChannelFlags(const QBitArray &channelFlags)
     m_d->projectionBackend->setChannelFlags(channelFlags);
 }
 
-void KisPrescaledProjection::setDisplayFilter(QSharedPointer<KisDisplayFilter> displayFilter)
+void KisPrescaledProjection::setDisplayFilter(QSharedPointer<KisDisplayFilter> displayFilter, KisLazyDisplayFilterLut3DSP displayFilterLut)
 {
-    m_d->projectionBackend->setDisplayFilter(displayFilter);
+    m_d->projectionBackend->setDisplayFilter(displayFilter, displayFilterLut);
 }
 
 
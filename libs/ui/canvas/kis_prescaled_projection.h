@@ -23,6 +23,7 @@ class KisDisplayFilter;
 
 #include <kis_types.h>
 #include "kis_ui_types.h"
+#include "KisDisplayFilterLut3D.h"
 
 
 
@@ -102,7 +103,12 @@ public Q_SLOTS:
 
     void setChannelFlags(const QBitArray &channelFlags);
 
-    void setDisplayFilter(QSharedPointer<KisDisplayFilter> displayFilter);
+    /**
+     * Sets the display filter and its LUT shared with the display
+     * color converter. \p displayFilterLut may be null, then the
+     * pixels are passed to the filter directly.
+     */
+    void setDisplayFilter(QSharedPointer<KisDisplayFilter> displayFilter, KisLazyDisplayFilterLut3DSP displayFilterLut);
 
     /**
      * Called whenever the zoom level changes or another chunk of the
@@ -8,6 +8,7 @@
 #define KIS_PROJECTION_BACKEND
 
 #include "kis_update_info.h"
+#include "KisDisplayFilterLut3D.h"
 
 class KoColorProfile;
 class KisImagePatch;
@@ -34,7 +35,7 @@ public:
     virtual void setImageSize(qint32 w, qint32 h) = 0;
     virtual void setMonitorProfile(const KoColorProfile* monitorProfile, KoColorConversionTransformation::Intent renderingIntent, KoColorConversionTransformation::ConversionFlags conversionFlags) = 0;
     virtual void setChannelFlags(const QBitArray &channelFlags) = 0;
-    virtual void setDisplayFilter(QSharedPointer<KisDisplayFilter> displayFilter) = 0;
+    virtual void setDisplayFilter(QSharedPointer<KisDisplayFilter> displayFilter, KisLazyDisplayFilterLut3DSP displayFilterLut) = 0;
 
     /**
      * Updates the cache of the backend by reading from
@@ -179,7 +179,8 @@ void KisQPainterCanvas::setDisplayColorConverter(KisDisplayColorConverter *color
 void KisQPainterCanvas::setDisplayFilter(QSharedPointer<KisDisplayFilter> displayFilter)
 {
         Q_ASSERT(m_d->prescaledProjection);
-        m_d->prescaledProjection->setDisplayFilter(displayFilter);
+        m_d->prescaledProjection->setDisplayFilter(displayFilter,
+                                                   canvas()->displayColorConverter()->displayFilterLut());
 
         canvas()->startUpdateInPatches(canvas()->image()->bounds());
 }
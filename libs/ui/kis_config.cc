@@ -1919,6 +1919,16 @@ void KisConfig::setLineSmoothingStabilizeSensors(bool value)
     m_cfg.writeEntry("LineSmoothingStabilizeSensors", value);
 }
 
+bool KisConfig::lineSmoothingPredictStroke(bool defaultValue) const
+{
+    return (defaultValue ? false : m_cfg.readEntry("LineSmoothingPredictStroke", false));
+}
+
+void KisConfig::setLineSmoothingPredictStroke(bool value)
+{
+    m_cfg.writeEntry("LineSmoothingPredictStroke", value);
+}
+
 int KisConfig::tabletEventsDelay(bool defaultValue) const
 {
     return (defaultValue ? 10 : m_cfg.readEntry("tabletEventsDelay", 10));
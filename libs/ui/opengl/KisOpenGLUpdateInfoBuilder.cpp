@@ -14,6 +14,15 @@
 #include <QReadWriteLock>
 #include <QReadLocker>
 #include <QWriteLocker>
+#include <QtConcurrent>
+
+namespace {
+/**
+ * Converting less tiles is cheaper to do in the calling thread,
+ * e.g. for a usual update patch of 512x512 pixels
+ */
+const int minTilesForParallelConversion = 8;
+}
 
 
 struct KRITAUI_NO_EXPORT KisOpenGLUpdateInfoBuilder::Private
@@ -139,16 +148,6 @@ KisOpenGLUpdateInfoSP KisOpenGLUpdateInfoBuilder::buildUpdateInfo(const QRect &r
                                                      m_d->pool));
             // Don't update empty tiles
             if (tileInfo->valid()) {
-                tileInfo->retrieveData(projection, channelFlags, m_d->onlyOneChannelSelected, m_d->selectedChannelIndex);
-
-                if (convertColorSpace) {
-                    if (m_d->proofingTransform) {
-                        tileInfo->proofTo(m_d->conversionOptions.m_destinationColorSpace, m_d->proofingConfig->conversionFlags, m_d->proofingTransform.data());
-                    } else {
-                        tileInfo->convertTo(m_d->conversionOptions.m_destinationColorSpace, m_d->conversionOptions.m_renderingIntent, m_d->conversionOptions.m_conversionFlags);
-                    }
-                }
-
                 info->tileList.append(tileInfo);
             }
             else {
@@ -157,6 +156,38 @@ KisOpenGLUpdateInfoSP KisOpenGLUpdateInfoBuilder::buildUpdateInfo(const QRect &r
         }
     }
 
+    auto prepareTile =
+        [&] (KisTextureTileUpdateInfoSP &tileInfo) {
+            tileInfo->retrieveData(projection, channelFlags, m_d->onlyOneChannelSelected, m_d->selectedChannelIndex);
+
+            if (convertColorSpace) {
+                if (m_d->proofingTransform) {
+                    tileInfo->proofTo(m_d->conversionOptions.m_destinationColorSpace, m_d->proofingConfig->conversionFlags, m_d->proofingTransform.data());
+                } else {
+                    tileInfo->convertTo(m_d->conversionOptions.m_destinationColorSpace, m_d->conversionOptions.m_renderingIntent, m_d->conversionOptions.m_conversionFlags);
+                }
+            }
+        };
+
+    /**
+     * The tiles are independent from each other, so big updates (e.g.
+     * the initial upload of the image or a color space change) are
+     * prepared on all the available cores. The calling thread takes
+     * part in the work, so it is safe to do even when the global pool
+     * is busy.
+     *
+     * The builder's lock is held for read by the calling thread during
+     * the whole operation, so the conversion options cannot change
+     * under the feet of the worker threads.
+     */
+    if (info->tileList.size() >= minTilesForParallelConversion) {
+        QtConcurrent::blockingMap(info->tileList, prepareTile);
+    } else {
+        Q_FOREACH (KisTextureTileUpdateInfoSP tileInfo, info->tileList) {
+            prepareTile(tileInfo);
+        }
+    }
+
     info->assignDirtyImageRect(rect);
     info->assignLevelOfDetail(levelOfDetail);
     return info;
@@ -7,9 +7,10 @@
 #ifndef __KIS_TEXTURE_TILE_INFO_POOL_H
 #define __KIS_TEXTURE_TILE_INFO_POOL_H
 
-#include <boost/pool/pool.hpp>
 #include <QtGlobal>
 #include <QVector>
+#include <QAtomicInt>
+#include <QAtomicPointer>
 
 #include <QMutex>
 #include <QMutexLocker>
@@ -20,11 +21,10 @@
 #include "kis_debug.h"
 #include "kis_global.h"
 #include "kis_signal_compressor.h"
+#include "kis_lockless_stack.h"
 
 #include "kritaui_export.h"
 
-const int minPoolChunk = 32; // 8 MiB (default, with tilesize 256)
-const int maxPoolChunk = 128; // 32 MiB (default, with tilesize 256)
 const int freeThreshold = 64; // 16 MiB (default, with tilesize 256)
 
 
@@ -34,38 +34,57 @@ const int freeThreshold = 64; // 16 MiB (default, with tilesize 256)
  * obviously depends on the size of the tile in pixels and the size of
  * a single pixel in bytes.
  *
- * As soon as the number of allocations drops to zero, all the memory
- * is returned back to the operating system. Please note, that there
- * is *no way* of reclaiming even unused pool memory until *all* the
- * allocated chunks are free'd.
+ * The pool is used concurrently by all the threads preparing the
+ * texture tiles, so it is lock-free: the free'd chunks are kept in
+ * a lockless stack and are reused by the next allocations. A new chunk
+ * is allocated only when the stack is empty.
+ *
+ * As soon as the number of allocations drops to zero, all the cached
+ * chunks are returned back to the operating system (if the peak number
+ * of allocations was big enough).
  */
 class KRITAUI_EXPORT KisTextureTileInfoPoolSingleSize
 {
 public:
     KisTextureTileInfoPoolSingleSize(int tileWidth, int tileHeight, int pixelSize)
         : m_chunkSize(tileWidth * tileHeight * pixelSize),
-          m_pool(m_chunkSize, minPoolChunk, maxPoolChunk),
           m_numAllocations(0),
           m_maxAllocations(0),
           m_numFrees(0)
     {
     }
 
+    ~KisTextureTileInfoPoolSingleSize() {
+        KIS_SAFE_ASSERT_RECOVER_NOOP(!m_numAllocations.loadAcquire());
+        releaseCachedChunks();
+    }
+
     quint8* malloc() {
-        m_numAllocations++;
-        m_maxAllocations = qMax(m_maxAllocations, m_numAllocations);
+        const int numAllocations = m_numAllocations.fetchAndAddOrdered(1) + 1;
+
+        int maxAllocations = m_maxAllocations.loadAcquire();
+        while (numAllocations > maxAllocations &&
+               !m_maxAllocations.testAndSetOrdered(maxAllocations, numAllocations)) {
+
+            maxAllocations = m_maxAllocations.loadAcquire();
+        }
 
-        return (quint8*)m_pool.malloc();
+        quint8 *ptr = 0;
+        if (!m_cachedChunks.pop(ptr)) {
+            ptr = new quint8[m_chunkSize];
+        }
+
+        return ptr;
     }
 
     bool free(quint8 *ptr) {
-        m_numAllocations--;
-        m_numFrees++;
-        m_pool.free(ptr);
+        m_cachedChunks.push(ptr);
+        m_numFrees.ref();
 
-        KIS_ASSERT_RECOVER_NOOP(m_numAllocations >= 0);
+        const int numAllocations = m_numAllocations.fetchAndAddOrdered(-1) - 1;
+        KIS_ASSERT_RECOVER_NOOP(numAllocations >= 0);
 
-        return !m_numAllocations && m_maxAllocations > freeThreshold;
+        return !numAllocations && m_maxAllocations.loadAcquire() > freeThreshold;
     }
 
     int chunkSize() const {
@@ -73,24 +92,37 @@ public:
     }
 
     int numFrees() const {
-        return m_numFrees;
+        return m_numFrees.loadAcquire();
     }
 
     void tryPurge(int numFrees) {
         // checking numFrees here is asserting that there were no frees
         // between the time we originally indicated the purge and now.
-        if (numFrees == m_numFrees && !m_numAllocations) {
-            m_pool.purge_memory();
-            m_maxAllocations = 0;
+        if (numFrees == m_numFrees.loadAcquire() && !m_numAllocations.loadAcquire()) {
+            /**
+             * Only the unused chunks are released, so a concurrent
+             * allocation is still safe: in the worst case it will
+             * just allocate a new chunk.
+             */
+            releaseCachedChunks();
+            m_maxAllocations.storeRelease(0);
+        }
+    }
+
+private:
+    void releaseCachedChunks() {
+        quint8 *ptr = 0;
+        while (m_cachedChunks.pop(ptr)) {
+            delete[] ptr;
         }
     }
 
 private:
     const int m_chunkSize;
-    boost::pool<boost::default_user_allocator_new_delete> m_pool;
-    int m_numAllocations;
-    int m_maxAllocations;
-    int m_numFrees;
+    KisLocklessStack<quint8*> m_cachedChunks;
+    QAtomicInt m_numAllocations;
+    QAtomicInt m_maxAllocations;
+    QAtomicInt m_numFrees;
 };
 
 class KisTextureTileInfoPool;
@@ -131,34 +163,29 @@ public:
 
     ~KisTextureTileInfoPool() {
         delete m_worker;
-        qDeleteAll(m_pools);
+
+        for (int i = 0; i <= maxPixelSize; i++) {
+            delete m_pools[i].loadAcquire();
+        }
     }
 
     /**
      * Alloc a tile with the specified pixel size
      */
     quint8* malloc(int pixelSize) {
-        QMutexLocker l(&m_mutex);
-
-        if (m_pools.size() <= pixelSize) {
-            m_pools.resize(pixelSize + 1);
-        }
-
-        if (!m_pools[pixelSize]) {
-            m_pools[pixelSize] =
-                new KisTextureTileInfoPoolSingleSize(m_tileWidth, m_tileHeight, pixelSize);
-        }
-
-        return m_pools[pixelSize]->malloc();
+        KisTextureTileInfoPoolSingleSize *pool = poolForPixelSize(pixelSize);
+        return pool ? pool->malloc() : new quint8[unpooledChunkSize(pixelSize)];
     }
 
     /**
      * Free a tile with the specified pixel size
      */
     void free(quint8 *ptr, int pixelSize) {
-        QMutexLocker l(&m_mutex);
-        KisTextureTileInfoPoolSingleSize *pool = m_pools[pixelSize];
-        if (pool->free(ptr)) {
+        KisTextureTileInfoPoolSingleSize *pool = poolForPixelSize(pixelSize);
+
+        if (!pool) {
+            delete[] ptr;
+        } else if (pool->free(ptr)) {
             emit purge(pixelSize, pool->numFrees());
         }
     }
@@ -167,23 +194,63 @@ public:
      * \return the length of the chunks stored in the pool
      */
     int chunkSize(int pixelSize) const {
-        QMutexLocker l(&m_mutex);
-        return m_pools[pixelSize]->chunkSize();
+        KisTextureTileInfoPoolSingleSize *pool = poolForPixelSize(pixelSize);
+        return pool ? pool->chunkSize() : unpooledChunkSize(pixelSize);
     }
 
     void tryPurge(int pixelSize, int numFrees) {
-        QMutexLocker l(&m_mutex);
-        m_pools[pixelSize]->tryPurge(numFrees);
+        KisTextureTileInfoPoolSingleSize *pool = poolForPixelSize(pixelSize);
+        if (pool) {
+            pool->tryPurge(numFrees);
+        }
     }
 
 Q_SIGNALS:
     void purge(int pixelSize, int numFrees);
 
 private:
-    mutable QMutex m_mutex;
+    /**
+     * The pools are created on demand, but never destroyed until the
+     * destruction of the universal pool, so the lookup doesn't need
+     * any locking. Two threads may race to create the same pool, then
+     * the loser just deletes its copy.
+     *
+     * Returns null for the pixel sizes that are not pooled, the chunks
+     * of such sizes are allocated directly.
+     */
+    KisTextureTileInfoPoolSingleSize* poolForPixelSize(int pixelSize) const {
+        KIS_SAFE_ASSERT_RECOVER(pixelSize > 0 && pixelSize <= maxPixelSize) {
+            return 0;
+        }
+
+        KisTextureTileInfoPoolSingleSize *pool = m_pools[pixelSize].loadAcquire();
+
+        if (!pool) {
+            KisTextureTileInfoPoolSingleSize *newPool =
+                new KisTextureTileInfoPoolSingleSize(m_tileWidth, m_tileHeight, pixelSize);
+
+            if (m_pools[pixelSize].testAndSetOrdered(0, newPool)) {
+                pool = newPool;
+            } else {
+                delete newPool;
+                pool = m_pools[pixelSize].loadAcquire();
+            }
+        }
+
+        return pool;
+    }
+
+    int unpooledChunkSize(int pixelSize) const {
+        return m_tileWidth * m_tileHeight * qMax(1, pixelSize);
+    }
+
+private:
+    // RGBA F32 uses 16 bytes per pixel, CMYKA F32 uses 20
+    static const int maxPixelSize = 64;
+
     const int m_tileWidth;
     const int m_tileHeight;
-    QVector<KisTextureTileInfoPoolSingleSize*> m_pools;
+    mutable QAtomicPointer<KisTextureTileInfoPoolSingleSize> m_pools[maxPixelSize + 1];
     KisTextureTileInfoPoolWorker *m_worker;
 };
 
@@ -0,0 +1,144 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisCanvasUpdatesCompressorTest.h"
+
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QThreadPool>
+
+#include "canvas/kis_canvas_updates_compressor.h"
+#include "canvas/kis_update_info.h"
+
+namespace {
+KisUpdateInfoSP createUpdate(const QRect &rect, int levelOfDetail = 0)
+{
+    KisOpenGLUpdateInfo *info = new KisOpenGLUpdateInfo();
+    info->assignDirtyImageRect(rect);
+    info->assignLevelOfDetail(levelOfDetail);
+    return info;
+}
+
+class ProducerJob : public QRunnable
+{
+public:
+    ProducerJob(KisCanvasUpdatesCompressor *compressor, int producerIndex,
+                int numUpdates, QAtomicInt *numRunningProducers)
+        : m_compressor(compressor),
+          m_producerIndex(producerIndex),
+          m_numUpdates(numUpdates),
+          m_numRunningProducers(numRunningProducers)
+    {
+    }
+
+    void run() override {
+        // the rects are disjoint, so none of them can be compressed
+        for (int i = 0; i < m_numUpdates; i++) {
+            m_compressor->putUpdateInfo(createUpdate(QRect(i, m_producerIndex, 1, 1)));
+        }
+
+        m_numRunningProducers->deref();
+    }
+
+private:
+    KisCanvasUpdatesCompressor *m_compressor;
+    int m_producerIndex;
+    int m_numUpdates;
+    QAtomicInt *m_numRunningProducers;
+};
+}
+
+void KisCanvasUpdatesCompressorTest::testCompression()
+{
+    KisCanvasUpdatesCompressor compressor;
+
+    KisUpdateInfoSP covered = createUpdate(QRect(0, 0, 10, 10));
+    KisUpdateInfoSP marker = new KisMarkerUpdateInfo(KisMarkerUpdateInfo::StartBatch, QRect(0, 0, 5, 5));
+    KisUpdateInfoSP otherLod = createUpdate(QRect(0, 0, 10, 10), 1);
+    KisUpdateInfoSP covering = createUpdate(QRect(0, 0, 20, 20));
+    KisUpdateInfoSP separate = createUpdate(QRect(50, 50, 5, 5));
+    KisUpdateInfoSP newerCovered = createUpdate(QRect(2, 2, 3, 3));
+
+    // only the first update should wake up the consumer
+    QVERIFY(compressor.putUpdateInfo(covered));
+    QVERIFY(!compressor.putUpdateInfo(marker));
+    QVERIFY(!compressor.putUpdateInfo(otherLod));
+    QVERIFY(!compressor.putUpdateInfo(covering));
+    QVERIFY(!compressor.putUpdateInfo(separate));
+    QVERIFY(!compressor.putUpdateInfo(newerCovered));
+
+    // empty updates are not queued at all
+    QVERIFY(!compressor.putUpdateInfo(createUpdate(QRect())));
+
+    KisUpdateInfoList list;
+    compressor.takeUpdateInfo(list);
+
+    /**
+     * The older update covered by a newer one of the same level of
+     * detail is dropped. The non-compressible update, the update of
+     * a different level of detail and the newer update covered by an
+     * older one are kept in their original order.
+     */
+    KisUpdateInfoList expected;
+    expected << marker << otherLod << covering << separate << newerCovered;
+
+    QCOMPARE(list, expected);
+
+    // the queue is empty now and the next update wakes up the consumer again
+    list.clear();
+    compressor.takeUpdateInfo(list);
+    QVERIFY(list.isEmpty());
+
+    QVERIFY(compressor.putUpdateInfo(covered));
+}
+
+void KisCanvasUpdatesCompressorTest::testMultipleProducers()
+{
+    const int numProducers = 4;
+    const int numUpdates = 20000;
+
+    KisCanvasUpdatesCompressor compressor;
+    QAtomicInt numRunningProducers(numProducers);
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(numProducers);
+
+    for (int i = 0; i < numProducers; i++) {
+        threadPool.start(new ProducerJob(&compressor, i, numUpdates, &numRunningProducers));
+    }
+
+    QVector<int> nextUpdateIndex(numProducers, 0);
+
+    auto consumeUpdates = [&] () {
+        KisUpdateInfoList list;
+        compressor.takeUpdateInfo(list);
+
+        Q_FOREACH (KisUpdateInfoSP info, list) {
+            const QRect rect = info->dirtyImageRect();
+            const int producerIndex = rect.y();
+
+            QVERIFY(producerIndex >= 0 && producerIndex < numProducers);
+
+            // the updates of every producer come exactly once and in order
+            QCOMPARE(rect.x(), nextUpdateIndex[producerIndex]);
+            nextUpdateIndex[producerIndex]++;
+        }
+    };
+
+    while (numRunningProducers.loadAcquire() > 0) {
+        consumeUpdates();
+        if (QTest::currentTestFailed()) break;
+    }
+
+    threadPool.waitForDone();
+    consumeUpdates();
+
+    for (int i = 0; i < numProducers; i++) {
+        QCOMPARE(nextUpdateIndex[i], numUpdates);
+    }
+}
+
+SIMPLE_TEST_MAIN(KisCanvasUpdatesCompressorTest)
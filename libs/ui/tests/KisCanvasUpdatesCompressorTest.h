@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISCANVASUPDATESCOMPRESSORTEST_H
+#define KISCANVASUPDATESCOMPRESSORTEST_H
+
+#include <simpletest.h>
+
+class KisCanvasUpdatesCompressorTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testCompression();
+    void testMultipleProducers();
+};
+
+#endif // KISCANVASUPDATESCOMPRESSORTEST_H
@@ -0,0 +1,203 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDisplayFilterLut3DTest.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <canvas/KisDisplayFilterLut3D.h>
+#include <canvas/kis_display_filter.h>
+#include <canvas/kis_exposure_gamma_correction_interface.h>
+
+#include <brushengine/kis_random_source.h>
+
+
+namespace {
+
+/**
+ * A display filter similar to a typical OCIO view transform: it mixes
+ * the channels, applies the exposure, compresses the highlights and
+ * encodes the result with sRGB curve
+ */
+class TestDisplayFilter : public KisDisplayFilter
+{
+public:
+    TestDisplayFilter(bool mixAlpha = false)
+        : m_mixAlpha(mixAlpha)
+    {
+    }
+
+    QString program() const override {
+        return QString();
+    }
+
+    void setupTextures(GLFunctions *f, QOpenGLShaderProgram *program) const override {
+        Q_UNUSED(f);
+        Q_UNUSED(program);
+    }
+
+    void filter(quint8 *pixels, quint32 numPixels) override {
+        float *pixel = reinterpret_cast<float*>(pixels);
+
+        for (quint32 i = 0; i < numPixels; i++, pixel += 4) {
+            const float r = 0.8f * pixel[0] + 0.15f * pixel[1] + 0.05f * pixel[2];
+            const float g = 0.1f * pixel[0] + 0.8f * pixel[1] + 0.1f * pixel[2];
+            const float b = 0.05f * pixel[0] + 0.15f * pixel[1] + 0.8f * pixel[2];
+
+            pixel[0] = encode(r);
+            pixel[1] = encode(g);
+            pixel[2] = encode(b);
+
+            if (m_mixAlpha) {
+                pixel[0] *= pixel[3];
+            }
+        }
+    }
+
+    void approximateInverseTransformation(quint8 *pixels, quint32 numPixels) override {
+        Q_UNUSED(pixels);
+        Q_UNUSED(numPixels);
+    }
+
+    void approximateForwardTransformation(quint8 *pixels, quint32 numPixels) override {
+        Q_UNUSED(pixels);
+        Q_UNUSED(numPixels);
+    }
+
+    bool useInternalColorManagement() const override {
+        return false;
+    }
+
+    KisExposureGammaCorrectionInterface *correctionInterface() const override {
+        return KisDumbExposureGammaCorrectionInterface::instance();
+    }
+
+    bool lockCurrentColorVisualRepresentation() const override {
+        return false;
+    }
+
+    bool updateShader() override {
+        return false;
+    }
+
+private:
+    static float encode(float x) {
+        const float exposure = 1.5f;
+
+        x *= exposure;
+        x = x / (1.0f + x);
+
+        return x <= 0.0031308f ? 12.92f * x : 1.055f * std::pow(x, 1.0f / 2.4f) - 0.055f;
+    }
+
+private:
+    bool m_mixAlpha;
+};
+
+std::vector<float> testPixels(int numPixels)
+{
+    KisRandomSource randomSource(1);
+
+    std::vector<float> pixels(4 * numPixels);
+
+    for (int i = 0; i < numPixels; i++) {
+        for (int ch = 0; ch < 3; ch++) {
+            // cover the whole HDR range of the LUT with more samples in the shadows
+            pixels[4 * i + ch] = std::pow(float(randomSource.generateNormalized()), 3.0f) * 256.0f;
+        }
+        pixels[4 * i + 3] = randomSource.generateNormalized();
+    }
+
+    return pixels;
+}
+
+}
+
+void KisDisplayFilterLut3DTest::testLutMatchesFilter()
+{
+    QSharedPointer<KisDisplayFilter> filter(new TestDisplayFilter());
+
+    KisDisplayFilterLut3D lut(filter);
+    QVERIFY(lut.isValid());
+
+    const int numPixels = 100000;
+
+    std::vector<float> exact = testPixels(numPixels);
+    std::vector<float> approximated = exact;
+
+    filter->filter(reinterpret_cast<quint8*>(exact.data()), numPixels);
+    lut.apply(reinterpret_cast<quint8*>(approximated.data()), numPixels);
+
+    /**
+     * The error of the LUT should be invisible on the display,
+     * that is, below two levels of an 8-bit display
+     */
+    const float tolerance = 2.0f / 255.0f;
+
+    float maxError = 0.0f;
+
+    for (int i = 0; i < numPixels; i++) {
+        for (int ch = 0; ch < 3; ch++) {
+            maxError = qMax(maxError, std::abs(exact[4 * i + ch] - approximated[4 * i + ch]));
+        }
+
+        // the alpha channel is never touched by the LUT
+        QCOMPARE(approximated[4 * i + 3], exact[4 * i + 3]);
+    }
+
+    QVERIFY2(maxError <= tolerance,
+             QString("max error: %1, tolerance: %2").arg(maxError).arg(tolerance).toLatin1());
+}
+
+void KisDisplayFilterLut3DTest::testOutOfDomainPixels()
+{
+    QSharedPointer<KisDisplayFilter> filter(new TestDisplayFilter());
+
+    KisDisplayFilterLut3D lut(filter);
+    QVERIFY(lut.isValid());
+
+    // the pixels outside the domain of the LUT are passed to the filter directly
+    std::vector<float> exact = {
+        -0.5f, 0.2f, 0.3f, 1.0f,
+        300.0f, 1.0f, 0.5f, 1.0f,
+        0.5f, 1000.0f, 2000.0f, 0.5f,
+        0.1f, 0.2f, -1e-3f, 1.0f
+    };
+    const int numPixels = exact.size() / 4;
+
+    std::vector<float> approximated = exact;
+
+    filter->filter(reinterpret_cast<quint8*>(exact.data()), numPixels);
+    lut.apply(reinterpret_cast<quint8*>(approximated.data()), numPixels);
+
+    for (int i = 0; i < int(exact.size()); i++) {
+        QCOMPARE(approximated[i], exact[i]);
+    }
+}
+
+void KisDisplayFilterLut3DTest::testAlphaDependentFilter()
+{
+    QSharedPointer<KisDisplayFilter> filter(new TestDisplayFilter(true));
+
+    KisDisplayFilterLut3D lut(filter);
+    QVERIFY(!lut.isValid());
+
+    const int numPixels = 1000;
+
+    std::vector<float> exact = testPixels(numPixels);
+    std::vector<float> approximated = exact;
+
+    filter->filter(reinterpret_cast<quint8*>(exact.data()), numPixels);
+    lut.apply(reinterpret_cast<quint8*>(approximated.data()), numPixels);
+
+    for (int i = 0; i < int(exact.size()); i++) {
+        QCOMPARE(approximated[i], exact[i]);
+    }
+}
+
+SIMPLE_TEST_MAIN(KisDisplayFilterLut3DTest)
@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDISPLAYFILTERLUT3DTEST_H
+#define KISDISPLAYFILTERLUT3DTEST_H
+
+#include <simpletest.h>
+
+class KisDisplayFilterLut3DTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testLutMatchesFilter();
+    void testOutOfDomainPixels();
+    void testAlphaDependentFilter();
+};
+
+#endif // KISDISPLAYFILTERLUT3DTEST_H
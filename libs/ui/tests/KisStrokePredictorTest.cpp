@@ -0,0 +1,85 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisStrokePredictorTest.h"
+
+#include "KisStrokePredictor.h"
+#include "kis_paint_information.h"
+
+#include <kis_algebra_2d.h>
+
+namespace {
+KisPaintInformation event(qreal x, qreal y, qreal time)
+{
+    return KisPaintInformation(QPointF(x, y), 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, time, 0.0);
+}
+
+bool fuzzyComparePoints(const QPointF &p1, const QPointF &p2)
+{
+    return KisAlgebra2D::norm(p1 - p2) < 1e-6;
+}
+}
+
+void KisStrokePredictorTest::testDirectionFilter()
+{
+    KisStrokePredictor predictor;
+    predictor.reset(event(0, 0, 0));
+
+    QVERIFY(predictor.direction().isNull());
+
+    predictor.addEvent(event(10, 0, 10));
+    QVERIFY(fuzzyComparePoints(predictor.direction(), QPointF(1, 0)));
+
+    // the event without movement doesn't change the direction
+    predictor.addEvent(event(10, 0, 20));
+    QVERIFY(fuzzyComparePoints(predictor.direction(), QPointF(1, 0)));
+
+    // the turn is averaged with the previous direction
+    predictor.addEvent(event(10, 10, 30));
+    QVERIFY(fuzzyComparePoints(predictor.direction(), QPointF(M_SQRT1_2, M_SQRT1_2)));
+
+    // the reverse of the direction is taken as is
+    predictor.addEvent(event(0, 0, 40));
+    QVERIFY(fuzzyComparePoints(predictor.direction(), QPointF(-M_SQRT1_2, -M_SQRT1_2)));
+
+    // reset forgets the direction
+    predictor.reset(event(0, 0, 50));
+    QVERIFY(predictor.direction().isNull());
+    QCOMPARE(predictor.predictedPaintInformation(1.0).pos(), QPointF(0, 0));
+}
+
+void KisStrokePredictorTest::testDistanceCap()
+{
+    KisStrokePredictor predictor;
+
+    // 1 px/ms, predicted 30 px ahead
+    predictor.reset(event(0, 0, 0));
+    predictor.addEvent(event(10, 0, 10));
+    predictor.addEvent(event(20, 0, 20));
+
+    QCOMPARE(predictor.predictedDistance(1.0), 30.0);
+    QCOMPARE(predictor.predictedDistance(0.25), 30.0);
+
+    // the cap of 64 screen pixels is 16 image pixels at 400%
+    QCOMPARE(predictor.predictedDistance(4.0), 16.0);
+    QVERIFY(fuzzyComparePoints(predictor.predictedPaintInformation(4.0).pos(), QPointF(36, 0)));
+
+    // 10 px/ms, capped by the distance on screen
+    predictor.reset(event(0, 0, 0));
+    predictor.addEvent(event(0, 100, 10));
+    predictor.addEvent(event(0, 200, 20));
+
+    QCOMPARE(predictor.predictedDistance(1.0), 64.0);
+    QCOMPARE(predictor.predictedDistance(0.5), 128.0);
+    QCOMPARE(predictor.predictedDistance(0.1), 300.0);
+    QVERIFY(fuzzyComparePoints(predictor.predictedPaintInformation(1.0).pos(), QPointF(0, 264)));
+
+    // the predicted event keeps the sensors of the last event
+    QCOMPARE(predictor.predictedPaintInformation(1.0).pressure(), 1.0);
+    QCOMPARE(predictor.predictedPaintInformation(1.0).currentTime(), 20.0);
+}
+
+SIMPLE_TEST_MAIN(KisStrokePredictorTest)
@@ -0,0 +1,87 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisStrokePredictor.h"
+
+#include <QPointF>
+
+#include "kis_algebra_2d.h"
+#include <brushengine/kis_paint_information.h>
+#include <brushengine/KisStrokeSpeedMeasurer.h>
+
+namespace {
+// The time window, in milliseconds, used for measuring the speed of the pen
+const int PREDICTION_SPEED_WINDOW = 50;
+
+// How far ahead, in milliseconds, the pen position is extrapolated. The
+// distance is limited by PREDICTION_MAX_DISTANCE, measured in screen pixels.
+const qreal PREDICTION_TIME = 30.0;
+const qreal PREDICTION_MAX_DISTANCE = 64.0;
+}
+
+struct KisStrokePredictor::Private
+{
+    KisStrokeSpeedMeasurer speedMeasurer {PREDICTION_SPEED_WINDOW};
+    KisPaintInformation lastEvent;
+    QPointF direction;
+};
+
+KisStrokePredictor::KisStrokePredictor()
+    : m_d(new Private)
+{
+}
+
+KisStrokePredictor::~KisStrokePredictor()
+{
+}
+
+void KisStrokePredictor::reset(const KisPaintInformation &pi)
+{
+    m_d->speedMeasurer.reset();
+    m_d->speedMeasurer.addSample(pi.pos(), pi.currentTime());
+    m_d->lastEvent = pi;
+    m_d->direction = QPointF();
+}
+
+void KisStrokePredictor::addEvent(const KisPaintInformation &pi)
+{
+    const QPointF diff = pi.pos() - m_d->lastEvent.pos();
+    const qreal length = KisAlgebra2D::norm(diff);
+
+    if (length > 0.0) {
+        // average with the previous direction to filter out the jitter of the
+        // pen, but if the pen reverses, just take the new direction
+        const QPointF direction = m_d->direction + diff / length;
+        const qreal directionLength = KisAlgebra2D::norm(direction);
+        m_d->direction = directionLength > 1e-3 ? direction / directionLength : diff / length;
+    }
+
+    m_d->speedMeasurer.addSample(pi.pos(), pi.currentTime());
+    m_d->lastEvent = pi;
+}
+
+KisPaintInformation KisStrokePredictor::lastEvent() const
+{
+    return m_d->lastEvent;
+}
+
+QPointF KisStrokePredictor::direction() const
+{
+    return m_d->direction;
+}
+
+qreal KisStrokePredictor::predictedDistance(qreal effectiveZoom) const
+{
+    const qreal maxDistance = PREDICTION_MAX_DISTANCE / effectiveZoom;
+    return qMin(m_d->speedMeasurer.currentSpeed() * PREDICTION_TIME, maxDistance);
+}
+
+KisPaintInformation KisStrokePredictor::predictedPaintInformation(qreal effectiveZoom) const
+{
+    KisPaintInformation result = m_d->lastEvent;
+    result.setPos(result.pos() + predictedDistance(effectiveZoom) * m_d->direction);
+    return result;
+}
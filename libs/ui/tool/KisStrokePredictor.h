@@ -0,0 +1,60 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSTROKEPREDICTOR_H
+#define KISSTROKEPREDICTOR_H
+
+#include <QScopedPointer>
+
+#include "kritaui_export.h"
+
+class QPointF;
+class KisPaintInformation;
+
+/**
+ * Extrapolates the position of the pen from the raw (unsmoothed)
+ * input events. Used by KisToolFreehandHelper for showing the
+ * predicted path ahead of the smoothed stroke.
+ *
+ * The direction of the pen is averaged with the previous one to
+ * filter out the jitter of the tablet, the speed is measured by
+ * KisStrokeSpeedMeasurer. The predicted distance is limited by
+ * a constant number of screen pixels, so it depends on the zoom.
+ */
+class KRITAUI_EXPORT KisStrokePredictor
+{
+public:
+    KisStrokePredictor();
+    ~KisStrokePredictor();
+
+    /**
+     * Starts a new stroke at \p pi
+     */
+    void reset(const KisPaintInformation &pi);
+    void addEvent(const KisPaintInformation &pi);
+
+    KisPaintInformation lastEvent() const;
+
+    /**
+     * The filtered direction of the pen, a unit vector or a null
+     * point if the pen hasn't moved yet
+     */
+    QPointF direction() const;
+
+    /**
+     * \return the distance the pen is expected to pass from the last
+     *         event, limited by the constant distance on screen
+     */
+    qreal predictedDistance(qreal effectiveZoom) const;
+
+    KisPaintInformation predictedPaintInformation(qreal effectiveZoom) const;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISSTROKEPREDICTOR_H
@@ -56,6 +56,14 @@ public:
     void setStabilizeSensors(bool value);
     bool stabilizeSensors() const;
 
+    /**
+     * Show the extrapolated path of the pen ahead of the smoothed
+     * stroke, so that the smoothing lag is not visible while painting.
+     * Used in weighted smoothing and stabilizer modes only.
+     */
+    void setPredictStroke(bool value);
+    bool predictStroke() const;
+
 Q_SIGNALS:
     void sigSmoothingTypeChanged();
 
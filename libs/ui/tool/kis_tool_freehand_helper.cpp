@@ -9,6 +9,9 @@
 #include <QTimer>
 #include <QElapsedTimer>
 #include <QQueue>
+#include <QPainterPath>
+#include <QDir>
+#include <QDateTime>
 
 #include <klocalizedstring.h>
 
@@ -26,10 +29,12 @@
 #include "kis_update_time_monitor.h"
 #include "kis_stabilized_events_sampler.h"
 #include "KisStabilizerDelayedPaintHelper.h"
+#include "KisStrokePredictor.h"
 #include "kis_config.h"
 
 #include "kis_random_source.h"
 #include "KisPerStrokeRandomSource.h"
+#include <brushengine/KisPaintInformationRecording.h>
 
 #include "strokes/freehand_stroke.h"
 #include "strokes/KisFreehandStrokeInfo.h"
@@ -103,7 +108,19 @@ struct KisToolFreehandHelper::Private
     KisStabilizedEventsSampler stabilizedSampler;
     KisStabilizerDelayedPaintHelper stabilizerDelayedPaintHelper;
 
+    // Raw input of the current stroke, recorded only when
+    // KRITA_RECORD_STROKES_DIR is set (see KisPaintInformationRecording)
+    QString recordingDir;
+    QSize recordingCanvasSize;
+    KisPaintInformationRecording::Stroke recordedStroke;
+
+    // Extrapolates the raw (unsmoothed) input for the stroke prediction
+    KisStrokePredictor strokePredictor;
+
     qreal effectiveSmoothnessDistance() const;
+    void saveRecordedStroke();
+
+    bool usePrediction() const;
 };
 
 
@@ -119,6 +136,8 @@ KisToolFreehandHelper::KisToolFreehandHelper(KisPaintingInformationBuilder *info
     m_d->smoothingOptions = KisSmoothingOptionsSP(
                 smoothingOptions ? smoothingOptions : new KisSmoothingOptions());
 
+    m_d->recordingDir = qEnvironmentVariable("KRITA_RECORD_STROKES_DIR");
+
     m_d->fakeDabRandomSource = new KisRandomSource();
     m_d->fakeStrokeRandomSource = new KisPerStrokeRandomSource();
 
@@ -221,6 +240,39 @@ KisOptimizedBrushOutline KisToolFreehandHelper::paintOpOutline(const QPointF &sa
         outline.addEllipse(info.pos(), R, R);
     }
 
+    if (m_d->resources && !m_d->strokeInfos.isEmpty() && m_d->usePrediction()) {
+        /**
+         * The predicted part of the stroke is shown as a part of the
+         * outline, which is a temporary overlay regenerated on every
+         * update. As soon as the real input arrives, the prediction is
+         * recalculated from it, so the speculative dabs never get into
+         * the image and need no reconciliation with the painted ones.
+         *
+         * The outline of the predicted dab is shown only when the user
+         * has the outline visible while painting, the trail is always
+         * shown.
+         */
+        KisPaintInformation predictedInfo =
+            m_d->strokePredictor.predictedPaintInformation(m_d->resources->effectiveZoom());
+
+        QPainterPath trail;
+        trail.moveTo(info.pos());
+        trail.lineTo(m_d->strokePredictor.lastEvent().pos());
+        trail.lineTo(predictedInfo.pos());
+        outline.addPath(trail);
+
+        if (mode.isVisible) {
+            KisDistanceInformation predictedDistanceInfo = distanceInfo;
+            KisPaintInformation::DistanceInformationRegistrar predictedRegistrar =
+                predictedInfo.registerDistanceInformation(&predictedDistanceInfo);
+
+            predictedInfo.setRandomSource(m_d->fakeDabRandomSource);
+            predictedInfo.setPerStrokeRandomSource(m_d->fakeStrokeRandomSource);
+
+            outline.addPath(settings->brushOutline(predictedInfo, mode, currentPhysicalZoom()));
+        }
+    }
+
     return outline;
 }
 
@@ -275,6 +327,14 @@ void KisToolFreehandHelper::initPaintImpl(qreal startAngle,
 
     m_d->previousPaintInformation = pi;
 
+    m_d->recordedStroke.clear();
+    if (!m_d->recordingDir.isEmpty()) {
+        m_d->recordingCanvasSize = image->size();
+        m_d->recordedStroke.append(pi);
+    }
+
+    m_d->strokePredictor.reset(pi);
+
     m_d->resources = new KisResourcesSnapshot(image,
                                               currentNode,
                                               resourceManager,
@@ -445,6 +505,18 @@ void KisToolFreehandHelper::paintEvent(KoPointerEvent *event)
                                              elapsedStrokeTime());
     KisUpdateTimeMonitor::instance()->reportMouseMove(info.pos());
 
+    /**
+     * paint() is also fed by the airbrushing timer with the smoothed
+     * position, so record and predict the real pointer events only
+     */
+    if (!m_d->recordingDir.isEmpty()) {
+        m_d->recordedStroke.append(info);
+    }
+
+    if (m_d->usePrediction()) {
+        m_d->strokePredictor.addEvent(info);
+    }
+
     paint(info);
 }
 
@@ -643,6 +715,30 @@ void KisToolFreehandHelper::endPaint()
     m_d->strokesFacade->endStroke(m_d->strokeId);
     m_d->strokeId.clear();
     m_d->infoBuilder->reset();
+
+    if (!m_d->recordedStroke.isEmpty()) {
+        m_d->saveRecordedStroke();
+    }
+}
+
+bool KisToolFreehandHelper::Private::usePrediction() const
+{
+    return smoothingOptions->predictStroke() &&
+        (smoothingOptions->smoothingType() == KisSmoothingOptions::WEIGHTED_SMOOTHING ||
+         smoothingOptions->smoothingType() == KisSmoothingOptions::STABILIZER);
+}
+
+void KisToolFreehandHelper::Private::saveRecordedStroke()
+{
+    KisPaintInformationRecording recording;
+    recording.setCanvasSize(recordingCanvasSize);
+    recording.addStroke(recordedStroke);
+    recordedStroke.clear();
+
+    const QString fileName =
+        QString("stroke-%1.kpir").arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss-zzz"));
+
+    recording.save(QDir(recordingDir).absoluteFilePath(fileName));
 }
 
 void KisToolFreehandHelper::cancelPaint()
@@ -669,6 +765,7 @@ void KisToolFreehandHelper::cancelPaint()
 
     // see a comment in endPaint()
     m_d->strokeInfos.clear();
+    m_d->recordedStroke.clear();
 
     m_d->strokesFacade->cancelStroke(m_d->strokeId);
     m_d->strokeId.clear();
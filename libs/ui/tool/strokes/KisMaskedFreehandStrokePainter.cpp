@@ -128,6 +128,17 @@ std::pair<int, bool> KisMaskedFreehandStrokePainter::doAsyncronousUpdate(QVector
     return result;
 }
 
+bool KisMaskedFreehandStrokePainter::hasPipelinedAsyncronousUpdates() const
+{
+    KIS_SAFE_ASSERT_RECOVER_NOOP(m_stroke);
+
+    /**
+     * Masking updates need all the dabs of the update to be
+     * painted before the dirty signals are issued
+     */
+    return !m_mask && m_stroke->painter->paintOp()->hasPipelinedAsyncronousUpdates();
+}
+
 bool KisMaskedFreehandStrokePainter::hasDirtyRegion() const
 {
     KIS_SAFE_ASSERT_RECOVER_NOOP(m_stroke);
@@ -60,6 +60,7 @@ public:
     // paintop overrides
 
     std::pair<int, bool> doAsyncronousUpdate(QVector<KisRunnableStrokeJobData*> &jobs);
+    bool hasPipelinedAsyncronousUpdates() const;
     bool hasDirtyRegion() const;
     QVector<QRect> takeDirtyRegion();
 
@@ -246,15 +246,34 @@ void FreehandStrokeStrategy::tryDoUpdate(bool forceEnd)
                 std::tie(m_d->currentUpdatePeriod, needsMoreUpdates) =
                     maskedPainter->doAsyncronousUpdate(jobs);
 
+                const bool isPipelined =
+                    !forceEnd && !needsMaskingUpdates() &&
+                    maskedPainter->hasPipelinedAsyncronousUpdates();
+
                 if (!jobs.isEmpty() ||
                     maskedPainter->hasDirtyRegion() ||
                     (forceEnd && needsMoreUpdates)) {
 
-                    KritaUtils::addJobSequential(jobs,
-                        [this] () {
-                            this->issueSetDirtySignals();
-                        }
-                    );
+                    if (isPipelined) {
+                        /**
+                         * The dirty region contains only the rects of the already
+                         * finished updates, so we don't need to wait for the jobs
+                         * in flight. The entry lock guarantees that the region is
+                         * not changed by a concurrent doAsyncronousUpdate() call.
+                         */
+                        KritaUtils::addJobUniquelyCuncurrent(jobs,
+                            [this] () {
+                                std::lock_guard<std::mutex> l(m_d->updateEntryMutex);
+                                this->issueSetDirtySignals();
+                            }
+                        );
+                    } else {
+                        KritaUtils::addJobSequential(jobs,
+                            [this] () {
+                                this->issueSetDirtySignals();
+                            }
+                        );
+                    }
 
                     if (forceEnd && needsMoreUpdates) {
                         KritaUtils::addJobSequential(jobs,
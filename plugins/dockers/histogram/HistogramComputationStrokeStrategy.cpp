@@ -7,11 +7,79 @@
 #include "HistogramComputationStrokeStrategy.h"
 
 #include "KoColorSpace.h"
+#include "KoColorModelStandardIds.h"
 
 #include "krita_utils.h"
 #include "kis_image.h"
 #include "kis_sequential_iterator.h"
 
+
+void HistogramComputationCache::addDirtyRect(const QRect &rect)
+{
+    QMutexLocker l(&m_mutex);
+    m_dirtyRects.append(rect);
+}
+
+void HistogramComputationCache::invalidateAll()
+{
+    QMutexLocker l(&m_mutex);
+    m_needsFullUpdate = true;
+    m_dirtyRects.clear();
+}
+
+QVector<int> HistogramComputationCache::startUpdate(const QRect &imageBounds, const KoColorSpace *colorSpace)
+{
+    QMutexLocker l(&m_mutex);
+
+    if (m_needsFullUpdate ||
+        m_imageBounds != imageBounds ||
+        !m_colorSpace || !(*m_colorSpace == *colorSpace)) {
+
+        m_imageBounds = imageBounds;
+        m_colorSpace = colorSpace;
+
+        const int imageSize = imageBounds.width() * imageBounds.height();
+        m_nSkip = 1 + (imageSize >> 20); //for speed use about 1M pixels for computing histograms
+
+        m_patches = KritaUtils::splitRectIntoPatches(imageBounds, KritaUtils::optimalPatchSize());
+        m_partials.clear();
+        m_partials.resize(m_patches.size());
+        m_validPatches.fill(false, m_patches.size());
+
+        m_needsFullUpdate = false;
+    } else {
+        Q_FOREACH (const QRect &rc, m_dirtyRects) {
+            for (int i = 0; i < m_patches.size(); i++) {
+                if (m_patches[i].intersects(rc)) {
+                    m_validPatches[i] = false;
+                }
+            }
+        }
+    }
+
+    m_dirtyRects.clear();
+
+    QVector<int> patchesToUpdate;
+    for (int i = 0; i < m_validPatches.size(); i++) {
+        if (!m_validPatches[i]) {
+            patchesToUpdate.append(i);
+        }
+    }
+
+    return patchesToUpdate;
+}
+
+void HistogramComputationCache::finishUpdate(const QVector<int> &patchIndexes)
+{
+    QMutexLocker l(&m_mutex);
+
+    Q_FOREACH (int index, patchIndexes) {
+        KIS_SAFE_ASSERT_RECOVER(index < m_validPatches.size()) { continue; }
+        m_validPatches[index] = true;
+    }
+}
+
+
 struct HistogramComputationStrokeStrategy::Private
 {
 
@@ -25,19 +93,21 @@ struct HistogramComputationStrokeStrategy::Private
         {}
 
         QRect rectToCalculate;
-        int jobId; // id in the list of results
+        int jobId; // id of the patch in the cache
     };
 
     KisImageSP image;
-    std::vector<HistVector> results;
+    HistogramComputationCacheSP cache;
+    QVector<int> updatedPatches;
 };
 
 
-HistogramComputationStrokeStrategy::HistogramComputationStrokeStrategy(KisImageSP image)
+HistogramComputationStrokeStrategy::HistogramComputationStrokeStrategy(KisImageSP image, HistogramComputationCacheSP cache)
     : KisIdleTaskStrokeStrategy(QLatin1String("ComputeHistogram"), kundo2_i18n("Update histogram"))
     , m_d(new Private)
 {
     m_d->image = image;
+    m_d->cache = cache;
 }
 
 HistogramComputationStrokeStrategy::~HistogramComputationStrokeStrategy()
@@ -48,14 +118,16 @@ void HistogramComputationStrokeStrategy::initStrokeCallback()
 {
     KisIdleTaskStrokeStrategy::initStrokeCallback();
 
+    HistogramComputationCache *cache = m_d->cache.data();
+
+    m_d->updatedPatches =
+        cache->startUpdate(m_d->image->bounds(),
+                           m_d->image->projection()->colorSpace());
+
     QVector<KisStrokeJobData*> jobsData;
-    int i = 0;
-    QVector<QRect> tileRects = KritaUtils::splitRectIntoPatches(m_d->image->bounds(), KritaUtils::optimalPatchSize());
-    m_d->results.resize(tileRects.size());
 
-    Q_FOREACH (const QRect &tileRectangle, tileRects) {
-        jobsData << new HistogramComputationStrokeStrategy::Private::ProcessData(tileRectangle, i);
-        i++;
+    Q_FOREACH (int index, m_d->updatedPatches) {
+        jobsData << new HistogramComputationStrokeStrategy::Private::ProcessData(cache->m_patches[index], index);
     }
     addMutatedJobs(jobsData);
 }
@@ -72,76 +144,108 @@ void HistogramComputationStrokeStrategy::doStrokeCallback(KisStrokeJobData *data
     QRect calculate = d_pd->rectToCalculate;
 
     KisPaintDeviceSP m_dev = m_d->image->projection();
-    QRect imageBounds = m_d->image->bounds();
 
     const KoColorSpace *cs = m_dev->colorSpace();
     quint32 channelCount = m_dev->channelCount();
     quint32 pixelSize = m_dev->pixelSize();
 
-    int imageSize = imageBounds.width() * imageBounds.height();
-    int nSkip = 1 + (imageSize >> 20); //for speed use about 1M pixels for computing histograms
+    /**
+     * Every job writes into its own partial, so the cache is
+     * not locked here
+     */
+    HistVector &partial = m_d->cache->m_partials[d_pd->jobId];
+    const int nSkip = m_d->cache->m_nSkip;
+
+    initiateVector(partial, cs);
 
     if (calculate.isEmpty())
         return;
 
-    initiateVector(m_d->results[d_pd->jobId], cs);
-
     quint32 toSkip = nSkip;
 
     KisSequentialConstIterator it(m_dev, calculate);
 
-    int numConseqPixels = it.nConseqPixels();
-    while (it.nextPixels(numConseqPixels)) {
+    if (cs->colorDepthId() == Integer8BitsColorDepthID) {
+        /**
+         * For 8-bit color spaces the channel value is its bin, so
+         * we can avoid calling the virtual scaleToU8() for every
+         * channel of every pixel
+         */
+        std::vector<quint32*> bins(channelCount);
+        for (quint32 chan = 0; chan < channelCount; chan++) {
+            bins[chan] = partial[chan].data();
+        }
 
-        numConseqPixels = it.nConseqPixels();
-        const quint8* pixel = it.rawDataConst();
-        for (int k = 0; k < numConseqPixels; ++k) {
-            if (--toSkip == 0) {
-                for (int chan = 0; chan < (int)channelCount; ++chan) {
-                    m_d->results[d_pd->jobId][chan][cs->scaleToU8(pixel, chan)]++;
+        int numConseqPixels = it.nConseqPixels();
+        while (it.nextPixels(numConseqPixels)) {
+
+            numConseqPixels = it.nConseqPixels();
+            const quint8* pixel = it.rawDataConst();
+            for (int k = 0; k < numConseqPixels; ++k) {
+                if (--toSkip == 0) {
+                    for (quint32 chan = 0; chan < channelCount; ++chan) {
+                        bins[chan][pixel[chan]]++;
+                    }
+                    toSkip = nSkip;
+                }
+                pixel += pixelSize;
+            }
+        }
+    } else {
+        int numConseqPixels = it.nConseqPixels();
+        while (it.nextPixels(numConseqPixels)) {
+
+            numConseqPixels = it.nConseqPixels();
+            const quint8* pixel = it.rawDataConst();
+            for (int k = 0; k < numConseqPixels; ++k) {
+                if (--toSkip == 0) {
+                    for (int chan = 0; chan < (int)channelCount; ++chan) {
+                        partial[chan][cs->scaleToU8(pixel, chan)]++;
+                    }
+                    toSkip = nSkip;
                 }
-                toSkip = nSkip;
+                pixel += pixelSize;
             }
-            pixel += pixelSize;
         }
     }
 }
 
 void HistogramComputationStrokeStrategy::finishStrokeCallback()
 {
+    HistogramComputationCache *cache = m_d->cache.data();
+
     HistogramData hisData;
-    hisData.colorSpace = m_d->image->projection()->colorSpace();
+    hisData.colorSpace = cache->m_colorSpace;
 
-    if (m_d->results.size() == 1) {
-        hisData.bins = m_d->results[0];
-        emit computationResultReady(hisData);
+    if (cache->m_partials.size() == 1) {
+        hisData.bins = cache->m_partials[0];
     } else {
-
-        quint32 channelCount = m_d->image->projection()->channelCount();
+        quint32 channelCount = hisData.colorSpace->channelCount();
 
         initiateVector(hisData.bins, hisData.colorSpace);
 
-        for (int chan = 0; chan < (int)channelCount; chan++) {
-            int bsize = hisData.bins[chan].size();
+        for (const HistVector &partial : cache->m_partials) {
+            for (int chan = 0; chan < (int)channelCount; chan++) {
+                const quint32 *src = partial[chan].data();
+                quint32 *dst = hisData.bins[chan].data();
+                const int bsize = hisData.bins[chan].size();
 
-            for (int bi = 0; bi < bsize; bi++) {
-                hisData.bins[chan][bi] = 0;
-                for (int i = 0; i < (int)m_d->results.size(); i++) {
-                    hisData.bins[chan][bi] += m_d->results[i][chan][bi];
+                for (int bi = 0; bi < bsize; bi++) {
+                    dst[bi] += src[bi];
                 }
             }
         }
-
-        emit computationResultReady(hisData);
     }
 
+    cache->finishUpdate(m_d->updatedPatches);
+
+    emit computationResultReady(hisData);
+
     KisIdleTaskStrokeStrategy::finishStrokeCallback();
 }
 
 void HistogramComputationStrokeStrategy::initiateVector(HistVector &vec, const KoColorSpace *colorSpace)
 {
-    vec.resize(colorSpace->channelCount());
-    for (auto &bin : vec) {
-        bin.resize(std::numeric_limits<quint8>::max() + 1);
-    }
+    vec.assign(colorSpace->channelCount(),
+               std::vector<quint32>(std::numeric_limits<quint8>::max() + 1, 0));
 }
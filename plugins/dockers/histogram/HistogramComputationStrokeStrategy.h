@@ -8,6 +8,8 @@
 #define HISTOGRAMCOMPUTATIONSTROKESTRATEGY_H
 
 #include <KisIdleTaskStrokeStrategy.h>
+#include <QMutex>
+#include <QSharedPointer>
 #include <vector>
 
 class KoColorSpace;
@@ -22,12 +24,57 @@ struct HistogramData
 };
 Q_DECLARE_METATYPE(HistogramData)
 
+/**
+ * Keeps the partial histograms of the image patches between the runs
+ * of HistogramComputationStrokeStrategy. Only the patches touched by
+ * the image updates since the previous run are recalculated, the rest
+ * of the partials are reused.
+ *
+ * addDirtyRect() and invalidateAll() may be called from any thread.
+ */
+class HistogramComputationCache
+{
+public:
+    void addDirtyRect(const QRect &rect);
+    void invalidateAll();
+
+private:
+    friend class HistogramComputationStrokeStrategy;
+
+    /**
+     * Applies the accumulated dirty rects and returns the indexes of
+     * the patches that should be recalculated
+     */
+    QVector<int> startUpdate(const QRect &imageBounds, const KoColorSpace *colorSpace);
+
+    /**
+     * Marks the patches recalculated by the stroke as valid. If the
+     * stroke is cancelled, the patches stay invalid.
+     */
+    void finishUpdate(const QVector<int> &patchIndexes);
+
+private:
+    QMutex m_mutex;
+    QVector<QRect> m_dirtyRects;
+    bool m_needsFullUpdate {true};
+
+    QRect m_imageBounds;
+    const KoColorSpace *m_colorSpace {0};
+    int m_nSkip {1};
+
+    QVector<QRect> m_patches;
+    std::vector<HistVector> m_partials;
+    QVector<bool> m_validPatches;
+};
+
+using HistogramComputationCacheSP = QSharedPointer<HistogramComputationCache>;
+
 
 class HistogramComputationStrokeStrategy : public KisIdleTaskStrokeStrategy
 {
     Q_OBJECT
 public:
-    HistogramComputationStrokeStrategy(KisImageSP image);
+    HistogramComputationStrokeStrategy(KisImageSP image, HistogramComputationCacheSP cache);
     ~HistogramComputationStrokeStrategy() override;
 
 private:
@@ -18,11 +18,13 @@
 #include "KoChannelInfo.h"
 #include "KisViewManager.h"
 #include "kis_canvas2.h"
+#include "kis_image.h"
 
 
 
 HistogramDockerWidget::HistogramDockerWidget(QWidget *parent, const char *name, Qt::WindowFlags f)
     : KisWidgetWithIdleTask<QLabel>(parent, f)
+    , m_cache(new HistogramComputationCache())
 {
     setObjectName(name);
     qRegisterMetaType<HistogramData>();
@@ -30,6 +32,7 @@ HistogramDockerWidget::HistogramDockerWidget(QWidget *parent, const char *name,
 
 HistogramDockerWidget::~HistogramDockerWidget()
 {
+    disconnect(m_imageUpdatesConnection);
 }
 
 void HistogramDockerWidget::receiveNewHistogram(HistogramData data)
@@ -43,11 +46,23 @@ KisIdleTasksManager::TaskGuard HistogramDockerWidget::registerIdleTask(KisCanvas
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(canvas, KisIdleTasksManager::TaskGuard());
 
+    disconnect(m_imageUpdatesConnection);
+    m_cache->invalidateAll();
+
+    /**
+     * The updates are reported from the updater threads, so the
+     * dirty rects are added into the cache directly
+     */
+    HistogramComputationCacheSP cache = m_cache;
+    m_imageUpdatesConnection =
+        connect(canvas->image().data(), &KisImage::sigImageUpdated,
+                [cache] (const QRect &rc) { cache->addDirtyRect(rc); });
+
     return
         canvas->viewManager()->idleTasksManager()->
         addIdleTaskWithGuard([this](KisImageSP image) {
             HistogramComputationStrokeStrategy* strategy =
-                new HistogramComputationStrokeStrategy(image);
+                new HistogramComputationStrokeStrategy(image, m_cache);
 
             connect(strategy, SIGNAL(computationResultReady(HistogramData)), this, SLOT(receiveNewHistogram(HistogramData)));
 
@@ -57,6 +72,9 @@ KisIdleTasksManager::TaskGuard HistogramDockerWidget::registerIdleTask(KisCanvas
 
 void HistogramDockerWidget::clearCachedState()
 {
+    disconnect(m_imageUpdatesConnection);
+    m_cache->invalidateAll();
+
     m_colorSpace = 0;
     m_histogramData.clear();
 }
@@ -34,6 +34,9 @@ private:
     void clearCachedState() override;
 
 private:
+    HistogramComputationCacheSP m_cache;
+    QMetaObject::Connection m_imageUpdatesConnection;
+
     HistVector m_histogramData;
     const KoColorSpace* m_colorSpace {0};
     bool m_smoothHistogram {false};
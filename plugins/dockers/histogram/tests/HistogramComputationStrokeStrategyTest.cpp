@@ -0,0 +1,130 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "HistogramComputationStrokeStrategyTest.h"
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_image.h>
+#include <kis_paint_layer.h>
+#include <kis_sequential_iterator.h>
+#include <kis_pointer_utils.h>
+
+#include "../HistogramComputationStrokeStrategy.h"
+
+
+namespace {
+
+/**
+ * The histogram calculated in the simplest possible way: every
+ * pixel of the projection is binned with KoColorSpace::scaleToU8()
+ */
+HistVector calculateReferenceBins(KisPaintDeviceSP dev, const QRect &rect)
+{
+    const KoColorSpace *cs = dev->colorSpace();
+
+    HistVector bins(cs->channelCount(), std::vector<quint32>(256, 0));
+
+    KisSequentialConstIterator it(dev, rect);
+    while (it.nextPixel()) {
+        for (quint32 chan = 0; chan < cs->channelCount(); chan++) {
+            bins[chan][cs->scaleToU8(it.rawDataConst(), chan)]++;
+        }
+    }
+
+    return bins;
+}
+
+HistVector calculateCachedBins(KisImageSP image, HistogramComputationCacheSP cache)
+{
+    HistogramComputationStrokeStrategy *strategy =
+        new HistogramComputationStrokeStrategy(image, cache);
+
+    HistVector result;
+
+    // the signal is emitted from the stroke's thread, so the connection is direct
+    QObject::connect(strategy, &HistogramComputationStrokeStrategy::computationResultReady,
+                     [&result] (HistogramData data) { result = data.bins; });
+
+    KisStrokeId id = image->startStroke(strategy);
+    image->endStroke(id);
+    image->waitForDone();
+
+    return result;
+}
+
+void fillRect(KisPaintLayerSP layer, const QRect &rect, const QColor &color)
+{
+    const KoColorSpace *cs = layer->paintDevice()->colorSpace();
+    layer->paintDevice()->fill(rect, KoColor(color, cs));
+    layer->setDirty(rect);
+}
+
+}
+
+void HistogramComputationStrokeStrategyTest::testCachedPartials_data()
+{
+    QTest::addColumn<bool>("use16Bit");
+
+    // the 8-bit color spaces use the fast path of binning
+    QTest::newRow("8bit") << false;
+    QTest::newRow("16bit") << true;
+}
+
+void HistogramComputationStrokeStrategyTest::testCachedPartials()
+{
+    QFETCH(bool, use16Bit);
+
+    const KoColorSpace *cs = use16Bit ?
+        KoColorSpaceRegistry::instance()->rgb16() :
+        KoColorSpaceRegistry::instance()->rgb8();
+
+    /**
+     * The image is small enough to be binned without skipping the
+     * pixels, but is split into several patches
+     */
+    const QRect imageRect(0, 0, 1300, 700);
+
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "histogram test");
+    KisPaintLayerSP layer = new KisPaintLayer(image, "paint1", OPACITY_OPAQUE_U8, cs);
+    image->addNode(layer, image->root());
+
+    fillRect(layer, imageRect, QColor(200, 180, 160));
+    fillRect(layer, QRect(50, 40, 700, 300), QColor(10, 120, 250));
+    fillRect(layer, QRect(600, 300, 650, 380), QColor(255, 0, 30, 128));
+    image->initialRefreshGraph();
+
+    HistogramComputationCacheSP cache = toQShared(new HistogramComputationCache());
+
+    HistVector bins = calculateCachedBins(image, cache);
+    QVERIFY(bins == calculateReferenceBins(image->projection(), imageRect));
+
+    /**
+     * Change a part of the image crossing the border of the patches,
+     * only the patches touched by the change are recalculated
+     */
+    const HistVector oldBins = bins;
+    const QRect changedRect(400, 450, 300, 200);
+
+    fillRect(layer, changedRect, QColor(0, 255, 0));
+    image->waitForDone();
+    cache->addDirtyRect(changedRect);
+
+    bins = calculateCachedBins(image, cache);
+    QVERIFY(bins != oldBins);
+    QVERIFY(bins == calculateReferenceBins(image->projection(), imageRect));
+
+    // the partially updated cache gives the same result as a new one
+    QVERIFY(bins == calculateCachedBins(image, toQShared(new HistogramComputationCache())));
+
+    // a full invalidation recalculates everything
+    cache->invalidateAll();
+    QVERIFY(bins == calculateCachedBins(image, cache));
+}
+
+SIMPLE_TEST_MAIN(HistogramComputationStrokeStrategyTest)
@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef HISTOGRAMCOMPUTATIONSTROKESTRATEGYTEST_H
+#define HISTOGRAMCOMPUTATIONSTROKESTRATEGYTEST_H
+
+#include <simpletest.h>
+
+class HistogramComputationStrokeStrategyTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testCachedPartials_data();
+    void testCachedPartials();
+};
+
+#endif // HISTOGRAMCOMPUTATIONSTROKESTRATEGYTEST_H
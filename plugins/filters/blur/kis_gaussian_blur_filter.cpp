@@ -48,6 +48,7 @@ KisFilterConfigurationSP KisGaussianBlurFilter::defaultConfiguration(KisResource
     config->setProperty("horizRadius", 5);
     config->setProperty("vertRadius", 5);
     config->setProperty("lockAspect", true);
+    config->setProperty("method", KisGaussianKernel::Auto);
 
     return config;
 }
@@ -67,6 +68,15 @@ void KisGaussianBlurFilter::processImpl(KisPaintDeviceSP device,
     const qreal horizontalRadius = t.scale(config->getDouble("horizRadius", 5));
     const qreal verticalRadius = t.scale(config->getDouble("vertRadius", 5));
 
+    /**
+     * The configurations saved before the method was introduced
+     * should still use the exact kernel
+     */
+    const KisGaussianKernel::Method method =
+        KisGaussianKernel::Method(qBound(int(KisGaussianKernel::Exact),
+                                         config->getInt("method", KisGaussianKernel::Exact),
+                                         int(KisGaussianKernel::Auto)));
+
     QBitArray channelFlags;
     if (config) {
         channelFlags = config->channelFlags();
@@ -77,7 +87,8 @@ void KisGaussianBlurFilter::processImpl(KisPaintDeviceSP device,
 
     KisGaussianKernel::applyGaussian(device, rect,
                                      horizontalRadius, verticalRadius,
-                                     channelFlags, progressUpdater);
+                                     channelFlags, progressUpdater,
+                                     false, BORDER_REPEAT, method);
 }
 
 QRect KisGaussianBlurFilter::neededRect(const QRect & rect, const KisFilterConfigurationSP _config, int lod) const
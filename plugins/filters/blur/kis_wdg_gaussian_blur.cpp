@@ -17,6 +17,7 @@
 #include <kis_paint_device.h>
 #include <kis_processing_information.h>
 #include <KisGlobalResourcesInterface.h>
+#include <kis_gaussian_kernel.h>
 
 #include "ui_wdg_gaussian_blur.h"
 
@@ -47,6 +48,7 @@ KisWdgGaussianBlur::KisWdgGaussianBlur(bool usedForMasks, QWidget * parent) : Ki
     connect(m_widget->aspectButton, SIGNAL(keepAspectRatioChanged(bool)), this, SLOT(aspectLockChanged(bool)));
     connect(m_widget->horizontalRadius, SIGNAL(valueChanged(qreal)), SIGNAL(sigConfigurationItemChanged()));
     connect(m_widget->verticalRadius, SIGNAL(valueChanged(qreal)), SIGNAL(sigConfigurationItemChanged()));
+    connect(m_widget->cmbMethod, SIGNAL(currentIndexChanged(int)), SIGNAL(sigConfigurationItemChanged()));
 }
 
 KisWdgGaussianBlur::~KisWdgGaussianBlur()
@@ -60,6 +62,7 @@ KisPropertiesConfigurationSP KisWdgGaussianBlur::configuration() const
     config->setProperty("horizRadius", m_widget->horizontalRadius->value());
     config->setProperty("vertRadius", m_widget->verticalRadius->value());
     config->setProperty("lockAspect", m_widget->aspectButton->keepAspectRatio());
+    config->setProperty("method", m_widget->cmbMethod->currentIndex());
     return config;
 }
 
@@ -75,6 +78,7 @@ void KisWdgGaussianBlur::setConfiguration(const KisPropertiesConfigurationSP con
     if (config->getProperty("lockAspect", value)) {
         m_widget->aspectButton->setKeepAspectRatio(value.toBool());
     }
+    m_widget->cmbMethod->setCurrentIndex(config->getInt("method", KisGaussianKernel::Exact));
 }
 
 void KisWdgGaussianBlur::horizontalRadiusChanged(qreal v)
@@ -119,6 +119,7 @@ void KisColorSmudgeStrategyBase::initializePaintingImpl(const KoColorSpace *dstC
                                                         const QString &colorRateCompositeOpId)
 {
     m_blendDevice = new KisFixedPaintDevice(dstColorSpace, m_memoryAllocator);
+    m_smearSourceDevice = new KisFixedPaintDevice(dstColorSpace, m_memoryAllocator);
     m_smearOp = dstColorSpace->compositeOp(smearCompositeOp(smearAlpha));
     m_colorRateOp = dstColorSpace->compositeOp(colorRateCompositeOpId);
     m_preparedDullingColor.convertTo(dstColorSpace);
@@ -268,18 +269,58 @@ void KisColorSmudgeStrategyBase::blendInBackgroundWithSmearing(KisFixedPaintDevi
     if (m_smearOp->id() == COMPOSITE_COPY && smudgeRateOpacity == OPACITY_OPAQUE_U8) {
         src->readBytes(dst->data(), srcRect);
     } else {
-        src->readBytes(dst->data(), dstRect);
+        KIS_SAFE_ASSERT_RECOVER_NOOP(srcRect.size() == dstRect.size());
+
+        const int pixelSize = dst->pixelSize();
+        const int rowSize = dstRect.width() * pixelSize;
+        const QRect unitedRect = srcRect | dstRect;
+
+        /**
+         * The source rect of the dab is usually shifted from the destination
+         * one by the spacing only, so it is cheaper to read their bounding
+         * rect at once than to read both the rects separately.
+         */
+        if (qint64(unitedRect.width()) * unitedRect.height() <=
+            2 * qint64(dstRect.width()) * dstRect.height()) {
+
+            m_smearSourceDevice->setRect(unitedRect);
+            m_smearSourceDevice->lazyGrowBufferWithoutInitialization();
+            src->readBytes(m_smearSourceDevice->data(), unitedRect);
+
+            const int unitedRowStride = unitedRect.width() * pixelSize;
+
+            auto unitedPixelPtr = [&] (const QPoint &pt) {
+                const QPoint offset = pt - unitedRect.topLeft();
+                return m_smearSourceDevice->data() + offset.y() * unitedRowStride + offset.x() * pixelSize;
+            };
+
+            const quint8 *dstRowPtr = unitedPixelPtr(dstRect.topLeft());
+            quint8 *blendRowPtr = dst->data();
+
+            for (int y = 0; y < dstRect.height(); y++) {
+                memcpy(blendRowPtr, dstRowPtr, rowSize);
+                dstRowPtr += unitedRowStride;
+                blendRowPtr += rowSize;
+            }
+
+            m_smearOp->composite(dst->data(), rowSize,
+                                 unitedPixelPtr(srcRect.topLeft()), unitedRowStride,
+                                 0, 0,
+                                 dstRect.height(), dstRect.width(),
+                                 smudgeRateOpacity);
+        } else {
+            src->readBytes(dst->data(), dstRect);
 
-        KisFixedPaintDevice tempDevice(src->colorSpace(), m_memoryAllocator);
-        tempDevice.setRect(srcRect);
-        tempDevice.lazyGrowBufferWithoutInitialization();
+            m_smearSourceDevice->setRect(srcRect);
+            m_smearSourceDevice->lazyGrowBufferWithoutInitialization();
 
-        src->readBytes(tempDevice.data(), srcRect);
-        m_smearOp->composite(dst->data(), dstRect.width() * dst->pixelSize(),
-                             tempDevice.data(), dstRect.width() * tempDevice.pixelSize(), // stride should be random non-zero
-                             0, 0,
-                             1, dstRect.width() * dstRect.height(),
-                             smudgeRateOpacity);
+            src->readBytes(m_smearSourceDevice->data(), srcRect);
+            m_smearOp->composite(dst->data(), rowSize,
+                                 m_smearSourceDevice->data(), rowSize, // stride should be random non-zero
+                                 0, 0,
+                                 1, dstRect.width() * dstRect.height(),
+                                 smudgeRateOpacity);
+        }
     }
 }
 
@@ -120,6 +120,12 @@ protected:
     const KoCompositeOp * m_smearOp {nullptr};
 private:
     KisFixedPaintDeviceSP m_blendDevice;
+
+    /**
+     * The buffer for the smeared source pixels. It is reused
+     * by all the dabs of the stroke to avoid reallocations.
+     */
+    KisFixedPaintDeviceSP m_smearSourceDevice;
     bool m_useDullingMode {true};
 };
 
@@ -38,6 +38,7 @@
 #include <KisRunnableStrokeJobData.h>
 #include <KisRunnableStrokeJobUtils.h>
 #include <KisRunnableStrokeJobsInterface.h>
+#include <tool/strokes/FreehandStrokeRunnableJobDataWithUpdate.h>
 
 #include <QSharedPointer>
 #include <QThread>
@@ -162,6 +163,9 @@ struct KisBrushOp::UpdateSharedState
 
     // final report
     QVector<QRect> allDirtyRects;
+
+    // the number of compositing jobs left in the pipelined mode
+    QAtomicInt numPendingJobs;
 };
 
 void KisBrushOp::addMirroringJobs(Qt::Orientation direction,
@@ -205,10 +209,33 @@ void KisBrushOp::addMirroringJobs(Qt::Orientation direction,
     state->allDirtyRects.append(rects);
 }
 
+bool KisBrushOp::hasPipelinedAsyncronousUpdates() const
+{
+    /**
+     * Mirroring needs sequential passes over the dabs, and the
+     * line of the pixel brush is painted directly into the painter
+     * by the painting jobs, which may overlap with the compositing
+     */
+    const bool paintsLinesDirectly =
+        m_sharpnessOption.isChecked() && m_brush &&
+        m_brush->width() == 1 && m_brush->height() == 1;
+
+    return !painter()->hasMirroring() && !paintsLinesDirectly;
+}
+
 std::pair<int, bool> KisBrushOp::doAsyncronousUpdate(QVector<KisRunnableStrokeJobData*> &jobs)
 {
+    QMutexLocker l(&m_updateStateMutex);
+
     bool someDabsAreStillInQueue = false;
     const bool hasPreparedDabsAtStart = m_dabExecutor->hasPreparedDabs();
+    const bool isPipelined = hasPipelinedAsyncronousUpdates();
+
+    if (!m_pipelinedDirtyRects.isEmpty()) {
+        painter()->addDirtyRects(m_pipelinedDirtyRects);
+        painter()->setAverageOpacity(m_pipelinedAverageOpacity);
+        m_pipelinedDirtyRects.clear();
+    }
 
     if (!m_updateSharedState && hasPreparedDabsAtStart) {
 
@@ -295,6 +322,31 @@ std::pair<int, bool> KisBrushOp::doAsyncronousUpdate(QVector<KisRunnableStrokeJo
 
         state->dabRenderingTimer.start();
 
+        if (isPipelined) {
+            /**
+             * There is no sequential job finishing the update, the last
+             * compositing job does that instead. It lets the dabs of the
+             * next update be rendered while the current ones are still
+             * being composited. The next update doesn't start until this
+             * one is finished, so the order of overlapping dabs is kept.
+             */
+            state->numPendingJobs = rects.size();
+
+            Q_FOREACH (const QRect &rc, rects) {
+                KritaUtils::addJobConcurrent(jobs,
+                    [rc, state, this, someDabsAreStillInQueue] () {
+                        state->painter->bltFixed(rc, state->dabsQueue);
+
+                        if (!state->numPendingJobs.deref()) {
+                            finishAsyncronousUpdate(state, someDabsAreStillInQueue, true);
+                        }
+                    }
+                );
+            }
+
+            return std::make_pair(m_currentUpdatePeriod, true);
+        }
+
         Q_FOREACH (const QRect &rc, rects) {
             KritaUtils::addJobConcurrent(jobs,
                 [rc, state] () {
@@ -323,51 +375,76 @@ std::pair<int, bool> KisBrushOp::doAsyncronousUpdate(QVector<KisRunnableStrokeJo
 
         KritaUtils::addJobSequential(jobs,
                 [state, this, someDabsAreStillInQueue] () {
-                    Q_FOREACH(const QRect &rc, state->allDirtyRects) {
-                        state->painter->addDirtyRect(rc);
-                    }
+                    finishAsyncronousUpdate(state, someDabsAreStillInQueue, false);
+                }
+        );
+    } else if (m_updateSharedState && (hasPreparedDabsAtStart || isPipelined)) {
+        someDabsAreStillInQueue = true;
+    }
+
+    return std::make_pair(m_currentUpdatePeriod, someDabsAreStillInQueue);
+}
+
+void KisBrushOp::finishAsyncronousUpdate(UpdateSharedStateSP state,
+                                         bool someDabsAreStillInQueue,
+                                         bool isPipelined)
+{
+    QMutexLocker l(&m_updateStateMutex);
+
+    if (isPipelined) {
+        /**
+         * The compositing jobs are running concurrently with the stroke,
+         * so the dirty rects and the opacity are passed to the painter
+         * in the next call to doAsyncronousUpdate()
+         */
+        m_pipelinedDirtyRects.append(state->allDirtyRects);
+        m_pipelinedAverageOpacity = state->dabsQueue.last().averageOpacity;
+    } else {
+        Q_FOREACH(const QRect &rc, state->allDirtyRects) {
+            state->painter->addDirtyRect(rc);
+        }
 
-                    state->painter->setAverageOpacity(state->dabsQueue.last().averageOpacity);
+        state->painter->setAverageOpacity(state->dabsQueue.last().averageOpacity);
+    }
 
-                    const int updateRenderingTime = state->dabRenderingTimer.elapsed();
-                    const qreal dabRenderingTime = m_dabExecutor->averageDabRenderingTime();
+    const int updateRenderingTime = state->dabRenderingTimer.elapsed();
+    const qreal dabRenderingTime = m_dabExecutor->averageDabRenderingTime();
 
-                    m_avgNumDabs(state->dabsQueue.size());
+    m_avgNumDabs(state->dabsQueue.size());
 
-                    const qreal currentUpdateTimePerDab = qreal(updateRenderingTime) / state->dabsQueue.size();
-                    m_avgUpdateTimePerDab(currentUpdateTimePerDab);
+    const qreal currentUpdateTimePerDab = qreal(updateRenderingTime) / state->dabsQueue.size();
+    m_avgUpdateTimePerDab(currentUpdateTimePerDab);
 
-                    /**
-                     * NOTE: using currentUpdateTimePerDab in the calculation for the next update time instead
-                     *       of the average one makes rendering speed about 40% faster. It happens because the
-                     *       adaptation period is shorter than if it used
-                     */
-                    const qreal totalRenderingTimePerDab = dabRenderingTime + currentUpdateTimePerDab;
+    /**
+     * NOTE: using currentUpdateTimePerDab in the calculation for the next update time instead
+     *       of the average one makes rendering speed about 40% faster. It happens because the
+     *       adaptation period is shorter than if it used
+     */
+    const qreal totalRenderingTimePerDab = dabRenderingTime + currentUpdateTimePerDab;
 
-                    const int approxDabRenderingTime =
-                        qreal(totalRenderingTimePerDab) * m_avgNumDabs.rollingMean() / m_idealNumRects;
+    const int approxDabRenderingTime =
+        qreal(totalRenderingTimePerDab) * m_avgNumDabs.rollingMean() / m_idealNumRects;
 
-                    m_currentUpdatePeriod =
-                        someDabsAreStillInQueue ? m_minUpdatePeriod :
-                        qBound(m_minUpdatePeriod, int(1.5 * approxDabRenderingTime), m_maxUpdatePeriod);
+    m_currentUpdatePeriod =
+        someDabsAreStillInQueue ? m_minUpdatePeriod :
+        qBound(m_minUpdatePeriod, int(1.5 * approxDabRenderingTime), m_maxUpdatePeriod);
 
 
-                    { // debug chunk
+    { // debug chunk
 //                        ENTER_FUNCTION() << ppVar(state->allDirtyRects.size()) << ppVar(state->dabsQueue.size()) << ppVar(dabRenderingTime) << ppVar(updateRenderingTime);
 //                        ENTER_FUNCTION() << ppVar(m_currentUpdatePeriod) << ppVar(someDabsAreStillInQueue);
-                    }
+    }
 
-                    // release all the dab devices
-                    state->dabsQueue.clear();
+    // release all the dab devices
+    state->dabsQueue.clear();
 
-                    m_updateSharedState.clear();
-                }
-        );
-    } else if (m_updateSharedState && hasPreparedDabsAtStart) {
-        someDabsAreStillInQueue = true;
-    }
+    m_updateSharedState.clear();
 
-    return std::make_pair(m_currentUpdatePeriod, someDabsAreStillInQueue);
+    if (isPipelined) {
+        // make the stroke fetch the dirty rects as soon as possible
+        painter()->runnableStrokeJobsInterface()->addRunnableJob(
+            new FreehandStrokeRunnableJobDataWithUpdate([] () {}, KisStrokeJobData::CONCURRENT));
+    }
 }
 
 KisSpacingInformation KisBrushOp::updateSpacingImpl(const KisPaintInformation &info) const
@@ -24,6 +24,7 @@
 #include <KisRollingMeanAccumulatorWrapper.h>
 
 #include <QElapsedTimer>
+#include <QMutex>
 
 class KisPainter;
 class KisColorSource;
@@ -42,6 +43,7 @@ public:
     void paintLine(const KisPaintInformation &pi1, const KisPaintInformation &pi2, KisDistanceInformation *currentDistance) override;
 
     std::pair<int, bool> doAsyncronousUpdate(QVector<KisRunnableStrokeJobData *> &jobs) override;
+    bool hasPipelinedAsyncronousUpdates() const override;
 
 protected:
     KisSpacingInformation paintAt(const KisPaintInformation& info) override;
@@ -58,6 +60,10 @@ protected:
                           UpdateSharedStateSP state,
                           QVector<KisRunnableStrokeJobData*> &jobs);
 
+    void finishAsyncronousUpdate(UpdateSharedStateSP state,
+                                 bool someDabsAreStillInQueue,
+                                 bool isPipelined);
+
     UpdateSharedStateSP m_updateSharedState;
 
 
@@ -88,6 +94,15 @@ private:
 
     const int m_minUpdatePeriod;
     const int m_maxUpdatePeriod;
+
+    /**
+     * In the pipelined mode the update is finished by the last of its
+     * compositing jobs, which may run concurrently with doAsyncronousUpdate(),
+     * so the state of the updates is guarded by the mutex
+     */
+    QMutex m_updateStateMutex;
+    QVector<QRect> m_pipelinedDirtyRects;
+    qreal m_pipelinedAverageOpacity = 0.0;
 };
 
 #endif // KIS_BRUSHOP_H_
@@ -6,35 +6,44 @@
 
 #include "bristle.h"
 
-Bristle::Bristle(float x, float y, float length)
-    : m_x(x)
-    , m_y(y)
-    , m_prevX(x)
-    , m_prevY(y)
-    , m_length(length)
-{}
-
-Bristle::~Bristle()
-{
-}
+#include <KoColorSpace.h>
+#include <kis_assert.h>
 
-void Bristle::setLength(float length)
+void Bristles::append(float x, float y, float length, const KoColor &color)
 {
-    m_length = length;
-}
-
+    const int pixelSize = color.colorSpace()->pixelSize();
 
-void Bristle::addInk(float value)
-{
-    m_inkAmount = m_inkAmount + value;
+    if (m_x.isEmpty()) {
+        m_pixelSize = pixelSize;
+    }
+    KIS_SAFE_ASSERT_RECOVER_RETURN(pixelSize == m_pixelSize);
+
+    m_x.append(x);
+    m_y.append(y);
+    m_prevX.append(x);
+    m_prevY.append(y);
+    m_length.append(length);
+    m_inkAmount.append(0.0f);
+    m_counter.append(0);
+
+    const int offset = m_colors.size();
+    m_colors.resize(offset + m_pixelSize);
+    memcpy(m_colors.data() + offset, color.data(), m_pixelSize);
 }
 
-void Bristle::removeInk(float value)
+void Bristles::clear()
 {
-    m_inkAmount = m_inkAmount - value;
+    m_x.clear();
+    m_y.clear();
+    m_prevX.clear();
+    m_prevY.clear();
+    m_length.clear();
+    m_inkAmount.clear();
+    m_counter.clear();
+    m_colors.clear();
 }
 
-void Bristle::setInkAmount(float inkAmount)
+void Bristles::setInkAmount(int i, float inkAmount)
 {
     if (inkAmount > 1.0f) {
         inkAmount = 1.0f;
@@ -43,16 +52,5 @@ void Bristle::setInkAmount(float inkAmount)
         inkAmount = -1.0f;
     }
 
-    m_inkAmount = inkAmount;
-}
-
-void Bristle::setColor(const KoColor &color)
-{
-    m_color = color;
-}
-
-
-void Bristle::setEnabled(bool enabled)
-{
-    m_enabled = enabled;
+    m_inkAmount[i] = inkAmount;
 }
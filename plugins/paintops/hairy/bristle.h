@@ -8,100 +8,103 @@
 #define _BRISTLE_H_
 
 #include <cmath>
+#include <cstring>
+#include <QVector>
 #include <KoColor.h>
 
-class Bristle
+/**
+ * The state of all the bristles of the brush stored as a structure
+ * of arrays. Every bristle is addressed by its index, the arrays are
+ * contiguous, so the bristles can be split into ranges of consecutive
+ * indices and simulated by several threads. The neighbouring ranges
+ * may share a cache line at their boundary, so the ranges should be
+ * long enough to make this sharing negligible.
+ */
+class Bristles
 {
 
 public:
-    Bristle() = default;
-    Bristle(float x, float y, float length);
-    ~Bristle();
+    Bristles() = default;
 
-    inline float x() const {
-        return m_x;
-    }
+    void append(float x, float y, float length, const KoColor &color);
+    void clear();
 
-    inline float y() const {
-        return m_y;
+    inline int size() const {
+        return m_x.size();
     }
 
-    inline float prevX() const {
-        return m_prevX;
+    inline bool isEmpty() const {
+        return m_x.isEmpty();
     }
 
-    inline float prevY() const {
-        return m_prevY;
+    inline float x(int i) const {
+        return m_x[i];
     }
 
-    inline float length() const {
-        return m_length;
+    inline float y(int i) const {
+        return m_y[i];
     }
 
-    inline  const KoColor &color() const {
-        return m_color;
+    inline float prevX(int i) const {
+        return m_prevX[i];
     }
 
-    inline int counter() const {
-        return m_counter;
+    inline float prevY(int i) const {
+        return m_prevY[i];
     }
 
-    inline void upIncrement() {
-        m_counter++;
+    inline float length(int i) const {
+        return m_length[i];
     }
 
-    inline float inkAmount() const {
-        return m_inkAmount;
-    };
-
-    inline float distanceCenter() {
-        return std::sqrt(m_x * m_x + m_y * m_y);
+    inline const quint8 *color(int i) const {
+        return m_colors.constData() + i * m_pixelSize;
     }
 
-    inline void setX(float x) {
-        m_x = x;
+    inline int counter(int i) const {
+        return m_counter[i];
     }
-    inline void setY(float y) {
-        m_y = y;
+
+    inline void upIncrement(int i) {
+        m_counter[i]++;
     }
 
-    inline void setPrevX(float prevX) {
-        m_prevX = prevX;
+    inline float inkAmount(int i) const {
+        return m_inkAmount[i];
     }
 
-    inline void setPrevY(float prevY) {
-        m_prevY = prevY;
+    inline float distanceCenter(int i) const {
+        return std::sqrt(m_x[i] * m_x[i] + m_y[i] * m_y[i]);
     }
 
-    inline bool enabled() const {
-        return m_enabled;
+    inline void setPrevX(int i, float prevX) {
+        m_prevX[i] = prevX;
     }
 
-    void setLength(float length);
-    void setColor(const KoColor &color);
+    inline void setPrevY(int i, float prevY) {
+        m_prevY[i] = prevY;
+    }
 
-    void addInk(float value);
-    void removeInk(float value);
-    void setInkAmount(float inkAmount);
-    void setEnabled(bool enabled);
+    inline void setColor(int i, const KoColor &color) {
+        memcpy(m_colors.data() + i * m_pixelSize, color.data(), m_pixelSize);
+    }
 
+    void setInkAmount(int i, float inkAmount);
 
 private:
-    void init(float x, float y, float length);
-
-    // coordinates of bristle
-    float m_x{0.0f};
-    float m_y{0.0f};
-    float m_prevX{0.0f};
-    float m_prevY{0.0f};
-    float m_length{0.0f}; // z - coordinate
-    KoColor m_color;
-    float m_inkAmount{0.0f};
+    // coordinates of bristles
+    QVector<float> m_x;
+    QVector<float> m_y;
+    QVector<float> m_prevX;
+    QVector<float> m_prevY;
+    QVector<float> m_length; // z - coordinate
+    QVector<float> m_inkAmount;
 
     // new dimension in bristle
-    int m_counter{0};
+    QVector<int> m_counter;
 
-    bool m_enabled{true};
+    QVector<quint8> m_colors;
+    int m_pixelSize {0};
 };
 
 #endif
@@ -14,6 +14,9 @@
 #include <QVariant>
 #include <QHash>
 #include <QVector>
+#include <QThread>
+#include <QtConcurrent>
+#include <QtMath>
 
 #include <kis_types.h>
 #include <kis_random_accessor_ng.h>
@@ -25,6 +28,38 @@
 #include <ctime>
 
 
+namespace {
+/**
+ * The bristles are simulated in parallel only when there are
+ * enough of them to pay for the synchronization
+ */
+const int minBristlesPerChunk = 128;
+
+/**
+ * The ink is deposited into a local buffer covering the whole
+ * area of the stroke segment, unless the area is much bigger than
+ * the number of the pixels written by the bristles
+ */
+const int maxDabBufferPixelsPerWrite = 16;
+}
+
+struct HairyBrush::SimulationChunk
+{
+    int begin {0};
+    int end {0};
+
+    Trajectory trajectory;
+
+    // the ink dabs of the bristles of the chunk in the painting order
+    QVector<QPointF> positions;
+    QVector<quint8> colors;
+
+    qreal minX {0.0};
+    qreal minY {0.0};
+    qreal maxX {0.0};
+    qreal maxY {0.0};
+};
+
 HairyBrush::HairyBrush()
 {
     m_counter = 0;
@@ -36,9 +71,8 @@ HairyBrush::HairyBrush()
 
 HairyBrush::~HairyBrush()
 {
-    delete m_transfo;
-    qDeleteAll(m_bristles.begin(), m_bristles.end());
-    m_bristles.clear();
+    qDeleteAll(m_transfos);
+    m_transfos.clear();
 }
 
 
@@ -46,11 +80,13 @@ void HairyBrush::initAndCache()
 {
     m_compositeOp = m_dab->colorSpace()->compositeOp(COMPOSITE_OVER);
     m_pixelSize = m_dab->colorSpace()->pixelSize();
+    m_particleColor = KoColor(m_dab->colorSpace());
 
     if (m_properties->useSaturation) {
-        m_transfo = m_dab->colorSpace()->createColorTransformation("hsv_adjustment", m_params);
-        if (m_transfo) {
-            m_saturationId = m_transfo->parameterId("s");
+        KoColorTransformation *transfo = m_dab->colorSpace()->createColorTransformation("hsv_adjustment", m_params);
+        if (transfo) {
+            m_saturationId = transfo->parameterId("s");
+            m_transfos.append(transfo);
         }
     }
 }
@@ -64,7 +100,6 @@ void HairyBrush::fromDabWithDensity(KisFixedPaintDeviceSP dab, qreal density)
     int centerY = height * 0.5;
 
     // make mask
-    Bristle * bristle = nullptr;
     qreal alpha;
 
     quint8 * dabPointer = dab->data();
@@ -81,10 +116,8 @@ void HairyBrush::fromDabWithDensity(KisFixedPaintDeviceSP dab, qreal density)
                 if (density == 1.0 || randomSource.generateNormalized() <= density) {
                     memcpy(bristleColor.data(), dabPointer, pixelSize);
 
-                    bristle = new Bristle(x - centerX, y - centerY, alpha); // using value from image as length of bristle
-                    bristle->setColor(bristleColor);
-
-                    m_bristles.append(bristle);
+                    // using value from image as length of bristle
+                    m_bristles.append(x - centerX, y - centerY, alpha, bristleColor);
                 }
             }
             dabPointer += pixelSize;
@@ -120,11 +153,6 @@ void HairyBrush::paintLine(KisPaintDeviceSP dab, KisPaintDeviceSP layer, const K
     // this pressure controls shear and ink depletion
     qreal pressure = mousePressure * (pi2.pressure() * 2);
 
-    Bristle *bristle = 0;
-    KoColor bristleColor(dab->colorSpace());
-
-    m_dabAccessor = dab->createRandomAccessorNG();
-
     m_dab = dab;
 
     // initialization block
@@ -144,48 +172,154 @@ void HairyBrush::paintLine(KisPaintDeviceSP dab, KisPaintDeviceSP layer, const K
         }
     }
 
+    const int bristleCount = m_bristles.size();
+    if (!bristleCount) {
+        m_dab = nullptr;
+        return;
+    }
+
+    /**
+     * The random source is not thread-safe and the sequence of the
+     * random values should not depend on the splitting into chunks,
+     * so the jitter of all the bristles is generated beforehand
+     */
     KisRandomSourceSP randomSource = pi2.randomSource();
 
+    m_randomOffsets.resize(2 * bristleCount);
+    for (int i = 0; i < bristleCount; i++) {
+        m_randomOffsets[2 * i] = (randomSource->generateNormalized() * 2 - 1.0) * m_properties->randomFactor;
+        m_randomOffsets[2 * i + 1] = (randomSource->generateNormalized() * 2 - 1.0) * m_properties->randomFactor;
+    }
+
+    const int numChunks = qBound(1, bristleCount / minBristlesPerChunk, QThread::idealThreadCount());
+
+    // every chunk needs its own color transformation
+    if (!m_transfos.isEmpty()) {
+        while (m_transfos.size() < numChunks) {
+            m_transfos.append(m_dab->colorSpace()->createColorTransformation("hsv_adjustment", m_params));
+        }
+    }
+
+    QVector<SimulationChunk> chunks(numChunks);
+    for (int i = 0; i < numChunks; i++) {
+        chunks[i].begin = i * bristleCount / numChunks;
+        chunks[i].end = (i + 1) * bristleCount / numChunks;
+    }
+
+    if (numChunks > 1) {
+        auto simulateChunk = [&] (SimulationChunk &chunk) {
+            const int chunkIndex = &chunk - chunks.data();
+            simulateBristles(chunk, pi1, pi2, scale, angle, pressure,
+                             !m_transfos.isEmpty() ? m_transfos[chunkIndex] : nullptr);
+        };
+        QtConcurrent::blockingMap(chunks, simulateChunk);
+    } else {
+        simulateBristles(chunks[0], pi1, pi2, scale, angle, pressure,
+                         !m_transfos.isEmpty() ? m_transfos[0] : nullptr);
+    }
+
+    int numDabs = 0;
+    bool hasDabs = false;
+    QRectF dabsBounds;
+
+    Q_FOREACH (const SimulationChunk &chunk, chunks) {
+        if (chunk.positions.isEmpty()) continue;
+
+        const QRectF chunkBounds(QPointF(chunk.minX, chunk.minY), QPointF(chunk.maxX, chunk.maxY));
+        dabsBounds = hasDabs ? dabsBounds.united(chunkBounds) : chunkBounds;
+        hasDabs = true;
+        numDabs += chunk.positions.size();
+    }
+
+    if (!hasDabs) {
+        m_dab = nullptr;
+        return;
+    }
+
+    /**
+     * The dabs may be painted one pixel to the right and to the
+     * bottom of their position (see paintParticle())
+     */
+    m_dabBufferRect =
+        QRect(QPoint(qFloor(dabsBounds.left()) - 1, qFloor(dabsBounds.top()) - 1),
+              QPoint(qCeil(dabsBounds.right()) + 1, qCeil(dabsBounds.bottom()) + 1));
+
+    const int pixelsPerDab = m_properties->antialias ? 4 : 1;
+    m_useDabBuffer =
+        qint64(m_dabBufferRect.width()) * m_dabBufferRect.height() <=
+        qint64(numDabs) * pixelsPerDab * maxDabBufferPixelsPerWrite;
+
+    if (m_useDabBuffer) {
+        m_dabBuffer.resize(m_dabBufferRect.width() * m_dabBufferRect.height() * m_pixelSize);
+        m_dab->readBytes(m_dabBuffer.data(), m_dabBufferRect);
+    } else {
+        m_dabAccessor = m_dab->createRandomAccessorNG();
+    }
+
+    // the ink is deposited in the same order as the bristles go
+    Q_FOREACH (const SimulationChunk &chunk, chunks) {
+        const QPointF *position = chunk.positions.constData();
+        const quint8 *color = chunk.colors.constData();
+
+        for (int i = 0; i < chunk.positions.size(); i++) {
+            addBristleInk(*position, color);
+            position++;
+            color += m_pixelSize;
+        }
+    }
+
+    if (m_useDabBuffer) {
+        m_dab->writeBytes(m_dabBuffer.constData(), m_dabBufferRect);
+    }
+
+    m_dab = nullptr;
+    m_dabAccessor = nullptr;
+}
+
+void HairyBrush::simulateBristles(SimulationChunk &chunk, const KisPaintInformation &pi1, const KisPaintInformation &pi2,
+                                  qreal scale, qreal angle, qreal pressure, KoColorTransformation *transfo)
+{
+    qreal x1 = pi1.pos().x();
+    qreal y1 = pi1.pos().y();
+
+    qreal x2 = pi2.pos().x();
+    qreal y2 = pi2.pos().y();
+
     qreal fx1, fy1, fx2, fy2;
-    qreal randomX, randomY;
-    qreal shear;
+    qreal shear = pressure * m_properties->shearFactor;
+
+    QTransform transform;
+    KoColor bristleColor(m_dab->colorSpace());
 
     float inkDeplation = 0.0;
     int inkDepletionSize = m_properties->inkDepletionCurve.size();
-    int bristleCount = m_bristles.size();
     int bristlePathSize;
     qreal threshold = 1.0 - pi2.pressure();
-    for (int i = 0; i < bristleCount; i++) {
-
-        if (!m_bristles.at(i)->enabled()) continue;
-        bristle = m_bristles[i];
 
-        randomX = (randomSource->generateNormalized() * 2 - 1.0) * m_properties->randomFactor;
-        randomY = (randomSource->generateNormalized() * 2 - 1.0) * m_properties->randomFactor;
+    bool hasDabs = false;
 
-        shear = pressure * m_properties->shearFactor;
-
-        m_transform.reset();
-        m_transform.rotateRadians(-angle);
-        m_transform.scale(scale, scale);
-        m_transform.translate(randomX, randomY);
-        m_transform.shear(shear, shear);
+    for (int b = chunk.begin; b < chunk.end; b++) {
+        transform.reset();
+        transform.rotateRadians(-angle);
+        transform.scale(scale, scale);
+        transform.translate(m_randomOffsets.at(2 * b), m_randomOffsets.at(2 * b + 1));
+        transform.shear(shear, shear);
 
         if (firstStroke() || (!m_properties->connectedPath)) {
             // transform start dab
-            m_transform.map(bristle->x(), bristle->y(), &fx1, &fy1);
+            transform.map(m_bristles.x(b), m_bristles.y(b), &fx1, &fy1);
             // transform end dab
-            m_transform.map(bristle->x(), bristle->y(), &fx2, &fy2);
+            transform.map(m_bristles.x(b), m_bristles.y(b), &fx2, &fy2);
         }
         else {
             // continue the path of the bristle from the previous position
-            fx1 = bristle->prevX();
-            fy1 = bristle->prevY();
-            m_transform.map(bristle->x(), bristle->y(), &fx2, &fy2);
+            fx1 = m_bristles.prevX(b);
+            fy1 = m_bristles.prevY(b);
+            transform.map(m_bristles.x(b), m_bristles.y(b), &fx2, &fy2);
         }
         // remember the end point
-        bristle->setPrevX(fx2);
-        bristle->setPrevY(fy2);
+        m_bristles.setPrevX(b, fx2);
+        m_bristles.setPrevY(b, fy2);
 
         // all coords relative to device position
         fx1 += x1;
@@ -194,108 +328,123 @@ void HairyBrush::paintLine(KisPaintDeviceSP dab, KisPaintDeviceSP layer, const K
         fx2 += x2;
         fy2 += y2;
 
-        if (m_properties->threshold && (bristle->length() < threshold)) continue;
+        if (m_properties->threshold && (m_bristles.length(b) < threshold)) continue;
         // paint between first and last dab
-        const QVector<QPointF> bristlePath = m_trajectory.getLinearTrajectory(QPointF(fx1, fy1), QPointF(fx2, fy2), 1.0);
-        bristlePathSize = m_trajectory.size();
+        const QVector<QPointF> &bristlePath = chunk.trajectory.getLinearTrajectory(QPointF(fx1, fy1), QPointF(fx2, fy2), 1.0);
+        bristlePathSize = chunk.trajectory.size();
 
         // avoid overlapping bristle caps with antialias on
         if (m_properties->antialias) {
             bristlePathSize -= 1;
         }
 
-        memcpy(bristleColor.data(), bristle->color().data() , m_pixelSize);
+        memcpy(bristleColor.data(), m_bristles.color(b), m_pixelSize);
         for (int i = 0; i < bristlePathSize ; i++) {
 
             if (m_properties->inkDepletionEnabled) {
-                inkDeplation = fetchInkDepletion(bristle, inkDepletionSize);
+                inkDeplation = fetchInkDepletion(b, inkDepletionSize);
 
-                if (m_properties->useSaturation && m_transfo != 0) {
-                    saturationDepletion(bristle, bristleColor, pressure, inkDeplation);
+                if (m_properties->useSaturation && transfo != 0) {
+                    saturationDepletion(b, bristleColor, pressure, inkDeplation, transfo);
                 }
 
                 if (m_properties->useOpacity) {
-                    opacityDepletion(bristle, bristleColor, pressure, inkDeplation);
+                    opacityDepletion(b, bristleColor, pressure, inkDeplation);
                 }
 
             }
             else {
                 if (bristleColor.opacityU8() != 0) {
-                    bristleColor.setOpacity(bristle->length());
+                    bristleColor.setOpacity(m_bristles.length(b));
                 }
             }
 
-            addBristleInk(bristle, bristlePath.at(i), bristleColor);
-            bristle->setInkAmount(1.0 - inkDeplation);
-            bristle->upIncrement();
+            const QPointF &pos = bristlePath.at(i);
+
+            if (!hasDabs) {
+                chunk.minX = chunk.maxX = pos.x();
+                chunk.minY = chunk.maxY = pos.y();
+                hasDabs = true;
+            } else {
+                chunk.minX = qMin(chunk.minX, pos.x());
+                chunk.maxX = qMax(chunk.maxX, pos.x());
+                chunk.minY = qMin(chunk.minY, pos.y());
+                chunk.maxY = qMax(chunk.maxY, pos.y());
+            }
+
+            chunk.positions.append(pos);
+
+            const int offset = chunk.colors.size();
+            chunk.colors.resize(offset + m_pixelSize);
+            memcpy(chunk.colors.data() + offset, bristleColor.data(), m_pixelSize);
+
+            m_bristles.setInkAmount(b, 1.0 - inkDeplation);
+            m_bristles.upIncrement(b);
         }
 
     }
-    m_dab = nullptr;
-    m_dabAccessor = nullptr;
 }
 
 
-inline qreal HairyBrush::fetchInkDepletion(Bristle* bristle, int inkDepletionSize)
+inline qreal HairyBrush::fetchInkDepletion(int bristle, int inkDepletionSize)
 {
-    if (bristle->counter() >= inkDepletionSize - 1) {
+    if (m_bristles.counter(bristle) >= inkDepletionSize - 1) {
         return m_properties->inkDepletionCurve[inkDepletionSize - 1];
     } else {
-        return m_properties->inkDepletionCurve[bristle->counter()];
+        return m_properties->inkDepletionCurve[m_bristles.counter(bristle)];
     }
 }
 
 
-void HairyBrush::saturationDepletion(Bristle * bristle, KoColor &bristleColor, qreal pressure, qreal inkDeplation)
+void HairyBrush::saturationDepletion(int bristle, KoColor &bristleColor, qreal pressure, qreal inkDeplation, KoColorTransformation *transfo)
 {
     qreal saturation;
     if (m_properties->useWeights) {
         // new weighted way (experiment)
         saturation = (
                          (pressure * m_properties->pressureWeight) +
-                         (bristle->length() * m_properties->bristleLengthWeight) +
-                         (bristle->inkAmount() * m_properties->bristleInkAmountWeight) +
+                         (m_bristles.length(bristle) * m_properties->bristleLengthWeight) +
+                         (m_bristles.inkAmount(bristle) * m_properties->bristleInkAmountWeight) +
                          ((1.0 - inkDeplation) * m_properties->inkDepletionWeight)) - 1.0;
     }
     else {
         // old way of computing saturation
         saturation = (
                          pressure *
-                         bristle->length() *
-                         bristle->inkAmount() *
+                         m_bristles.length(bristle) *
+                         m_bristles.inkAmount(bristle) *
                          (1.0 - inkDeplation)) - 1.0;
 
     }
-    m_transfo->setParameter(m_transfo->parameterId("h"), 0.0);
-    m_transfo->setParameter(m_transfo->parameterId("v"), 0.0);
-    m_transfo->setParameter(m_saturationId, saturation);
-    m_transfo->setParameter(3, 1);//sets the type to
-    m_transfo->setParameter(4, false);//sets the colorize to none.
-    m_transfo->transform(bristleColor.data(), bristleColor.data() , 1);
+    transfo->setParameter(transfo->parameterId("h"), 0.0);
+    transfo->setParameter(transfo->parameterId("v"), 0.0);
+    transfo->setParameter(m_saturationId, saturation);
+    transfo->setParameter(3, 1);//sets the type to
+    transfo->setParameter(4, false);//sets the colorize to none.
+    transfo->transform(bristleColor.data(), bristleColor.data() , 1);
 }
 
-void HairyBrush::opacityDepletion(Bristle* bristle, KoColor& bristleColor, qreal pressure, qreal inkDeplation)
+void HairyBrush::opacityDepletion(int bristle, KoColor& bristleColor, qreal pressure, qreal inkDeplation)
 {
     qreal opacity = OPACITY_OPAQUE_F;
     if (m_properties->useWeights) {
         opacity = pressure * m_properties->pressureWeight +
-                  bristle->length() * m_properties->bristleLengthWeight +
-                  bristle->inkAmount() * m_properties->bristleInkAmountWeight +
+                  m_bristles.length(bristle) * m_properties->bristleLengthWeight +
+                  m_bristles.inkAmount(bristle) * m_properties->bristleInkAmountWeight +
                   (1.0 - inkDeplation) * m_properties->inkDepletionWeight;
     }
     else {
         opacity =
-            bristle->length() *
-            bristle->inkAmount();
+            m_bristles.length(bristle) *
+            m_bristles.inkAmount(bristle);
     }
 
     opacity = qBound(0.0, opacity, 1.0);
     bristleColor.setOpacity(opacity);
 }
 
-inline void HairyBrush::addBristleInk(Bristle *bristle,const QPointF &pos, const KoColor &color)
+inline void HairyBrush::addBristleInk(const QPointF &pos, const quint8 *color)
 {
-    Q_UNUSED(bristle);
     if (m_properties->antialias) {
         if (m_properties->useCompositing) {
             paintParticle(pos, color);
@@ -315,10 +464,23 @@ inline void HairyBrush::addBristleInk(Bristle *bristle,const QPointF &pos, const
     }
 }
 
-void HairyBrush::paintParticle(QPointF pos, const KoColor& color, qreal weight)
+inline quint8 *HairyBrush::dabPixel(int wx, int wy)
 {
+    if (m_useDabBuffer) {
+        return m_dabBuffer.data() +
+            ((wy - m_dabBufferRect.y()) * m_dabBufferRect.width() + wx - m_dabBufferRect.x()) * m_pixelSize;
+    }
+
+    m_dabAccessor->moveTo(wx, wy);
+    return m_dabAccessor->rawData();
+}
+
+void HairyBrush::paintParticle(QPointF pos, const quint8 *color, qreal weight)
+{
+    const KoColorSpace * cs = m_dab->colorSpace();
+
     // opacity top left, right, bottom left, right
-    quint8 opacity = color.opacityU8();
+    quint8 opacity = cs->opacityU8(color);
     opacity *= weight;
 
     int ipx = int (pos.x());
@@ -331,34 +493,32 @@ void HairyBrush::paintParticle(QPointF pos, const KoColor& color, qreal weight)
     quint8 bbl = qRound((1.0 - fx) * (fy)  * opacity);
     quint8 bbr = qRound((fx)  * (fy)  * opacity);
 
-    const KoColorSpace * cs = m_dab->colorSpace();
-
-    m_dabAccessor->moveTo(ipx  , ipy);
-    btl = quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, btl + cs->opacityU8(m_dabAccessor->rawData()), OPACITY_OPAQUE_U8));
-    memcpy(m_dabAccessor->rawData(), color.data(), cs->pixelSize());
-    cs->setOpacity(m_dabAccessor->rawData(), btl, 1);
-
-    m_dabAccessor->moveTo(ipx + 1, ipy);
-    btr =  quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, btr + cs->opacityU8(m_dabAccessor->rawData()), OPACITY_OPAQUE_U8));
-    memcpy(m_dabAccessor->rawData(), color.data(), cs->pixelSize());
-    cs->setOpacity(m_dabAccessor->rawData(), btr, 1);
-
-    m_dabAccessor->moveTo(ipx, ipy + 1);
-    bbl = quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, bbl + cs->opacityU8(m_dabAccessor->rawData()), OPACITY_OPAQUE_U8));
-    memcpy(m_dabAccessor->rawData(), color.data(), cs->pixelSize());
-    cs->setOpacity(m_dabAccessor->rawData(), bbl, 1);
-
-    m_dabAccessor->moveTo(ipx + 1, ipy + 1);
-    bbr = quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, bbr + cs->opacityU8(m_dabAccessor->rawData()), OPACITY_OPAQUE_U8));
-    memcpy(m_dabAccessor->rawData(), color.data(), cs->pixelSize());
-    cs->setOpacity(m_dabAccessor->rawData(), bbr, 1);
+    quint8 *pixel = dabPixel(ipx, ipy);
+    btl = quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, btl + cs->opacityU8(pixel), OPACITY_OPAQUE_U8));
+    memcpy(pixel, color, m_pixelSize);
+    cs->setOpacity(pixel, btl, 1);
+
+    pixel = dabPixel(ipx + 1, ipy);
+    btr =  quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, btr + cs->opacityU8(pixel), OPACITY_OPAQUE_U8));
+    memcpy(pixel, color, m_pixelSize);
+    cs->setOpacity(pixel, btr, 1);
+
+    pixel = dabPixel(ipx, ipy + 1);
+    bbl = quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, bbl + cs->opacityU8(pixel), OPACITY_OPAQUE_U8));
+    memcpy(pixel, color, m_pixelSize);
+    cs->setOpacity(pixel, bbl, 1);
+
+    pixel = dabPixel(ipx + 1, ipy + 1);
+    bbr = quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, bbr + cs->opacityU8(pixel), OPACITY_OPAQUE_U8));
+    memcpy(pixel, color, m_pixelSize);
+    cs->setOpacity(pixel, bbr, 1);
 }
 
-void HairyBrush::paintParticle(QPointF pos, const KoColor& color)
+void HairyBrush::paintParticle(QPointF pos, const quint8 *color)
 {
     // opacity top left, right, bottom left, right
-    memcpy(m_color.data(), color.data(), m_pixelSize);
-    quint8 opacity = color.opacityU8();
+    memcpy(m_particleColor.data(), color, m_pixelSize);
+    quint8 opacity = m_particleColor.opacityU8();
 
     int ipx = int (pos.x());
     int ipy = int (pos.y());
@@ -370,31 +530,30 @@ void HairyBrush::paintParticle(QPointF pos, const KoColor& color)
     quint8 bbl = qRound((1.0 - fx) * (fy)  * opacity);
     quint8 bbr = qRound((fx)  * (fy)  * opacity);
 
-    m_color.setOpacity(btl);
-    plotPixel(ipx  , ipy, m_color);
+    m_particleColor.setOpacity(btl);
+    plotPixel(ipx  , ipy, m_particleColor.data());
 
-    m_color.setOpacity(btr);
-    plotPixel(ipx + 1  , ipy, m_color);
+    m_particleColor.setOpacity(btr);
+    plotPixel(ipx + 1  , ipy, m_particleColor.data());
 
-    m_color.setOpacity(bbl);
-    plotPixel(ipx  , ipy + 1, m_color);
+    m_particleColor.setOpacity(bbl);
+    plotPixel(ipx  , ipy + 1, m_particleColor.data());
 
-    m_color.setOpacity(bbr);
-    plotPixel(ipx + 1 , ipy + 1, m_color);
+    m_particleColor.setOpacity(bbr);
+    plotPixel(ipx + 1 , ipy + 1, m_particleColor.data());
 }
 
 
-inline void HairyBrush::plotPixel(int wx, int wy, const KoColor &color)
+inline void HairyBrush::plotPixel(int wx, int wy, const quint8 *color)
 {
-    m_dabAccessor->moveTo(wx, wy);
-    m_compositeOp->composite(m_dabAccessor->rawData(), m_pixelSize, color.data() , m_pixelSize, 0, 0, 1, 1, OPACITY_OPAQUE_U8);
+    m_compositeOp->composite(dabPixel(wx, wy), m_pixelSize, color, m_pixelSize, 0, 0, 1, 1, OPACITY_OPAQUE_U8);
 }
 
-inline void HairyBrush::darkenPixel(int wx, int wy, const KoColor &color)
+inline void HairyBrush::darkenPixel(int wx, int wy, const quint8 *color)
 {
-    m_dabAccessor->moveTo(wx, wy);
-    if (m_dab->colorSpace()->opacityU8(m_dabAccessor->rawData()) < color.opacityU8()) {
-        memcpy(m_dabAccessor->rawData(), color.data(), m_pixelSize);
+    quint8 *pixel = dabPixel(wx, wy);
+    if (m_dab->colorSpace()->opacityU8(pixel) < m_dab->colorSpace()->opacityU8(color)) {
+        memcpy(pixel, color, m_pixelSize);
     }
 }
 
@@ -420,15 +579,13 @@ void HairyBrush::colorifyBristles(KisPaintDeviceSP source, QPointF point)
     KoColor bristleColor(m_dab->colorSpace());
     KisCrossDeviceColorSamplerInt colorSampler(source, bristleColor);
 
-    Bristle *b = 0;
     int size = m_bristles.size();
     for (int i = 0; i < size; i++) {
-        b = m_bristles[i];
-        int x = qRound(b->x() + point.x());
-        int y = qRound(b->y() + point.y());
+        int x = qRound(m_bristles.x(i) + point.x());
+        int y = qRound(m_bristles.y(i) + point.y());
 
         colorSampler.sampleOldColor(x, y, bristleColor.data());
-        b->setColor(bristleColor);
+        m_bristles.setColor(i, bristleColor);
     }
 
 }
@@ -74,16 +74,23 @@ public:
     void fromDabWithDensity(KisFixedPaintDeviceSP dab, qreal density);
 
 private:
-    /// paints single bristle
-    void addBristleInk(Bristle *bristle,const QPointF &pos, const KoColor &color);
+    struct SimulationChunk;
+
+    /// moves the bristles of the range [chunk.begin, chunk.end) and generates their ink dabs
+    void simulateBristles(SimulationChunk &chunk, const KisPaintInformation &pi1, const KisPaintInformation &pi2,
+                          qreal scale, qreal angle, qreal pressure, KoColorTransformation *transfo);
+    /// paints single ink dab of a bristle
+    void addBristleInk(const QPointF &pos, const quint8 *color);
+    /// returns the pointer to the pixel of the dab, either in the local buffer or in the device
+    quint8 *dabPixel(int wx, int wy);
     /// composite single pixel to dab
-    void plotPixel(int wx, int wy, const KoColor &color);
+    void plotPixel(int wx, int wy, const quint8 *color);
     /// check the opacity of dab pixel and if the opacity is less then color, it will copy color to dab
-    void darkenPixel(int wx, int wy, const KoColor &color);
+    void darkenPixel(int wx, int wy, const quint8 *color);
     /// paint wu particle by copying the color and setup just the opacity, weight is complementary to opacity of the color
-    void paintParticle(QPointF pos, const KoColor& color, qreal weight);
+    void paintParticle(QPointF pos, const quint8 *color, qreal weight);
     /// paint wu particle using composite operation
-    void paintParticle(QPointF pos, const KoColor& color);
+    void paintParticle(QPointF pos, const quint8 *color);
     /// similar to sample input color in spray
     void colorifyBristles(KisPaintDeviceSP source, QPointF point);
 
@@ -92,26 +99,30 @@ private:
     double computeMousePressure(double distance);
 
     /// simulate running out of saturation
-    void saturationDepletion(Bristle * bristle, KoColor &bristleColor, qreal pressure, qreal inkDeplation);
+    void saturationDepletion(int bristle, KoColor &bristleColor, qreal pressure, qreal inkDeplation, KoColorTransformation *transfo);
     /// simulate running out of ink through opacity decreasing
-    void opacityDepletion(Bristle * bristle, KoColor &bristleColor, qreal pressure, qreal inkDeplation);
+    void opacityDepletion(int bristle, KoColor &bristleColor, qreal pressure, qreal inkDeplation);
     /// fetch actual ink status according depletion curve
-    qreal fetchInkDepletion(Bristle * bristle, int inkDepletionSize);
+    qreal fetchInkDepletion(int bristle, int inkDepletionSize);
 
     void initAndCache();
 
 private:
     const KisHairyProperties * m_properties {nullptr};
 
-    QVector<Bristle*> m_bristles;
-    QTransform m_transform;
+    Bristles m_bristles;
+    QVector<qreal> m_randomOffsets;
 
-    // used for interpolation the path of bristles
-    Trajectory m_trajectory;
     QHash<QString, QVariant> m_params;
     // temporary device
     KisPaintDeviceSP m_dab;
     KisRandomAccessorSP m_dabAccessor;
+
+    // the area of the dab the ink is deposited into, when m_useDabBuffer is true
+    bool m_useDabBuffer {false};
+    QRect m_dabBufferRect;
+    QVector<quint8> m_dabBuffer;
+    KoColor m_particleColor;
     const KoCompositeOp * m_compositeOp {nullptr};
     quint32 m_pixelSize {0};
 
@@ -122,7 +133,8 @@ private:
     KoColor m_color;
 
     int m_saturationId {-1};
-    KoColorTransformation * m_transfo {nullptr};
+    // one transformation per simulation chunk, the transformations are not thread-safe
+    QVector<KoColorTransformation*> m_transfos;
 
     // internal counter counts the calls of paint, the counter is 1 when the first call occurs
     inline bool firstStroke() const {
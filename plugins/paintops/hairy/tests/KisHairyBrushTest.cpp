@@ -0,0 +1,479 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisHairyBrushTest.h"
+
+#include <QTransform>
+#include <QtMath>
+
+#include <cmath>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorTransformation.h>
+#include <KoCompositeOpRegistry.h>
+
+#include <kis_paint_device.h>
+#include <kis_fixed_paint_device.h>
+#include <kis_random_accessor_ng.h>
+#include <brushengine/kis_paint_information.h>
+#include <brushengine/kis_random_source.h>
+
+#include "../hairy_brush.h"
+#include "../trajectory.h"
+
+
+namespace {
+
+/**
+ * The simulation of the hairy brush as it was before the bristles
+ * were stored as a structure of arrays and simulated in chunks: every
+ * bristle is a separate object and the ink is deposited right into the
+ * dab through a random accessor. HairyBrush should produce exactly the
+ * same dab as this implementation.
+ */
+class ReferenceHairyBrush
+{
+    struct Bristle {
+        Bristle(float x, float y, float length, const KoColor &color)
+            : x(x), y(y), prevX(x), prevY(y), length(length), color(color)
+        {
+        }
+
+        void setInkAmount(float value) {
+            inkAmount = qBound(-1.0f, value, 1.0f);
+        }
+
+        float x;
+        float y;
+        float prevX;
+        float prevY;
+        float length;
+        KoColor color;
+        float inkAmount {0.0f};
+        int counter {0};
+    };
+
+public:
+    ~ReferenceHairyBrush() {
+        delete m_transfo;
+    }
+
+    void setProperties(KisHairyProperties *properties) {
+        m_properties = properties;
+    }
+
+    void fromDab(KisFixedPaintDeviceSP dab) {
+        const int width = dab->bounds().width();
+        const int height = dab->bounds().height();
+
+        const int centerX = width * 0.5;
+        const int centerY = height * 0.5;
+
+        const quint8 *dabPointer = dab->data();
+        const int pixelSize = dab->pixelSize();
+        const KoColorSpace *cs = dab->colorSpace();
+        KoColor bristleColor(cs);
+
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                const qreal alpha = cs->opacityF(dabPointer);
+                if (alpha != 0.0) {
+                    memcpy(bristleColor.data(), dabPointer, pixelSize);
+                    m_bristles.append(Bristle(x - centerX, y - centerY, alpha, bristleColor));
+                }
+                dabPointer += pixelSize;
+            }
+        }
+    }
+
+    void paintLine(KisPaintDeviceSP dab, const KisPaintInformation &pi1, const KisPaintInformation &pi2, qreal scale, qreal rotation) {
+        m_counter++;
+
+        const qreal x1 = pi1.pos().x();
+        const qreal y1 = pi1.pos().y();
+        const qreal x2 = pi2.pos().x();
+        const qreal y2 = pi2.pos().y();
+
+        const qreal angle = rotation;
+        const qreal pressure = pi2.pressure() * 2;
+
+        KoColor bristleColor(dab->colorSpace());
+
+        m_dab = dab;
+        m_dabAccessor = dab->createRandomAccessorNG();
+
+        if (m_counter == 1) {
+            m_compositeOp = m_dab->colorSpace()->compositeOp(COMPOSITE_OVER);
+            m_pixelSize = m_dab->colorSpace()->pixelSize();
+            m_color = KoColor(m_dab->colorSpace());
+
+            if (m_properties->useSaturation) {
+                m_transfo = m_dab->colorSpace()->createColorTransformation("hsv_adjustment", QHash<QString, QVariant>());
+                if (m_transfo) {
+                    m_saturationId = m_transfo->parameterId("s");
+                }
+            }
+        }
+
+        KisRandomSourceSP randomSource = pi2.randomSource();
+
+        qreal fx1, fy1, fx2, fy2;
+        float inkDeplation = 0.0;
+        const int inkDepletionSize = m_properties->inkDepletionCurve.size();
+        const qreal threshold = 1.0 - pi2.pressure();
+
+        for (int b = 0; b < m_bristles.size(); b++) {
+            Bristle &bristle = m_bristles[b];
+
+            const qreal randomX = (randomSource->generateNormalized() * 2 - 1.0) * m_properties->randomFactor;
+            const qreal randomY = (randomSource->generateNormalized() * 2 - 1.0) * m_properties->randomFactor;
+            const qreal shear = pressure * m_properties->shearFactor;
+
+            QTransform transform;
+            transform.rotateRadians(-angle);
+            transform.scale(scale, scale);
+            transform.translate(randomX, randomY);
+            transform.shear(shear, shear);
+
+            if (m_counter == 1 || !m_properties->connectedPath) {
+                transform.map(bristle.x, bristle.y, &fx1, &fy1);
+                transform.map(bristle.x, bristle.y, &fx2, &fy2);
+            } else {
+                fx1 = bristle.prevX;
+                fy1 = bristle.prevY;
+                transform.map(bristle.x, bristle.y, &fx2, &fy2);
+            }
+            bristle.prevX = fx2;
+            bristle.prevY = fy2;
+
+            fx1 += x1;
+            fy1 += y1;
+            fx2 += x2;
+            fy2 += y2;
+
+            if (m_properties->threshold && (bristle.length < threshold)) continue;
+
+            const QVector<QPointF> bristlePath = m_trajectory.getLinearTrajectory(QPointF(fx1, fy1), QPointF(fx2, fy2), 1.0);
+            int bristlePathSize = m_trajectory.size();
+
+            if (m_properties->antialias) {
+                bristlePathSize -= 1;
+            }
+
+            memcpy(bristleColor.data(), bristle.color.data(), m_pixelSize);
+            for (int i = 0; i < bristlePathSize; i++) {
+                if (m_properties->inkDepletionEnabled) {
+                    inkDeplation = bristle.counter >= inkDepletionSize - 1 ?
+                        m_properties->inkDepletionCurve[inkDepletionSize - 1] :
+                        m_properties->inkDepletionCurve[bristle.counter];
+
+                    if (m_properties->useSaturation && m_transfo) {
+                        saturationDepletion(bristle, bristleColor, pressure, inkDeplation);
+                    }
+
+                    if (m_properties->useOpacity) {
+                        opacityDepletion(bristle, bristleColor, pressure, inkDeplation);
+                    }
+                } else {
+                    if (bristleColor.opacityU8() != 0) {
+                        bristleColor.setOpacity(bristle.length);
+                    }
+                }
+
+                addBristleInk(bristlePath.at(i), bristleColor);
+                bristle.setInkAmount(1.0 - inkDeplation);
+                bristle.counter++;
+            }
+        }
+
+        m_dab = nullptr;
+        m_dabAccessor = nullptr;
+    }
+
+private:
+    void saturationDepletion(const Bristle &bristle, KoColor &bristleColor, qreal pressure, qreal inkDeplation) {
+        qreal saturation;
+        if (m_properties->useWeights) {
+            saturation = ((pressure * m_properties->pressureWeight) +
+                          (bristle.length * m_properties->bristleLengthWeight) +
+                          (bristle.inkAmount * m_properties->bristleInkAmountWeight) +
+                          ((1.0 - inkDeplation) * m_properties->inkDepletionWeight)) - 1.0;
+        } else {
+            saturation = (pressure * bristle.length * bristle.inkAmount * (1.0 - inkDeplation)) - 1.0;
+        }
+        m_transfo->setParameter(m_transfo->parameterId("h"), 0.0);
+        m_transfo->setParameter(m_transfo->parameterId("v"), 0.0);
+        m_transfo->setParameter(m_saturationId, saturation);
+        m_transfo->setParameter(3, 1);
+        m_transfo->setParameter(4, false);
+        m_transfo->transform(bristleColor.data(), bristleColor.data(), 1);
+    }
+
+    void opacityDepletion(const Bristle &bristle, KoColor &bristleColor, qreal pressure, qreal inkDeplation) {
+        qreal opacity;
+        if (m_properties->useWeights) {
+            opacity = pressure * m_properties->pressureWeight +
+                      bristle.length * m_properties->bristleLengthWeight +
+                      bristle.inkAmount * m_properties->bristleInkAmountWeight +
+                      (1.0 - inkDeplation) * m_properties->inkDepletionWeight;
+        } else {
+            opacity = bristle.length * bristle.inkAmount;
+        }
+        bristleColor.setOpacity(qBound(0.0, opacity, 1.0));
+    }
+
+    void addBristleInk(const QPointF &pos, const KoColor &color) {
+        if (m_properties->antialias) {
+            if (m_properties->useCompositing) {
+                paintParticle(pos, color);
+            } else {
+                paintParticle(pos, color, 1.0);
+            }
+        } else {
+            const int ix = qRound(pos.x());
+            const int iy = qRound(pos.y());
+            if (m_properties->useCompositing) {
+                plotPixel(ix, iy, color);
+            } else {
+                darkenPixel(ix, iy, color);
+            }
+        }
+    }
+
+    void paintParticle(const QPointF &pos, const KoColor &color, qreal weight) {
+        quint8 opacity = color.opacityU8();
+        opacity *= weight;
+
+        const int ipx = int(pos.x());
+        const int ipy = int(pos.y());
+        const qreal fx = qAbs(pos.x() - ipx);
+        const qreal fy = qAbs(pos.y() - ipy);
+
+        const quint8 weights[4] = {
+            quint8(qRound((1.0 - fx) * (1.0 - fy) * opacity)),
+            quint8(qRound(fx * (1.0 - fy) * opacity)),
+            quint8(qRound((1.0 - fx) * fy * opacity)),
+            quint8(qRound(fx * fy * opacity))
+        };
+        const QPoint offsets[4] = {QPoint(0, 0), QPoint(1, 0), QPoint(0, 1), QPoint(1, 1)};
+
+        const KoColorSpace *cs = m_dab->colorSpace();
+
+        for (int i = 0; i < 4; i++) {
+            m_dabAccessor->moveTo(ipx + offsets[i].x(), ipy + offsets[i].y());
+            const quint8 value = quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, weights[i] + cs->opacityU8(m_dabAccessor->rawData()), OPACITY_OPAQUE_U8));
+            memcpy(m_dabAccessor->rawData(), color.data(), m_pixelSize);
+            cs->setOpacity(m_dabAccessor->rawData(), value, 1);
+        }
+    }
+
+    void paintParticle(const QPointF &pos, const KoColor &color) {
+        memcpy(m_color.data(), color.data(), m_pixelSize);
+        const quint8 opacity = color.opacityU8();
+
+        const int ipx = int(pos.x());
+        const int ipy = int(pos.y());
+        const qreal fx = qAbs(pos.x() - ipx);
+        const qreal fy = qAbs(pos.y() - ipy);
+
+        m_color.setOpacity(quint8(qRound((1.0 - fx) * (1.0 - fy) * opacity)));
+        plotPixel(ipx, ipy, m_color);
+
+        m_color.setOpacity(quint8(qRound(fx * (1.0 - fy) * opacity)));
+        plotPixel(ipx + 1, ipy, m_color);
+
+        m_color.setOpacity(quint8(qRound((1.0 - fx) * fy * opacity)));
+        plotPixel(ipx, ipy + 1, m_color);
+
+        m_color.setOpacity(quint8(qRound(fx * fy * opacity)));
+        plotPixel(ipx + 1, ipy + 1, m_color);
+    }
+
+    void plotPixel(int wx, int wy, const KoColor &color) {
+        m_dabAccessor->moveTo(wx, wy);
+        m_compositeOp->composite(m_dabAccessor->rawData(), m_pixelSize, color.data(), m_pixelSize, 0, 0, 1, 1, OPACITY_OPAQUE_U8);
+    }
+
+    void darkenPixel(int wx, int wy, const KoColor &color) {
+        m_dabAccessor->moveTo(wx, wy);
+        if (m_dab->colorSpace()->opacityU8(m_dabAccessor->rawData()) < color.opacityU8()) {
+            memcpy(m_dabAccessor->rawData(), color.data(), m_pixelSize);
+        }
+    }
+
+private:
+    const KisHairyProperties *m_properties {nullptr};
+    QVector<Bristle> m_bristles;
+    Trajectory m_trajectory;
+
+    KisPaintDeviceSP m_dab;
+    KisRandomAccessorSP m_dabAccessor;
+    const KoCompositeOp *m_compositeOp {nullptr};
+    quint32 m_pixelSize {0};
+    KoColor m_color;
+
+    int m_counter {0};
+    int m_saturationId {-1};
+    KoColorTransformation *m_transfo {nullptr};
+};
+
+KisFixedPaintDeviceSP createBristlesDab(const KoColorSpace *cs)
+{
+    const int size = 48;
+    const qreal radius = 0.5 * size - 1;
+
+    KisFixedPaintDeviceSP dab = new KisFixedPaintDevice(cs);
+    dab->setRect(QRect(0, 0, size, size));
+    dab->lazyGrowBufferWithoutInitialization();
+
+    quint8 *dabPointer = dab->data();
+
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            const qreal distance = std::hypot(x + 0.5 - 0.5 * size, y + 0.5 - 0.5 * size);
+            const int alpha = distance < radius ? qRound(255 * (1.0 - 0.7 * distance / radius)) : 0;
+
+            const KoColor color(QColor(x * 255 / size, y * 255 / size, 128, alpha), cs);
+            memcpy(dabPointer, color.data(), cs->pixelSize());
+            dabPointer += cs->pixelSize();
+        }
+    }
+
+    return dab;
+}
+
+QVector<KisPaintInformation> createStroke(KisRandomSourceSP randomSource)
+{
+    QVector<KisPaintInformation> stroke;
+
+    const int numSamples = 12;
+    for (int i = 0; i < numSamples; i++) {
+        const qreal t = qreal(i) / (numSamples - 1);
+
+        KisPaintInformation pi(QPointF(100.0 + 300.0 * t, 150.0 + 60.0 * qSin(3.0 * t)),
+                               0.3 + 0.6 * qSin(M_PI * t));
+        pi.setRandomSource(randomSource);
+        stroke.append(pi);
+    }
+
+    return stroke;
+}
+
+bool compareDevices(KisPaintDeviceSP dev1, KisPaintDeviceSP dev2, QPoint *mismatch)
+{
+    const QRect rc = dev1->exactBounds();
+    if (rc != dev2->exactBounds()) {
+        *mismatch = QPoint(-1, -1);
+        return false;
+    }
+
+    const int pixelSize = dev1->pixelSize();
+
+    QVector<quint8> bytes1(rc.width() * rc.height() * pixelSize);
+    QVector<quint8> bytes2(rc.width() * rc.height() * pixelSize);
+    dev1->readBytes(bytes1.data(), rc);
+    dev2->readBytes(bytes2.data(), rc);
+
+    for (int i = 0; i < rc.width() * rc.height(); i++) {
+        if (memcmp(bytes1.constData() + i * pixelSize, bytes2.constData() + i * pixelSize, pixelSize) != 0) {
+            *mismatch = rc.topLeft() + QPoint(i % rc.width(), i / rc.width());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
+void KisHairyBrushTest::testSimulationMatchesReference_data()
+{
+    QTest::addColumn<bool>("antialias");
+    QTest::addColumn<bool>("useCompositing");
+    QTest::addColumn<bool>("inkDepletion");
+    QTest::addColumn<bool>("connectedPath");
+
+    QTest::newRow("plain") << false << false << false << false;
+    QTest::newRow("compositing") << false << true << false << false;
+    QTest::newRow("antialias") << true << false << false << true;
+    QTest::newRow("antialias-compositing") << true << true << false << true;
+    QTest::newRow("ink-depletion") << false << true << true << true;
+    QTest::newRow("ink-depletion-antialias") << true << false << true << false;
+}
+
+void KisHairyBrushTest::testSimulationMatchesReference()
+{
+    QFETCH(bool, antialias);
+    QFETCH(bool, useCompositing);
+    QFETCH(bool, inkDepletion);
+    QFETCH(bool, connectedPath);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisHairyProperties properties;
+    properties.radius = 24;
+    properties.inkAmount = 256;
+    properties.sigma = 1.0;
+    properties.inkDepletionEnabled = inkDepletion;
+    properties.isbrushDimension1D = false;
+    properties.useMousePressure = false;
+    properties.useSaturation = inkDepletion;
+    properties.useOpacity = inkDepletion;
+    properties.useWeights = false;
+    properties.useSoakInk = false;
+    properties.connectedPath = connectedPath;
+    properties.antialias = antialias;
+    properties.useCompositing = useCompositing;
+    properties.pressureWeight = 50;
+    properties.bristleLengthWeight = 50;
+    properties.bristleInkAmountWeight = 50;
+    properties.inkDepletionWeight = 50;
+    properties.shearFactor = 0.3;
+    properties.randomFactor = 2.0;
+    properties.scaleFactor = 1.0;
+    properties.threshold = 0.0;
+
+    for (int i = 0; i < 100; i++) {
+        properties.inkDepletionCurve.append(qreal(i) / 99);
+    }
+
+    KisFixedPaintDeviceSP bristlesDab = createBristlesDab(cs);
+
+    HairyBrush brush;
+    brush.setProperties(&properties);
+    brush.setInkColor(KoColor(Qt::black, cs));
+    brush.fromDabWithDensity(bristlesDab, 1.0);
+
+    ReferenceHairyBrush referenceBrush;
+    referenceBrush.setProperties(&properties);
+    referenceBrush.fromDab(bristlesDab);
+
+    KisPaintDeviceSP dab = new KisPaintDevice(cs);
+    KisPaintDeviceSP referenceDab = new KisPaintDevice(cs);
+
+    // both the brushes should consume the same sequence of random values
+    const QVector<KisPaintInformation> stroke = createStroke(new KisRandomSource(42));
+    const QVector<KisPaintInformation> referenceStroke = createStroke(new KisRandomSource(42));
+
+    for (int i = 1; i < stroke.size(); i++) {
+        const qreal rotation = 0.2 * i;
+
+        brush.paintLine(dab, nullptr, stroke[i - 1], stroke[i], 1.0, rotation);
+        referenceBrush.paintLine(referenceDab, referenceStroke[i - 1], referenceStroke[i], 1.0, rotation);
+    }
+
+    QVERIFY(!referenceDab->exactBounds().isEmpty());
+
+    QPoint mismatch;
+    if (!compareDevices(dab, referenceDab, &mismatch)) {
+        QFAIL(QString("The dab differs from the reference implementation at (%1, %2)")
+              .arg(mismatch.x()).arg(mismatch.y()).toLatin1());
+    }
+}
+
+SIMPLE_TEST_MAIN(KisHairyBrushTest)
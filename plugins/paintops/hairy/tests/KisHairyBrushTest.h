@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISHAIRYBRUSHTEST_H
+#define KISHAIRYBRUSHTEST_H
+
+#include <simpletest.h>
+
+class KisHairyBrushTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testSimulationMatchesReference_data();
+    void testSimulationMatchesReference();
+};
+
+#endif // KISHAIRYBRUSHTEST_H
@@ -20,6 +20,8 @@
 
 #include <QGlobalStatic>
 
+#define TILED_MASK_MAX_SIZE (64 * 1024 * 1024)
+
 /**********************************************************************/
 /*       KisTextureMaskInfo                                           */
 /**********************************************************************/
@@ -240,12 +242,68 @@ void KisTextureMaskInfo::recalculateMask()
         m_mask->convertFromQImage(mask, 0);
     }
     m_maskBounds = QRect(0, 0, width, height);
+
+    QMutexLocker l(&m_tiledMaskMutex);
+    m_tiledMask.clear();
 }
 
 bool KisTextureMaskInfo::hasAlpha() {
     return m_pattern->hasAlpha();
 }
 
+KisTextureMaskInfo::TiledMaskSP KisTextureMaskInfo::tiledMask(const QSize &windowSize)
+{
+    if (!isValid() || m_mask->pixelSize() != 1) return TiledMaskSP();
+
+    const int maskWidth = m_maskBounds.width();
+    const int maskHeight = m_maskBounds.height();
+
+    QMutexLocker l(&m_tiledMaskMutex);
+
+    if (m_tiledMask &&
+        m_tiledMask->width >= maskWidth + windowSize.width() &&
+        m_tiledMask->height >= maskHeight + windowSize.height()) {
+
+        return m_tiledMask;
+    }
+
+    /**
+     * Grow the tiled mask in steps of the tile size to avoid
+     * rebuilding it for every slightly bigger dab
+     */
+    auto paddedSize = [] (int maskSize, int windowSize, int currentSize) {
+        const int size = qMax(maskSize + windowSize, currentSize);
+        return maskSize + ((size - maskSize + 63) & ~63);
+    };
+
+    const int width = paddedSize(maskWidth, windowSize.width(), m_tiledMask ? m_tiledMask->width : 0);
+    const int height = paddedSize(maskHeight, windowSize.height(), m_tiledMask ? m_tiledMask->height : 0);
+
+    if (qint64(width) * height > TILED_MASK_MAX_SIZE) {
+        return TiledMaskSP();
+    }
+
+    QVector<quint8> maskBytes(maskWidth * maskHeight);
+    m_mask->readBytes(maskBytes.data(), m_maskBounds);
+
+    TiledMask *tiledMask = new TiledMask();
+    tiledMask->width = width;
+    tiledMask->height = height;
+    tiledMask->data.resize(width * height);
+
+    for (int y = 0; y < height; y++) {
+        const quint8 *srcRow = maskBytes.constData() + (y % maskHeight) * maskWidth;
+        quint8 *dstPtr = tiledMask->data.data() + y * width;
+
+        for (int x = 0; x < width; x += maskWidth) {
+            memcpy(dstPtr + x, srcRow, qMin(maskWidth, width - x));
+        }
+    }
+
+    m_tiledMask = TiledMaskSP(tiledMask);
+    return m_tiledMask;
+}
+
 /**********************************************************************/
 /*       KisTextureMaskInfoCache                                      */
 /**********************************************************************/
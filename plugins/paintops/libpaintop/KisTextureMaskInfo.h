@@ -11,6 +11,7 @@
 #include <kis_paint_device.h>
 #include <QSharedPointer>
 #include <QMutex>
+#include <QVector>
 
 
 #include <boost/operators.hpp>
@@ -48,6 +49,35 @@ public:
 
     bool hasAlpha();
 
+    /**
+     * A linear copy of the 8-bit mask repeated periodically in both
+     * directions. A window of any size up to the requested one, starting
+     * at any point inside maskBounds(), is a contiguous block of
+     * memory, so the dab can be masked with a single pass over it,
+     * without any wrap-around math.
+     */
+    struct TiledMask {
+        QVector<quint8> data;
+        int width = 0;
+        int height = 0;
+
+        const quint8* window(int x, int y) const {
+            return data.constData() + y * width + x;
+        }
+    };
+
+    using TiledMaskSP = QSharedPointer<const TiledMask>;
+
+    /**
+     * Returns the tiled mask fitting the windows of \p windowSize.
+     * The tiled mask is created on the first request and regrown when
+     * a bigger window is requested. Returns null if the mask is not an
+     * alpha mask or the tiled mask would be too big.
+     *
+     * The function is thread-safe.
+     */
+    TiledMaskSP tiledMask(const QSize &windowSize);
+
 private:
     int m_levelOfDetail = 0;
     bool m_preserveAlpha = false;
@@ -67,6 +97,9 @@ private:
     KisPaintDeviceSP m_mask;
     QRect m_maskBounds;
 
+    QMutex m_tiledMaskMutex;
+    TiledMaskSP m_tiledMask;
+
 };
 
 typedef QSharedPointer<KisTextureMaskInfo> KisTextureMaskInfoSP;
@@ -257,21 +257,14 @@ void KisTextureOption::apply(KisFixedPaintDeviceSP dab, const QPoint &offset, co
     }
 
     QRect rect = dab->bounds();
-    KisPaintDeviceSP mask = m_maskInfo->mask();
     const QRect maskBounds = m_maskInfo->maskBounds();
 
-    KisCachedPaintDevice::Guard g(mask, KoColorSpaceRegistry::instance()->alpha8(), m_cachedPaintDevice);
-    KisPaintDeviceSP maskPatch = g.device();
-
     int x = offset.x() % maskBounds.width() - m_offsetX;
     int y = offset.y() % maskBounds.height() - m_offsetY;
 
     const QRect maskPatchRect = QRect(x, y, rect.width(), rect.height());
 
-    KisFillPainter fillPainter(maskPatch);
-    fillPainter.setCompositeOpId(COMPOSITE_COPY);
-    fillPainter.fillRect(kisGrowRect(maskPatchRect, 1), mask, maskBounds);
-    fillPainter.end();
+    KisTextureMaskInfo::TiledMaskSP tiledMask = m_maskInfo->tiledMask(rect.size());
 
     // Compute final strength
     qreal strength = m_strengthOption.apply(info);
@@ -342,6 +335,37 @@ void KisTextureOption::apply(KisFixedPaintDeviceSP dab, const QPoint &offset, co
     default: return;
     }
 
+    const qint32 dabRowStride = dab->bounds().width() * dab->pixelSize();
+
+    if (tiledMask) {
+        /**
+         * The tiled mask contains the whole window of the dab
+         * as a contiguous block, so apply it in one pass
+         */
+        auto toPatternLocal = [] (int value, int size) {
+            return value >= 0 ? value % size : size - (-value - 1) % size - 1;
+        };
+
+        const quint8 *maskPtr =
+            tiledMask->window(toPatternLocal(maskPatchRect.x(), maskBounds.width()),
+                              toPatternLocal(maskPatchRect.y(), maskBounds.height()));
+
+        compositeOp->composite(maskPtr, tiledMask->width,
+                               dab->data(), dabRowStride,
+                               rect.width(), rect.height());
+        return;
+    }
+
+    KisPaintDeviceSP mask = m_maskInfo->mask();
+
+    KisCachedPaintDevice::Guard g(mask, KoColorSpaceRegistry::instance()->alpha8(), m_cachedPaintDevice);
+    KisPaintDeviceSP maskPatch = g.device();
+
+    KisFillPainter fillPainter(maskPatch);
+    fillPainter.setCompositeOpId(COMPOSITE_COPY);
+    fillPainter.fillRect(kisGrowRect(maskPatchRect, 1), mask, maskBounds);
+    fillPainter.end();
+
     // Apply the mask to the dab
     {
         quint8 *dabIt = nullptr;
@@ -350,7 +374,6 @@ void KisTextureOption::apply(KisFixedPaintDeviceSP dab, const QPoint &offset, co
         qint32 dabY = dab->bounds().y();
         qint32 maskPatchY = maskPatchRect.y();
         qint32 rowsRemaining = dab->bounds().height();
-        const qint32 dabRowStride = dab->bounds().width() * dab->pixelSize();
 
         while (rowsRemaining > 0) {
             qint32 dabX = dab->bounds().x();
@@ -19,6 +19,9 @@
 #include <qmath.h>
 #include <KoCompositeOpRegistry.h>
 #include <KoMixColorsOp.h>
+#include <KisRegion.h>
+#include <krita_utils.h>
+#include <QtConcurrent>
 
 using namespace std;
 
@@ -51,6 +54,8 @@ KisMyPaintSurface::KisMyPaintSurface(KisPainter *painter, KisPaintDeviceSP paint
 
     m_surface->draw_dab = this->draw_dab;
     m_surface->get_color = this->get_color;
+    m_surface->begin_atomic = this->begin_atomic;
+    m_surface->end_atomic = this->end_atomic;
     m_surface->destroy = destroy_internal_surface_callback;
     m_surface->bitDepth = m_precisePainterWrapper.overlayColorSpace()->channels()[0]->channelValueType();
 
@@ -61,6 +66,8 @@ KisMyPaintSurface::KisMyPaintSurface(KisPainter *painter, KisPaintDeviceSP paint
 
 KisMyPaintSurface::~KisMyPaintSurface()
 {
+    flushDirtyRects();
+
     mypaint_surface_unref(m_surface);
 }
 
@@ -115,6 +122,83 @@ void KisMyPaintSurface::get_color(MyPaintSurface *self, float x, float y, float
 }
 
 
+void KisMyPaintSurface::begin_atomic(MyPaintSurface *self)
+{
+    MyPaintSurfaceInternal *surface = static_cast<MyPaintSurfaceInternal*>(self);
+    surface->m_owner->m_atomicLevel++;
+}
+
+void KisMyPaintSurface::end_atomic(MyPaintSurface *self, MyPaintRectangle *roi)
+{
+    MyPaintSurfaceInternal *surface = static_cast<MyPaintSurfaceInternal*>(self);
+    KisMyPaintSurface *owner = surface->m_owner;
+
+    KIS_SAFE_ASSERT_RECOVER_NOOP(owner->m_atomicLevel > 0);
+    owner->m_atomicLevel = qMax(0, owner->m_atomicLevel - 1);
+
+    QRect changedRect;
+
+    if (!owner->m_atomicLevel) {
+        changedRect = owner->flushDirtyRects();
+    }
+
+    if (roi) {
+        roi->x = changedRect.x();
+        roi->y = changedRect.y();
+        roi->width = changedRect.width();
+        roi->height = changedRect.height();
+    }
+}
+
+void KisMyPaintSurface::addDirtyRects(const QVector<QRect> &rects)
+{
+    if (m_atomicLevel > 0) {
+        m_pendingDirtyRects += rects;
+    } else {
+        m_precisePainterWrapper.writeRects(rects);
+        painter()->addDirtyRects(rects);
+    }
+}
+
+QRect KisMyPaintSurface::flushDirtyRects()
+{
+    if (m_pendingDirtyRects.isEmpty()) return QRect();
+
+    /**
+     * The dirty rects of the dabs overlap, so first make them unique.
+     * The approximated rects are aligned to the grid of the overlay,
+     * so they are guaranteed to be read into the overlay and stay
+     * unchanged outside the dirty area.
+     */
+    QVector<QRect> rectsToWrite = m_pendingDirtyRects;
+    KisRegion::approximateOverlappingRects(rectsToWrite, 64);
+
+    QVector<QRect> patches;
+    Q_FOREACH (const QRect &rc, rectsToWrite) {
+        patches += KritaUtils::splitRectIntoPatches(rc, QSize(128, 128));
+    }
+
+    if (patches.size() > 1) {
+        auto writePatch = [this] (const QRect &rc) {
+            m_precisePainterWrapper.writeRect(rc);
+        };
+        QtConcurrent::blockingMap(patches, writePatch);
+    } else {
+        m_precisePainterWrapper.writeRects(patches);
+    }
+
+    painter()->addDirtyRects(m_pendingDirtyRects);
+
+    QRect changedRect;
+    Q_FOREACH (const QRect &rc, m_pendingDirtyRects) {
+        changedRect |= rc;
+    }
+
+    m_pendingDirtyRects.clear();
+
+    return changedRect;
+}
+
 /*GIMP's draw_dab and get_color code*/
 template <typename channelType>
 int KisMyPaintSurface::drawDabImpl(MyPaintSurface *self, float x, float y, float radius, float color_r, float color_g,
@@ -269,9 +353,7 @@ int KisMyPaintSurface::drawDabImpl(MyPaintSurface *self, float x, float y, float
 
     m_tempPainter->bitBltWithFixedSelection(dabRectAligned.x(), dabRectAligned.y(), m_dab, m_maskDevice, dabRectAligned.x(), dabRectAligned.y(), dabRectAligned.x(), dabRectAligned.y(), dabRectAligned.width(), dabRectAligned.height());
     m_tempPainter->renderMirrorMask(dabRectAligned, m_dab, dabRectAligned.x(), dabRectAligned.y(), m_maskDevice);
-    const QVector<QRect> dirtyRects = m_tempPainter->takeDirtyRegion();
-    m_precisePainterWrapper.writeRects(dirtyRects);
-    painter()->addDirtyRects(dirtyRects);
+    addDirtyRects(m_tempPainter->takeDirtyRegion());
     return 1;
 }
 
@@ -298,9 +380,9 @@ void KisMyPaintSurface::getColorImpl(MyPaintSurface *self, float x, float y, flo
     const float one_over_radius2 = 1.0f / (radius * radius);
     quint32 sum_weight = 0.0f;
 
-    m_precisePainterWrapper.readRect(dabRectAligned);
     KisPaintDeviceSP activeDev = m_precisePainterWrapper.overlay();
     if(m_image) {
+        m_precisePainterWrapper.readRect(dabRectAligned);
         //m_image->blockUpdates();
         m_backgroundPainter->device()->clear();
         m_backgroundPainter->bitBlt(dabRectAligned.topLeft(), activeDev, dabRectAligned);
@@ -323,7 +405,8 @@ void KisMyPaintSurface::getColorImpl(MyPaintSurface *self, float x, float y, flo
     m_blendDevice->lazyGrowBufferWithoutInitialization();
 
 
-    qint16* weights = new qint16[size];
+    m_colorWeights.resize(size);
+    qint16* weights = m_colorWeights.data();
     quint32 num_colors = 0;
 
     activeDev->readBytes(m_blendDevice->data(), dabRectAligned);
@@ -369,8 +452,6 @@ void KisMyPaintSurface::getColorImpl(MyPaintSurface *self, float x, float y, flo
             *color_a = CLAMP(a, 0.0f, 1.0f);
         }
     }
-
-    delete [] weights;
 }
 
 KisPainter* KisMyPaintSurface::painter() {
@@ -48,6 +48,16 @@ public:
     static void get_color(MyPaintSurface *self, float x, float y, float radius,
                             float * color_r, float * color_g, float * color_b, float * color_a);
 
+    /**
+      * The dabs painted between begin_atomic() and end_atomic() are kept
+      * in the precise overlay only. The overlay is written back into the
+      * painter's device (and the dirty rects are reported) once, in
+      * end_atomic(). Consecutive dabs overlap a lot, so it saves converting
+      * the same pixels back on every dab.
+      */
+    static void begin_atomic(MyPaintSurface *self);
+    static void end_atomic(MyPaintSurface *self, MyPaintRectangle *roi);
+
     template <typename channelType>
     int drawDabImpl(MyPaintSurface *self, float x, float y, float radius, float color_r, float color_g,
                                     float color_b, float opaque, float hardness, float color_a,
@@ -76,6 +86,10 @@ public:
 
     MyPaintSurface* surface();
 
+private:
+    void addDirtyRects(const QVector<QRect> &rects);
+    QRect flushDirtyRects();
+
 private:
     KisPainter *m_painter;
     KisPaintDeviceSP m_imageDevice;
@@ -87,6 +101,10 @@ private:
     QScopedPointer<KisPainter> m_backgroundPainter;
     KisFixedPaintDeviceSP m_blendDevice;
     KisFixedPaintDeviceSP m_maskDevice;
+    QVector<qint16> m_colorWeights;
+
+    int m_atomicLevel {0};
+    QVector<QRect> m_pendingDirtyRects;
 
 };
 
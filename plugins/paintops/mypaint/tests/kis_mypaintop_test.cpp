@@ -53,6 +53,45 @@ void KisMyPaintOpTest::testDab() {
 
 }
 
+void KisMyPaintOpTest::testAtomicDabs() {
+
+    const QVector<QPointF> centers = {{250, 250}, {270, 255}, {290, 262}, {310, 270}};
+
+    KisPaintDeviceSP reference = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    KisPaintDeviceSP dst = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+
+    {
+        KisPainter painter(reference);
+        QScopedPointer<KisMyPaintSurface> surface(new KisMyPaintSurface(&painter, reference));
+
+        Q_FOREACH (const QPointF &pt, centers) {
+            surface->draw_dab(surface->surface(), pt.x(), pt.y(), 40, 0, 0, 1, 0.5, 0.8, 1, 1, 90, 0, 0);
+        }
+    }
+
+    KisPainter painter(dst);
+    QScopedPointer<KisMyPaintSurface> surface(new KisMyPaintSurface(&painter, dst));
+
+    mypaint_surface_begin_atomic(surface->surface());
+
+    Q_FOREACH (const QPointF &pt, centers) {
+        surface->draw_dab(surface->surface(), pt.x(), pt.y(), 40, 0, 0, 1, 0.5, 0.8, 1, 1, 90, 0, 0);
+    }
+
+    // the device is updated only when the atomic section is finished
+    QVERIFY(dst->exactBounds().isEmpty());
+
+    MyPaintRectangle roi;
+    mypaint_surface_end_atomic(surface->surface(), &roi);
+
+    QCOMPARE(QRect(roi.x, roi.y, roi.width, roi.height) & reference->exactBounds(), reference->exactBounds());
+
+    QPoint errpoint;
+    if (!TestUtil::comparePaintDevices(errpoint, reference, dst)) {
+        QFAIL(QString("Atomic dabs differ from the sequential ones, first different pixel: %1,%2 \n").arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
 void KisMyPaintOpTest::testGetColor() {
 
     KisPaintDeviceSP dst = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
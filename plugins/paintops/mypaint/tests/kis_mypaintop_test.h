@@ -22,6 +22,7 @@ public:
 
 private Q_SLOTS:
     void testDab();
+    void testAtomicDabs();
     void testGetColor();
     void testLoading();
 };
@@ -0,0 +1,123 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisSprayParticleBatch.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QRect>
+
+#include <kis_assert.h>
+
+#include <kis_algebra_2d.h>
+#include <kis_paint_device.h>
+#include <kis_random_accessor_ng.h>
+
+namespace {
+const int batchTileSize = 64;
+
+/**
+ * Reading and writing back the whole tile costs about the same
+ * as this number of random accessor writes
+ */
+const int minParticlesForTileBuffer = 64;
+}
+
+KisSprayParticleBatch::KisSprayParticleBatch()
+{
+}
+
+void KisSprayParticleBatch::reset(int pixelSize)
+{
+    m_pixelSize = pixelSize;
+    m_particles.clear();
+    m_pixels.clear();
+}
+
+void KisSprayParticleBatch::addPixel(int x, int y, const quint8 *pixel)
+{
+    Particle particle;
+    particle.x = x;
+    particle.y = y;
+    particle.tileCol = KisAlgebra2D::divideFloor(x, batchTileSize);
+    particle.tileRow = KisAlgebra2D::divideFloor(y, batchTileSize);
+    particle.seqNo = m_particles.size();
+    m_particles.append(particle);
+
+    const int offset = m_pixels.size();
+    m_pixels.resize(offset + m_pixelSize);
+    memcpy(m_pixels.data() + offset, pixel, m_pixelSize);
+}
+
+bool KisSprayParticleBatch::isEmpty() const
+{
+    return m_particles.isEmpty();
+}
+
+void KisSprayParticleBatch::flush(KisPaintDeviceSP dev)
+{
+    if (m_particles.isEmpty()) return;
+
+    KIS_SAFE_ASSERT_RECOVER(dev->pixelSize() == quint32(m_pixelSize)) {
+        reset(dev->pixelSize());
+        return;
+    }
+
+    std::sort(m_particles.begin(), m_particles.end(),
+              [] (const Particle &lhs, const Particle &rhs) {
+                  return lhs.tileRow < rhs.tileRow ||
+                      (lhs.tileRow == rhs.tileRow &&
+                       (lhs.tileCol < rhs.tileCol ||
+                        (lhs.tileCol == rhs.tileCol && lhs.seqNo < rhs.seqNo)));
+              });
+
+    KisRandomAccessorSP accessor;
+    const quint8 *pixels = m_pixels.constData();
+
+    auto groupBegin = m_particles.constBegin();
+    while (groupBegin != m_particles.constEnd()) {
+        auto groupEnd = groupBegin;
+        while (groupEnd != m_particles.constEnd() &&
+               groupEnd->tileCol == groupBegin->tileCol &&
+               groupEnd->tileRow == groupBegin->tileRow) {
+            ++groupEnd;
+        }
+
+        if (groupEnd - groupBegin >= minParticlesForTileBuffer) {
+            const QRect tileRect(groupBegin->tileCol * batchTileSize,
+                                 groupBegin->tileRow * batchTileSize,
+                                 batchTileSize, batchTileSize);
+
+            m_tileBuffer.resize(batchTileSize * batchTileSize * m_pixelSize);
+            quint8 *buffer = m_tileBuffer.data();
+
+            dev->readBytes(buffer, tileRect);
+
+            for (auto it = groupBegin; it != groupEnd; ++it) {
+                const int offset =
+                    ((it->y - tileRect.y()) * batchTileSize + it->x - tileRect.x()) * m_pixelSize;
+                memcpy(buffer + offset, pixels + it->seqNo * m_pixelSize, m_pixelSize);
+            }
+
+            dev->writeBytes(buffer, tileRect);
+        } else {
+            if (!accessor) {
+                accessor = dev->createRandomAccessorNG();
+            }
+
+            for (auto it = groupBegin; it != groupEnd; ++it) {
+                accessor->moveTo(it->x, it->y);
+                memcpy(accessor->rawData(), pixels + it->seqNo * m_pixelSize, m_pixelSize);
+            }
+        }
+
+        groupBegin = groupEnd;
+    }
+
+    m_particles.clear();
+    m_pixels.clear();
+}
@@ -0,0 +1,63 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSPRAYPARTICLEBATCH_H
+#define KISSPRAYPARTICLEBATCH_H
+
+#include <QVector>
+
+#include "kis_types.h"
+
+/**
+ * Collects the pixel-sized particles of one spray dab (the "pixel" and
+ * "anti-aliased pixel" shapes) and writes them into the device in one go.
+ *
+ * The particles are binned by the tiles of the device. The tiles that
+ * receive many particles are read into a contiguous buffer once, all
+ * their particles are written into the buffer and the buffer is written
+ * back. The rest of the tiles are written with a random accessor, the way
+ * the particles used to be painted.
+ *
+ * The particles overwrite the pixels of the device, the order of the
+ * particles painted into the same pixel is preserved.
+ */
+class KisSprayParticleBatch
+{
+public:
+    KisSprayParticleBatch();
+
+    /**
+     * Resets the batch, \p pixelSize is the pixel size
+     * of the device the batch will be written to
+     */
+    void reset(int pixelSize);
+
+    void addPixel(int x, int y, const quint8 *pixel);
+
+    bool isEmpty() const;
+
+    /**
+     * Writes all the collected particles into \p dev and
+     * clears the batch
+     */
+    void flush(KisPaintDeviceSP dev);
+
+private:
+    struct Particle {
+        int x {0};
+        int y {0};
+        int tileCol {0};
+        int tileRow {0};
+        int seqNo {0};
+    };
+
+    int m_pixelSize {0};
+    QVector<Particle> m_particles;
+    QVector<quint8> m_pixels;
+    QVector<quint8> m_tileBuffer;
+};
+
+#endif // KISSPRAYPARTICLEBATCH_H
@@ -18,6 +18,7 @@
 #include "KisSprayOpOption.h"
 #include "KisSprayShapeDynamicsOptionData.h"
 #include "KisSprayShapeOptionData.h"
+#include "KisSprayParticleBatch.h"
 
 
 
@@ -74,6 +75,8 @@ private:
     KisBrushSP m_brush;
     KisFixedPaintDeviceSP m_fixedDab;
 
+    KisSprayParticleBatch m_particleBatch;
+
 private:
     template <typename AngularDistribution>
     void paintImpl(KisPaintDeviceSP dab,
@@ -99,7 +102,7 @@ private:
     /// rotation in radians according the settings (gauss distribution, uniform distribution or fixed angle)
     qreal rotationAngle(KisRandomSourceSP randomSource);
     /// Paints Wu Particle
-    void paintParticle(KisRandomAccessorSP &writeAccessor, const KoColor &color, qreal rx, qreal ry);
+    void paintParticle(KisSprayParticleBatch &batch, const KoColor &color, qreal rx, qreal ry);
     void paintCircle(KisPainter * painter, qreal x, qreal y, qreal radius);
     void paintEllipse(KisPainter * painter, qreal x, qreal y, qreal a, qreal b, qreal angle);
     void paintRectangle(KisPainter * painter, qreal x, qreal y, qreal width, qreal height, qreal angle);
@@ -132,6 +132,7 @@ void KisToolBrush::slotSetSmoothingType(int index)
         showControl(m_sliderDelayDistance, false);
         showControl(m_chkFinishStabilizedCurve, false);
         showControl(m_chkStabilizeSensors, false);
+        showControl(m_chkPredictStroke, false);
         break;
     case 1:
         smoothingOptions()->setSmoothingType(KisSmoothingOptions::SIMPLE_SMOOTHING);
@@ -142,6 +143,7 @@ void KisToolBrush::slotSetSmoothingType(int index)
         showControl(m_sliderDelayDistance, false);
         showControl(m_chkFinishStabilizedCurve, false);
         showControl(m_chkStabilizeSensors, false);
+        showControl(m_chkPredictStroke, false);
         break;
     case 2:
         smoothingOptions()->setSmoothingType(KisSmoothingOptions::WEIGHTED_SMOOTHING);
@@ -152,6 +154,7 @@ void KisToolBrush::slotSetSmoothingType(int index)
         showControl(m_sliderDelayDistance, false);
         showControl(m_chkFinishStabilizedCurve, false);
         showControl(m_chkStabilizeSensors, false);
+        showControl(m_chkPredictStroke, true);
         break;
     case 3:
     default:
@@ -162,6 +165,7 @@ void KisToolBrush::slotSetSmoothingType(int index)
         showControl(m_sliderDelayDistance, true);
         showControl(m_chkFinishStabilizedCurve, true);
         showControl(m_chkStabilizeSensors, true);
+        showControl(m_chkPredictStroke, true);
 
         // scalable distance option is disabled due to bug 421314
         showControl(m_chkUseScalableDistance, false);
@@ -304,6 +308,17 @@ bool KisToolBrush::stabilizeSensors() const
     return smoothingOptions()->stabilizeSensors();
 }
 
+void KisToolBrush::setPredictStroke(bool value)
+{
+    smoothingOptions()->setPredictStroke(value);
+    emit predictStrokeChanged();
+}
+
+bool KisToolBrush::predictStroke() const
+{
+    return smoothingOptions()->predictStroke();
+}
+
 void KisToolBrush::updateSettingsViews()
 {
     m_cmbSmoothingType->setCurrentIndex(smoothingOptions()->smoothingType());
@@ -316,6 +331,7 @@ void KisToolBrush::updateSettingsViews()
     m_chkUseScalableDistance->setChecked(smoothingOptions()->useScalableDistance());
     m_cmbSmoothingType->setCurrentIndex((int)smoothingOptions()->smoothingType());
     m_chkStabilizeSensors->setChecked(smoothingOptions()->stabilizeSensors());
+    m_chkPredictStroke->setChecked(smoothingOptions()->predictStroke());
 
     emit smoothnessQualityChanged();
     emit smoothnessFactorChanged();
@@ -326,6 +342,7 @@ void KisToolBrush::updateSettingsViews()
     emit delayDistanceChanged();
     emit finishStabilizedCurveChanged();
     emit stabilizeSensorsChanged();
+    emit predictStrokeChanged();
 
     KisTool::updateSettingsViews();
 }
@@ -406,6 +423,15 @@ QWidget * KisToolBrush::createOptionWidget()
     m_chkStabilizeSensors->setChecked(smoothingOptions()->stabilizeSensors());
     addOptionWidgetOption(m_chkStabilizeSensors, new QLabel(i18n("Stabilize Sensors:")));
 
+    // Predict stroke
+    m_chkPredictStroke = new QCheckBox(optionsWidget);
+    m_chkPredictStroke->setMinimumHeight(qMax(m_sliderSmoothnessDistance->sizeHint().height()-3,
+                                              m_chkPredictStroke->sizeHint().height()));
+    m_chkPredictStroke->setToolTip(i18n("Show the predicted path of the pen ahead of the smoothed stroke"));
+    connect(m_chkPredictStroke, SIGNAL(toggled(bool)), this, SLOT(setPredictStroke(bool)));
+    m_chkPredictStroke->setChecked(smoothingOptions()->predictStroke());
+    addOptionWidgetOption(m_chkPredictStroke, new QLabel(i18n("Predict Stroke:")));
+
 
     m_sliderTailAggressiveness = new KisDoubleSliderSpinBox(optionsWidget);
     m_sliderTailAggressiveness->setRange(0.0, 1.0, 2);
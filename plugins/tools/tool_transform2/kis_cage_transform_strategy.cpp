@@ -23,6 +23,12 @@ struct KisCageTransformStrategy::Private
     }
 
     KisCageTransformStrategy * const q;
+
+    /**
+     * The worker used for the last preview. Its Green coordinates
+     * are reused while the original cage stays the same.
+     */
+    QScopedPointer<KisCageTransformWorker> lastWorker;
 };
 
 
@@ -77,12 +83,21 @@ QImage KisCageTransformStrategy::calculateTransformedImage(ToolTransformArgs &cu
                                                            const QPointF &srcOffset,
                                                            QPointF *dstOffset)
 {
-    KisCageTransformWorker worker(srcImage,
-                                  srcOffset,
-                                  origPoints,
-                                  0,
-                                  currentArgs.previewPixelPrecision());
-    worker.prepareTransform();
-    worker.setTransformedCage(transfPoints);
-    return worker.runOnQImage(dstOffset);
+    QScopedPointer<KisCageTransformWorker> worker(
+        new KisCageTransformWorker(srcImage,
+                                   srcOffset,
+                                   origPoints,
+                                   0,
+                                   currentArgs.previewPixelPrecision()));
+
+    if (!m_d->lastWorker || !worker->reusePreparedTransform(*m_d->lastWorker)) {
+        worker->prepareTransform();
+    }
+
+    worker->setTransformedCage(transfPoints);
+    QImage result = worker->runOnQImage(dstOffset);
+
+    m_d->lastWorker.swap(worker);
+
+    return result;
 }
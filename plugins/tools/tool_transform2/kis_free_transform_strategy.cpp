@@ -305,9 +305,14 @@ void KisFreeTransformStrategy::paint(QPainter &gc)
 {
     gc.save();
 
+    QTransform levelToThumbTransform;
+    const QImage previewImage = originalImageLevel(m_d->paintingTransform, &levelToThumbTransform);
+
     gc.setOpacity(m_d->transaction.basePreviewOpacity());
     gc.setTransform(m_d->paintingTransform, true);
-    gc.drawImage(m_d->paintingOffset, originalImage());
+    gc.translate(m_d->paintingOffset);
+    gc.setTransform(levelToThumbTransform, true);
+    gc.drawImage(QPointF(), previewImage);
 
     gc.restore();
 
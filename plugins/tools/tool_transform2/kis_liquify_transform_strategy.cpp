@@ -66,6 +66,15 @@ struct KisLiquifyTransformStrategy::Private
 
     QImage transformedImage;
 
+    /**
+     * The original image scaled for the flake optimization. It is
+     * kept between the updates, so the liquify worker could see the
+     * same source image and update its preview incrementally.
+     */
+    QImage scaledOriginalImage;
+    qint64 scaledOriginalCacheKey = 0;
+    QTransform scaledOriginalTransform;
+
     // size-gesture-related
     QPointF lastMouseWidgetPos;
     QPointF startResizeImagePos;
@@ -272,7 +281,19 @@ void KisLiquifyTransformStrategy::Private::recalculateTransformations()
     paintingOffset = transaction.originalTopLeft();
     if (!q->originalImage().isNull()) {
         if (useFlakeOptimization) {
-            transformedImage = q->originalImage().transformed(resultThumbTransform);
+            if (scaledOriginalImage.isNull() ||
+                scaledOriginalCacheKey != q->originalImage().cacheKey() ||
+                scaledOriginalTransform != resultThumbTransform) {
+
+                QTransform levelToThumbTransform;
+                const QImage levelImage = q->originalImageLevel(resultThumbTransform, &levelToThumbTransform);
+
+                scaledOriginalImage = levelImage.transformed(levelToThumbTransform * resultThumbTransform);
+                scaledOriginalCacheKey = q->originalImage().cacheKey();
+                scaledOriginalTransform = resultThumbTransform;
+            }
+
+            transformedImage = scaledOriginalImage;
             paintingTransform = QTransform();
         } else {
             transformedImage = q->originalImage();
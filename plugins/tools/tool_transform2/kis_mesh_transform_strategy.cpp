@@ -831,7 +831,10 @@ void KisMeshTransformStrategy::Private::recalculateTransformations()
     if (!q->originalImage().isNull()) {
         const QPointF origTLInFlake = imageToThumb.map(transaction.originalTopLeft());
         if (useFlakeOptimization) {
-            transformedImage = q->originalImage().transformed(resultThumbTransform);
+            QTransform levelToThumbTransform;
+            const QImage levelImage = q->originalImageLevel(resultThumbTransform, &levelToThumbTransform);
+
+            transformedImage = levelImage.transformed(levelToThumbTransform * resultThumbTransform);
             paintingTransform = QTransform();
         } else {
             transformedImage = q->originalImage();
@@ -9,15 +9,45 @@
 #include <QImage>
 #include <QPainterPath>
 #include <QTransform>
+#include <QtMath>
 #include "KoPointerEvent.h"
+#include "kis_algebra_2d.h"
+#include "kis_transform_utils.h"
 
 
 struct KisTransformStrategyBase::Private
 {
     QTransform thumbToImageTransform;
     QImage originalImage;
+
+    /**
+     * The mipmap pyramid of the original image, every next level
+     * is two times smaller than the previous one. The first level
+     * is the original image itself.
+     */
+    mutable QVector<QImage> originalImageLevels;
+
+    void buildLevels() const;
 };
 
+void KisTransformStrategyBase::Private::buildLevels() const
+{
+    // the levels smaller than that are never useful for the preview
+    const int minLevelSize = 32;
+
+    originalImageLevels.clear();
+    originalImageLevels << originalImage;
+
+    while (KisAlgebra2D::minDimension(originalImageLevels.last().rect()) >= 2 * minLevelSize) {
+        const QImage &prevLevel = originalImageLevels.last();
+        const QSize levelSize((prevLevel.width() + 1) / 2, (prevLevel.height() + 1) / 2);
+
+        originalImageLevels << prevLevel.scaled(levelSize,
+                                                Qt::IgnoreAspectRatio,
+                                                Qt::SmoothTransformation);
+    }
+}
+
 
 KisTransformStrategyBase::KisTransformStrategyBase()
     : m_d(new Private())
@@ -51,10 +81,50 @@ QTransform KisTransformStrategyBase::thumbToImageTransform() const
     return m_d->thumbToImageTransform;
 }
 
+QImage KisTransformStrategyBase::originalImageLevel(const QTransform &thumbToViewTransform,
+                                                   QTransform *levelToThumbTransform) const
+{
+    *levelToThumbTransform = QTransform();
+
+    if (m_d->originalImage.isNull()) return m_d->originalImage;
+
+    /**
+     * The transform may have perspective, so use the biggest
+     * scale of the corners of the image to never make the preview
+     * blurry
+     */
+    const QRectF rc = m_d->originalImage.rect();
+    qreal scale = 0.0;
+
+    Q_FOREACH (const QPointF &pt, QVector<QPointF>({rc.topLeft(), rc.topRight(),
+                                                    rc.bottomRight(), rc.bottomLeft()})) {
+        scale = qMax(scale, KisTransformUtils::scaleFromPerspectiveMatrixX(thumbToViewTransform, pt));
+        scale = qMax(scale, KisTransformUtils::scaleFromPerspectiveMatrixY(thumbToViewTransform, pt));
+    }
+
+    if (scale >= 0.5 || !qIsFinite(scale)) return m_d->originalImage;
+
+    if (m_d->originalImageLevels.isEmpty() ||
+        m_d->originalImageLevels.first().cacheKey() != m_d->originalImage.cacheKey()) {
+
+        m_d->buildLevels();
+    }
+
+    const int level = qBound(0, qFloor(std::log2(1.0 / scale)), m_d->originalImageLevels.size() - 1);
+    const QImage &levelImage = m_d->originalImageLevels[level];
+
+    *levelToThumbTransform =
+        QTransform::fromScale(qreal(m_d->originalImage.width()) / levelImage.width(),
+                              qreal(m_d->originalImage.height()) / levelImage.height());
+
+    return levelImage;
+}
+
 void KisTransformStrategyBase::setThumbnailImage(const QImage &image, QTransform thumbToImageTransform)
 {
     m_d->originalImage = image;
     m_d->thumbToImageTransform = thumbToImageTransform;
+    m_d->originalImageLevels.clear();
 }
 
 bool KisTransformStrategyBase::acceptsClicks() const
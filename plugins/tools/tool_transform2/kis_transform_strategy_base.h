@@ -30,6 +30,18 @@ public:
     QImage originalImage() const;
     QTransform thumbToImageTransform() const;
 
+    /**
+     * Returns the level of the mipmap pyramid of originalImage() that
+     * is suitable for painting the image with \p thumbToViewTransform,
+     * that is, the smallest level that is still not upscaled by the
+     * transform. The pyramid is built on the first request.
+     *
+     * \p levelToThumbTransform is set to the transform mapping the
+     * pixels of the level into the coordinate system of originalImage().
+     */
+    QImage originalImageLevel(const QTransform &thumbToViewTransform,
+                              QTransform *levelToThumbTransform) const;
+
     void setThumbnailImage(const QImage &image, QTransform thumbToImageTransform);
 
 public:
@@ -591,7 +591,10 @@ void KisWarpTransformStrategy::Private::recalculateTransformations()
         QPointF origTLInFlake = imageToThumb(transaction.originalTopLeft(), useFlakeOptimization);
 
         if (useFlakeOptimization) {
-            transformedImage = q->originalImage().transformed(resultThumbTransform);
+            QTransform levelToThumbTransform;
+            const QImage levelImage = q->originalImageLevel(resultThumbTransform, &levelToThumbTransform);
+
+            transformedImage = levelImage.transformed(levelToThumbTransform * resultThumbTransform);
             paintingTransform = QTransform();
         } else {
             transformedImage = q->originalImage();